@@ -309,6 +309,7 @@ class Container:
         # Emit fields
         if self.fields is not None:
             for field in self.fields:
+                field.emit_foreach(auxfile, cfile)
                 field.emit_getter(auxfile, cfile)
                 if self.readonly == False:
                     field.emit_setter(auxfile, cfile)
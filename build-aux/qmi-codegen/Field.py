@@ -64,6 +64,14 @@ class Field:
         # Create the variable name within the Container
         self.variable_name = 'arg_' + utils.build_underscore_name(self.name).lower()
 
+        # Output arrays may also be iterated element by element
+        self.foreach_since = dictionary['foreach-since'] if 'foreach-since' in dictionary else None
+        if self.foreach_since is not None:
+            if self.container_type != 'Output' or self.variable.format != 'array':
+                raise ValueError('TLV ' + self.fullname + ' has a "foreach-since" tag but is not an output array')
+            if self.variable.array_sequence_element != '':
+                raise ValueError('TLV ' + self.fullname + ' has a "foreach-since" tag but iterating arrays with sequence is unsupported')
+
         # Create the ID enumeration name
         self.id_enum_name = utils.build_underscore_name(self.prefix + ' TLV ' + self.name).upper()
 
@@ -170,6 +178,99 @@ class Field:
         cfile.write(string.Template(template).substitute(translations))
 
 
+    """
+    Builds the name of the callback type used when iterating the array elements
+    """
+    def foreach_fn_name(self):
+        return utils.build_camelcase_name(self.prefix) + utils.build_camelcase_name(self.name) + 'ForeachFn'
+
+
+    """
+    Emit the method responsible for iterating the elements of this array TLV
+    in the output container
+    """
+    def emit_foreach(self, hfile, cfile):
+        if self.foreach_since is None:
+            return
+
+        element_format = self.variable.array_element.public_format
+        translations = { 'name'               : self.name,
+                         'variable_name'      : self.variable_name,
+                         'underscore'         : utils.build_underscore_name(self.name),
+                         'prefix_camelcase'   : utils.build_camelcase_name(self.prefix),
+                         'prefix_underscore'  : utils.build_underscore_name(self.prefix),
+                         'foreach_fn'         : self.foreach_fn_name(),
+                         'element_format'     : element_format,
+                         'element_arg_format' : (element_format if element_format.endswith('*') else 'const ' + element_format) + ' *',
+                         'since'              : self.foreach_since,
+                         'static'             : 'static ' if self.static else '' }
+
+        # Emit the callback type and the foreach method header
+        template = (
+            '\n'
+            '/**\n'
+            ' * ${foreach_fn}:\n'
+            ' * @element: a #${element_format} element, only valid during the callback.\n'
+            ' * @user_data: user data.\n'
+            ' *\n'
+            ' * Callback type to use when iterating the \'${name}\' field with\n'
+            ' * ${prefix_underscore}_foreach_${underscore}().\n'
+            ' *\n'
+            ' * Since: ${since}\n'
+            ' */\n'
+            'typedef void (* ${foreach_fn}) (${element_arg_format}element, gpointer user_data);\n'
+            '\n'
+            '/**\n'
+            ' * ${prefix_underscore}_foreach_${underscore}:\n'
+            ' * @self: a #${prefix_camelcase}.\n'
+            ' * @func: the function to call for each element.\n'
+            ' * @user_data: user data to pass to the function.\n'
+            ' * @error: Return location for error or %NULL.\n'
+            ' *\n'
+            ' * Calls the given function for each element in the \'${name}\' field of @self.\n'
+            ' *\n'
+            ' * Returns: %TRUE if all elements were processed, %FALSE otherwise.\n'
+            ' *\n'
+            ' * Since: ${since}\n'
+            ' */\n'
+            '${static}gboolean ${prefix_underscore}_foreach_${underscore} (\n'
+            '    ${prefix_camelcase} *self,\n'
+            '    ${foreach_fn} func,\n'
+            '    gpointer user_data,\n'
+            '    GError **error);\n')
+        hfile.write(string.Template(template).substitute(translations))
+
+        # Emit the foreach source
+        template = (
+            '\n'
+            '${static}gboolean\n'
+            '${prefix_underscore}_foreach_${underscore} (\n'
+            '    ${prefix_camelcase} *self,\n'
+            '    ${foreach_fn} func,\n'
+            '    gpointer user_data,\n'
+            '    GError **error)\n'
+            '{\n'
+            '    guint i;\n'
+            '\n'
+            '    g_return_val_if_fail (self != NULL, FALSE);\n'
+            '    g_return_val_if_fail (func != NULL, FALSE);\n'
+            '\n'
+            '    if (!self->${variable_name}_set) {\n'
+            '        g_set_error (error,\n'
+            '                     QMI_CORE_ERROR,\n'
+            '                     QMI_CORE_ERROR_TLV_NOT_FOUND,\n'
+            '                     "Field \'${name}\' was not found in the message");\n'
+            '        return FALSE;\n'
+            '    }\n'
+            '\n'
+            '    for (i = 0; i < self->${variable_name}->len; i++)\n'
+            '        func (&g_array_index (self->${variable_name}, ${element_format}, i), user_data);\n'
+            '\n'
+            '    return TRUE;\n'
+            '}\n')
+        cfile.write(string.Template(template).substitute(translations))
+
+
     """
     Emit the method responsible for setting this TLV in the input/output
     container
@@ -387,6 +488,143 @@ class Field:
         f.write(string.Template(template).substitute(translations))
 
 
+    """
+    Build the raw sample TLV, including the TLV header
+    """
+    def build_sample_tlv(self):
+        value = self.variable.build_sample_bytes()
+        return utils.build_le_bytes(int(self.id, 0), 1) + utils.build_le_bytes(len(value), 2) + value
+
+
+    """
+    Emit the helper methods required by the samples, as those are not exposed
+    in the interface
+    """
+    def emit_sample_types(self, f):
+        if TypeFactory.is_type_emitted(self.fullname) is False:
+            TypeFactory.set_type_emitted(self.fullname)
+            self.variable.emit_helper_methods(f, f)
+
+
+    """
+    Name of the method writing the sample TLV of this input field
+    """
+    def sample_write_name(self):
+        # Common fields share the full name, so always use the container one
+        return utils.build_underscore_name(self.prefix + ' ' + self.name) + '_sample_write'
+
+
+    """
+    Emit the method writing a sample value of this input field as a TLV in the
+    message 'self', using the same buffer writers as the request creator
+    """
+    def emit_sample_write(self, f):
+        translations = { 'name'              : self.name,
+                         'tlv_id'            : self.id,
+                         'sample_write_name' : self.sample_write_name(),
+                         'variable_name'     : 'values.' + self.variable_name }
+
+        # Sample values are given in public variables, as they would be given
+        # to the setters
+        template = (
+            '\n'
+            'static gboolean\n'
+            '${sample_write_name} (\n'
+            '    QmiMessage *self,\n'
+            '    GError **error)\n'
+            '{\n'
+            '    struct {\n')
+        template += self.variable.build_variable_declaration(True, '        ', self.variable_name)
+        template += (
+            '    } values;\n'
+            '    gsize tlv_offset;\n'
+            '\n'
+            '    memset (&values, 0, sizeof (values));\n')
+        template += self.variable.build_sample_value('    ', '${variable_name}')
+        template += (
+            '\n'
+            '    if (!(tlv_offset = qmi_message_tlv_write_init (self, (guint8)${tlv_id}, error)))\n'
+            '        goto error_out;\n'
+            '\n')
+        f.write(string.Template(template).substitute(translations))
+
+        self.variable.emit_buffer_write(f, '    ', self.name, translations['variable_name'])
+
+        template = (
+            '\n'
+            '    if (!qmi_message_tlv_write_complete (self, tlv_offset, error))\n'
+            '        goto error_out;\n'
+            '\n')
+        template += self.variable.build_sample_cleanup('    ', '${variable_name}')
+        template += (
+            '    return TRUE;\n'
+            '\n'
+            'error_out:\n')
+        template += self.variable.build_sample_cleanup('    ', '${variable_name}')
+        template += (
+            '    return FALSE;\n'
+            '}\n')
+        f.write(string.Template(template).substitute(translations))
+
+
+    """
+    Emit the code reading this output field from the TLV in 'message', using
+    the same buffer readers as the response or indication parser. The value is
+    read into a local variable and disposed right away.
+    """
+    def emit_sample_read(self, f, line_prefix):
+        tlv_out = utils.build_underscore_name (self.fullname) + '_out'
+        error = 'error' if self.mandatory else 'NULL'
+        translations = { 'name'          : self.name,
+                         'tlv_out'       : tlv_out,
+                         'tlv_id'        : self.id,
+                         'variable_name' : 'values.' + self.variable_name,
+                         'lp'            : line_prefix,
+                         'error'         : error }
+
+        template = (
+            '\n'
+            '${lp}/* ${name} */\n'
+            '${lp}{\n'
+            '${lp}    struct {\n')
+        template += self.variable.build_variable_declaration(False, line_prefix + '        ', self.variable_name)
+        template += (
+            '${lp}    } values;\n'
+            '${lp}    gsize offset = 0;\n'
+            '${lp}    gsize init_offset;\n')
+        if self.mandatory:
+            template += (
+                '${lp}    gboolean read = FALSE;\n')
+        template += (
+            '\n'
+            '${lp}    memset (&values, 0, sizeof (values));\n'
+            '${lp}    if ((init_offset = qmi_message_tlv_read_init (message, ${tlv_id}, NULL, ${error})) == 0)\n'
+            '${lp}        goto ${tlv_out};\n')
+        f.write(string.Template(template).substitute(translations))
+
+        self.variable.emit_buffer_read(f, line_prefix + '    ', tlv_out, error, translations['variable_name'])
+
+        template = ''
+        if self.mandatory:
+            template += (
+                '${lp}    read = TRUE;\n')
+        template += (
+            '\n'
+            '${tlv_out}:\n')
+        dispose = self.variable.build_dispose(line_prefix + '    ', '${variable_name}')
+        template += dispose
+        if self.mandatory:
+            template += (
+                '${lp}    if (!read)\n'
+                '${lp}        return FALSE;\n')
+        elif dispose == '':
+            template += (
+                '${lp}    ;\n')
+        template += (
+            '${lp}}\n')
+        f.write(string.Template(template).substitute(translations))
+
+
     """
     Add sections
     """
@@ -405,4 +643,8 @@ class Field:
         if self.container_type == 'Input':
             template += (
                 '${prefix_underscore}_set_${underscore}\n')
+        if self.foreach_since is not None:
+            template += (
+                '${prefix_underscore}_foreach_${underscore}\n')
+            sections['public-types'] += self.foreach_fn_name() + '\n'
         sections['public-methods'] += string.Template(template).substitute(translations)
@@ -40,6 +40,14 @@ class FieldResult(Field):
             self.variable.emit_types(cfile, self.since)
 
 
+    """
+    The samples are built out of the library, so they need their own copy of
+    the types not exposed in the interface
+    """
+    def emit_sample_types(self, f):
+        self.emit_types(None, f)
+
+
     """
     Emit the method responsible for getting the Result TLV contents. This
     special TLV will have its own getter implementation, as we want to have
@@ -415,6 +415,150 @@ class Message:
         self.__emit_helpers(hfile, cfile)
         self.__emit_response_or_indication_parser(hfile, cfile)
 
+    """
+    Build the raw sample response or indication, with every output TLV given
+    """
+    def build_sample_raw(self):
+        tlvs = bytearray()
+        if self.output.fields is not None:
+            tlv_ids = []
+            for field in self.output.fields:
+                # Only the first TLV with a given ID is ever read
+                if int(field.id, 0) in tlv_ids:
+                    continue
+                tlv_ids.append(int(field.id, 0))
+                tlvs += field.build_sample_tlv()
+
+        if self.service == 'CTL':
+            header = [ 0x01 if self.type == 'Message' else 0x02 ]
+            header += list(utils.build_le_bytes(1 if self.type == 'Message' else 0, 1))
+        else:
+            header = [ 0x02 if self.type == 'Message' else 0x04 ]
+            header += list(utils.build_le_bytes(1 if self.type == 'Message' else 0, 2))
+        header += list(utils.build_le_bytes(int(self.id, 0), 2))
+        header += list(utils.build_le_bytes(len(tlvs), 2))
+
+        qmux_length = 5 + len(header) + len(tlvs)
+        raw = [ '0x01' ]
+        raw += [ '0x%02x' % byte for byte in utils.build_le_bytes(qmux_length, 2) ]
+        raw += [ '0x80', 'QMI_SERVICE_' + self.service, '0x01' ]
+        raw += [ '0x%02x' % byte for byte in header + list(tlvs) ]
+        return raw
+
+
+    """
+    Emit the sample request builder, the sample raw response or indication and
+    its reader. Only the public QMI message API is used, so that the samples
+    can be built along with the benchmarks against the shared library.
+    """
+    def emit_samples(self, f):
+        translations = { 'underscore' : utils.build_underscore_name (self.fullname),
+                         'service'    : self.service,
+                         'id'         : self.id }
+
+        if self.type == 'Message':
+            if self.input is not None and self.input.fields is not None:
+                for field in self.input.fields:
+                    if field.variable is not None:
+                        field.emit_sample_write(f)
+
+            template = (
+                '\n'
+                'static QmiMessage *\n'
+                '${underscore}_request_sample_new (\n'
+                '    guint16 transaction_id,\n'
+                '    GError **error)\n'
+                '{\n'
+                '    QmiMessage *self;\n'
+                '\n'
+                '    self = qmi_message_new (QMI_SERVICE_${service}, 1, transaction_id, ${id});\n')
+            if self.input is not None and self.input.fields is not None:
+                for field in self.input.fields:
+                    if field.variable is not None:
+                        translations['sample_write_name'] = field.sample_write_name()
+                        template += (
+                            '    if (!${sample_write_name} (self, error)) {\n'
+                            '        qmi_message_unref (self);\n'
+                            '        return NULL;\n'
+                            '    }\n')
+            template += (
+                '\n'
+                '    return self;\n'
+                '}\n')
+            f.write(string.Template(template).substitute(translations))
+
+        raw = self.build_sample_raw()
+        template = (
+            '\n'
+            'static const guint8 ${underscore}_output_sample[] = {\n')
+        for i in range(0, len(raw), 8):
+            template += '    ' + ', '.join(raw[i:i + 8]) + ',\n'
+        template += (
+            '};\n')
+        f.write(string.Template(template).substitute(translations))
+
+        if self.output.fields is None:
+            return
+
+        for field in self.output.fields:
+            field.emit_sample_types(f)
+
+        template = (
+            '\n'
+            'static gboolean\n'
+            '${underscore}_output_sample_read (\n'
+            '    QmiMessage *message,\n'
+            '    GError **error)\n'
+            '{\n')
+        f.write(string.Template(template).substitute(translations))
+
+        # Only the first TLV with a given ID is ever read, as in the sample
+        tlv_ids = []
+        for field in self.output.fields:
+            if field.variable is None or int(field.id, 0) in tlv_ids:
+                continue
+            tlv_ids.append(int(field.id, 0))
+            field.emit_sample_read(f, '    ')
+
+        f.write(
+            '\n'
+            '    return TRUE;\n'
+            '}\n')
+
+
+    """
+    Build the entry of the message in the samples table
+    """
+    def build_sample_entry(self):
+        translations = { 'underscore' : utils.build_underscore_name (self.fullname),
+                         'hyphened'   : utils.build_dashed_name (self.name),
+                         'service'    : self.service,
+                         'id'         : self.id,
+                         'vendor'     : self.vendor if self.vendor is not None else 'QMI_MESSAGE_VENDOR_GENERIC',
+                         'indication' : 'TRUE' if self.type == 'Indication' else 'FALSE' }
+
+        if self.type == 'Message':
+            translations['request_new'] = string.Template('${underscore}_request_sample_new').substitute(translations)
+        else:
+            translations['request_new'] = 'NULL'
+
+        if self.output.fields is not None:
+            translations['output_read'] = string.Template('${underscore}_output_sample_read').substitute(translations)
+        else:
+            translations['output_read'] = 'NULL'
+
+        template = (
+            '    {\n'
+            '        "${hyphened}",\n'
+            '        QMI_SERVICE_${service}, ${id}, ${vendor}, ${indication},\n'
+            '        ${request_new},\n'
+            '        ${underscore}_output_sample,\n'
+            '        sizeof (${underscore}_output_sample),\n'
+            '        ${output_read}\n'
+            '    },\n')
+        return string.Template(template).substitute(translations)
+
+
     """
     Emit the sections
     """
@@ -349,6 +349,28 @@ class MessageList:
         cfile.write(string.Template(template).substitute(translations))
 
 
+    """
+    Emit the samples of all messages in the service, used by the benchmarks.
+    Messages only used internally by the library are not included.
+    """
+    def emit_samples(self, f):
+        for message in self.list:
+            if not message.static:
+                message.emit_samples(f)
+
+        translations = { 'service' : self.service.lower() }
+        template = (
+            '\n'
+            'const TestMessageSample test_message_samples_${service}[] = {\n')
+        for message in self.list:
+            if not message.static:
+                template += message.build_sample_entry()
+        template += (
+            '    { NULL }\n'
+            '};\n')
+        f.write(string.Template(template).substitute(translations))
+
+
     """
     Emit the message list handling implementation
     """
@@ -155,6 +155,25 @@ class Variable:
     def build_dispose(self, line_prefix, variable_name):
         return ''
 
+    """
+    Builds the raw bytes of a sample value of this kind of variable, as used
+    when synthesizing messages for the benchmarks.
+    """
+    def build_sample_bytes(self):
+        return bytearray()
+
+    """
+    Builds the code to store a sample value in the given public variable.
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        return ''
+
+    """
+    Builds the code to release the sample value once written.
+    """
+    def build_sample_cleanup(self, line_prefix, variable_name):
+        return ''
+
     """
     Add sections
     """
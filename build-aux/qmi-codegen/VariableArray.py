@@ -511,3 +511,70 @@ class VariableArray(Variable):
     """
     def add_sections(self, sections):
         self.array_element.add_sections(sections)
+
+
+    """
+    Number of elements in sample arrays
+    """
+    def sample_n_items(self):
+        return int(self.fixed_size) if self.fixed_size else 2
+
+
+    """
+    The sample array is the number of items, the sequence and then the sample of
+    each of the elements one by one.
+    """
+    def build_sample_bytes(self):
+        n_items = self.sample_n_items()
+        built = bytearray()
+        if not self.fixed_size:
+            built += utils.build_le_bytes(n_items, len(self.array_size_element.build_sample_bytes()))
+        if self.array_sequence_element != '':
+            built += self.array_sequence_element.build_sample_bytes()
+        for i in range(n_items):
+            built += self.array_element.build_sample_bytes()
+        return built
+
+
+    """
+    Sample value for the array, built element by element
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        common_var_prefix = utils.build_underscore_name(self.name)
+        translations = { 'lp'                          : line_prefix,
+                         'variable_name'               : variable_name,
+                         'public_array_element_format' : self.array_element.public_format,
+                         'n_items'                     : self.sample_n_items(),
+                         'common_var_prefix'           : common_var_prefix }
+
+        template = (
+            '${lp}${variable_name} = g_array_sized_new (FALSE, FALSE, sizeof (${public_array_element_format}), ${n_items});\n'
+            '${lp}{\n'
+            '${lp}    guint ${common_var_prefix}_i;\n'
+            '\n'
+            '${lp}    for (${common_var_prefix}_i = 0; ${common_var_prefix}_i < ${n_items}; ${common_var_prefix}_i++) {\n'
+            '${lp}        ${public_array_element_format} ${common_var_prefix}_aux;\n'
+            '\n'
+            '${lp}        memset (&${common_var_prefix}_aux, 0, sizeof (${common_var_prefix}_aux));\n')
+        built = string.Template(template).substitute(translations)
+
+        built += self.array_element.build_sample_value(line_prefix + '        ', common_var_prefix + '_aux')
+
+        template = (
+            '${lp}        g_array_append_val (${variable_name}, ${common_var_prefix}_aux);\n'
+            '${lp}    }\n'
+            '${lp}}\n')
+        built += string.Template(template).substitute(translations)
+        return built
+
+
+    """
+    The sample array is owned by the sample variable, so it is just unref-ed
+    """
+    def build_sample_cleanup(self, line_prefix, variable_name):
+        translations = { 'lp'   : line_prefix,
+                         'name' : variable_name }
+
+        template = (
+            '${lp}g_array_unref (${name});\n')
+        return string.Template(template).substitute(translations)
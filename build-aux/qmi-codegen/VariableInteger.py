@@ -387,3 +387,31 @@ class VariableInteger(Variable):
         template = (
             '${lp}@${name}: a #${public_format}.\n')
         return string.Template(template).substitute(translations)
+
+
+    """
+    Sample integers are always zero, so that the endianness doesn't matter and
+    the result TLV reports success
+    """
+    def build_sample_bytes(self):
+        if self.format == 'guint-sized':
+            return bytearray(int(self.guint_sized_size))
+        if self.private_format == 'gfloat':
+            return bytearray(4)
+        if self.private_format == 'gdouble':
+            return bytearray(8)
+        return bytearray(VariableInteger.fixed_type_byte_size(self.private_format))
+
+
+    """
+    Sample value for the integer
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        translations = { 'lp'            : line_prefix,
+                         'public_format' : self.public_format,
+                         'name'          : variable_name }
+
+        template = (
+            '${lp}${name} = (${public_format}) 0;\n')
+        return string.Template(template).substitute(translations)
+
@@ -230,3 +230,34 @@ class VariableSequence(Variable):
         # Add sections for each member
         for member in self.members:
             member['object'].add_sections(sections)
+
+
+    """
+    The sample sequence is just the sample of each of the sequence fields one by
+    one.
+    """
+    def build_sample_bytes(self):
+        built = bytearray()
+        for member in self.members:
+            built += member['object'].build_sample_bytes()
+        return built
+
+
+    """
+    Sample value for each of the sequence fields
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        built = ''
+        for member in self.members:
+            built += member['object'].build_sample_value(line_prefix, variable_name + '_' + member['name'])
+        return built
+
+
+    """
+    Release the sample value of each of the sequence fields
+    """
+    def build_sample_cleanup(self, line_prefix, variable_name):
+        built = ''
+        for member in self.members:
+            built += member['object'].build_sample_cleanup(line_prefix, variable_name + '_' + member['name'])
+        return built
@@ -367,3 +367,38 @@ class VariableString(Variable):
         # Fixed-sized strings will need dispose if they are in the public header
         if self.is_fixed_size:
             self.needs_dispose = True
+
+
+    """
+    Sample string contents, honouring the fixed or maximum size
+    """
+    def sample_string(self):
+        if self.is_fixed_size:
+            return 'a' * int(self.fixed_size)
+        if self.max_size != '':
+            return 'abc'[:int(self.max_size)]
+        return 'abc'
+
+
+    """
+    Sample string as read from the raw byte buffer
+    """
+    def build_sample_bytes(self):
+        sample = bytearray(self.sample_string().encode('ascii'))
+        if self.is_fixed_size or self.n_size_prefix_bytes == 0:
+            return sample
+        return utils.build_le_bytes(len(sample), self.n_size_prefix_bytes) + sample
+
+
+    """
+    Sample value for the string, only valid for public variables
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        translations = { 'lp'     : line_prefix,
+                         'sample' : self.sample_string(),
+                         'name'   : variable_name }
+
+        template = (
+            '${lp}${name} = (gchar *) "${sample}";\n')
+        return string.Template(template).substitute(translations)
+
@@ -295,3 +295,33 @@ class VariableStruct(Variable):
             member['object'].add_sections(sections)
 
         sections['public-types'] += self.public_format + '\n'
+
+
+    """
+    The sample struct is just the sample of each of the struct fields one by one.
+    """
+    def build_sample_bytes(self):
+        built = bytearray()
+        for member in self.members:
+            built += member['object'].build_sample_bytes()
+        return built
+
+
+    """
+    Sample value for each of the struct fields
+    """
+    def build_sample_value(self, line_prefix, variable_name):
+        built = ''
+        for member in self.members:
+            built += member['object'].build_sample_value(line_prefix, variable_name + '.' + member['name'])
+        return built
+
+
+    """
+    Release the sample value of each of the struct fields
+    """
+    def build_sample_cleanup(self, line_prefix, variable_name):
+        built = ''
+        for member in self.members:
+            built += member['object'].build_sample_cleanup(line_prefix, variable_name + '.' + member['name'])
+        return built
@@ -127,6 +127,30 @@ def add_source_start(f, output_name):
     f.write(template.substitute(name = output_name))
 
 
+"""
+Build the little endian representation of an unsigned integer in the given
+number of bytes
+"""
+def build_le_bytes(value, n_bytes):
+    return bytearray([ (value >> (8 * i)) & 0xFF for i in range(n_bytes) ])
+
+
+"""
+Write the common samples source file start chunk. The service header is
+included explicitly as the CTL one (along with its private enums) is not
+part of the public library header.
+"""
+def add_samples_start(f, service):
+    template = string.Template (
+        "\n"
+        "#include <string.h>\n"
+        "\n"
+        "#include \"qmi-${service}.h\"\n"
+        "#include \"qmi-enums-private.h\"\n"
+        "#include \"test-message-samples.h\"\n")
+    f.write(template.substitute(service = service.lower()))
+
+
 """
 Write a separator comment in the file
 """
@@ -87,6 +87,10 @@ DWORD SetUnsignedVal(
    // Number of bits in the passed in type
    const ULONG TYPE_BIT_COUNT = (ULONG)(sizeof( T ) * BITS_PER_BYTE);
    ASSERT( numBits > 0 && numBits <= TYPE_BIT_COUNT);
+   if (numBits > MAX_TYPE_BITS)
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
 
    // Requesting too much?
    if (currentOffset < maxOffset)
@@ -107,64 +111,59 @@ DWORD SetUnsignedVal(
       return ERROR_NOT_ENOUGH_MEMORY;
    }
 
-   // Advance to first valid byte
-   pData += (currentOffset / BITS_PER_BYTE);
-
-   // Since we don't really care about performance for bit packing
-   // (we do not anticipate this being called as frequently as bit
-   // parsing) we always use the generic approach
-
-   // Reduce input to a bit array
-   BYTE bits[MAX_TYPE_BITS];
-
-   ULONG bitsExtracted = 0;   
-   while (bitsExtracted < numBits)
+   if (numBits == 0)
    {
-      if (bLSB == true)
-      {
-         BYTE bit = (BYTE)(dataIn & (T)1);
-         bits[bitsExtracted++] = bit;
-      }
-      else
-      {
-         BYTE bit = (BYTE)(dataIn & (T)1);
-         bits[numBits - ++bitsExtracted] = bit;
-      }
-
-      dataIn >>= 1;
+      return NO_ERROR;
    }
 
+   // Advance to first valid byte
+   ULONG byteOffset = currentOffset / BITS_PER_BYTE;
+   pData += byteOffset;
+
+   // Bit offset into the current byte, and the number of bytes that can
+   // be written from here without overrunning the buffer
+   ULONG bitOffset = currentOffset % BITS_PER_BYTE;
+   ULONG bytesLeft = (maxOffset + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+   bytesLeft -= byteOffset;
+
+   // Reduce input to the bits being written
+   ULONGLONG val = (ULONGLONG)dataIn;
+   if (numBits < MAX_TYPE_BITS)
+   {
+      val &= ((ULONGLONG)1 << numBits) - 1;
+   }
 
-   // Store current offset
-   ULONG offset = currentOffset;
+   // Position the value within a 64-bit window starting at the current
+   // byte, any bits that do not fit go into a ninth byte
+   ULONGLONG bits = 0;
+   BYTE overflow = 0;
+   bool bStraddles = (bitOffset + numBits > MAX_TYPE_BITS);
 
-   // Add in each bit - one at a time
-   bitsExtracted = 0;
-   while (bitsExtracted != numBits)
+   if (bLSB == true)
    {
-      // How many bits are left in the current byte?
-      ULONG bitsLeft = BITS_PER_BYTE - (offset % BITS_PER_BYTE);
-      
-      // Shift input bit over to desired destination
-      BYTE tmp = bits[bitsExtracted++];
-
-      if (bLSB == true)
+      bits = val << bitOffset;
+      if (bStraddles == true)
       {
-         tmp <<= (BITS_PER_BYTE - bitsLeft);
+         overflow = (BYTE)(val >> (MAX_TYPE_BITS - bitOffset));
       }
-      else
+   }
+   else
+   {
+      bits = (val << (MAX_TYPE_BITS - numBits)) >> bitOffset;
+      if (bStraddles == true)
       {
-         tmp <<= bitsLeft - 1;
+         ULONG overflowBits = bitOffset + numBits - MAX_TYPE_BITS;
+         overflow = (BYTE)(val << (BITS_PER_BYTE - overflowBits));
       }
+   }
 
-      *pData |= tmp;
+   // Add the bits in (existing bits in the buffer are preserved)
+   ULONGLONG window = LoadBitWindow( pData, bytesLeft, bLSB );
+   StoreBitWindow( pData, bytesLeft, window | bits, bLSB );
 
-      // Advance to next byte in buffer?
-      offset++;
-      if (offset % BITS_PER_BYTE == 0)
-      {
-         pData++;
-      }
+   if (bStraddles == true)
+   {
+      pData[sizeof( window )] |= overflow;
    }
 
    currentOffset += numBits;
@@ -48,19 +48,6 @@ POSSIBILITY OF SUCH DAMAGE.
 // Definitions
 //---------------------------------------------------------------------------
 
-static BYTE MASK[BITS_PER_BYTE + 1] =
-{
-   0x00,
-   0x01,
-   0x03,
-   0x07,
-   0x0F,
-   0x1F,
-   0x3F,
-   0x7F,
-   0xFF
-};
-
 /*=========================================================================*/
 // Free Methods
 /*=========================================================================*/
@@ -120,81 +107,51 @@ DWORD GetUnsignedVal(
    }
   
    // Advance to first valid bit
-   pData += (currentOffset / BITS_PER_BYTE);
+   ULONG byteOffset = currentOffset / BITS_PER_BYTE;
+   pData += byteOffset;
 
-   // Number of bits left in current byte
-   ULONG bitsLeft = BITS_PER_BYTE - (currentOffset % BITS_PER_BYTE);
+   // Bit offset into the current byte, and the number of bytes that can
+   // be read from here without overrunning the buffer
+   ULONG bitOffset = currentOffset % BITS_PER_BYTE;
+   ULONG bytesLeft = (maxOffset + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+   bytesLeft -= byteOffset;
 
+   // Load a 64-bit window starting at the current byte, this holds the
+   // entire value unless it straddles a ninth byte
+   ULONGLONG window = LoadBitWindow( pData, bytesLeft, bLSB );
+   bool bStraddles = (bitOffset + numBits > MAX_TYPE_BITS);
+
+   ULONGLONG val = 0;
    if (bLSB == true)
    {
-      // Extracting native types on byte boundaries?
-      if (numBits == TYPE_BIT_COUNT && bitsLeft == BITS_PER_BYTE)
+      // Shift back to origin, picking up the bits of the ninth byte
+      val = window >> bitOffset;
+      if (bStraddles == true)
       {
-         // Yes, a simple cast will suffice
-         dataOut = *((T *)pData);
-
-         currentOffset += numBits;
-         return NO_ERROR;
+         val |= (ULONGLONG)pData[sizeof( window )] 
+             << (MAX_TYPE_BITS - bitOffset);
       }
 
-      // Extracting some small number of bits?
-      if (numBits <= bitsLeft)
+      if (numBits < MAX_TYPE_BITS)
       {
-         // Yes, simply shift back to origin and AND with correct mask
-         BYTE tmp = *pData;
-         tmp >>= (BITS_PER_BYTE - bitsLeft);
-         tmp &= MASK[numBits];
-
-         dataOut = (T)tmp;
-
-         currentOffset += numBits;
-         return NO_ERROR;
+         val &= ((ULONGLONG)1 << numBits) - 1;
       }
    }
-
-   // Not either of the simple cases - extract the relevant bits
-   // and then build the output
-
-   // Extract bits
-   BYTE bits[MAX_TYPE_BITS];
-   ULONG bitsExtracted = 0;
-   
-   while (bitsExtracted < numBits)
+   else
    {
-      BYTE bit = *pData;
-
-      if (bLSB == true)
+      // Shift the first bit to the top, picking up the bits of the ninth
+      // byte, then shift the value back down to origin
+      val = window << bitOffset;
+      if (bStraddles == true)
       {
-         bit <<= (bitsLeft - 1);
-         bit >>= (BITS_PER_BYTE - 1);
-         bits[bitsExtracted++] = bit;
-      }
-      else
-      {
-         bit >>= (bitsLeft - 1);
-         bit &= 0x01;
-         bits[numBits - ++bitsExtracted] = bit;
+         val |= (ULONGLONG)(pData[sizeof( window )] 
+             >> (BITS_PER_BYTE - bitOffset));
       }
 
-      bitsLeft--;
-      if (bitsLeft == 0)
-      {
-         pData++;
-         bitsLeft = BITS_PER_BYTE;
-      }
+      val >>= (MAX_TYPE_BITS - numBits);
    }
 
-   // Reassemble to form output value
-   dataOut = 0;
-   T tmp = 0;
-
-   for (ULONG b = 0; b < numBits; b++)
-   {
-      tmp = bits[b];
-      tmp <<= b;
-
-      dataOut |= tmp;
-   }
+   dataOut = (T)val;
 
    currentOffset += numBits;
    return NO_ERROR;
@@ -244,7 +201,7 @@ DWORD GetSignedVal(
 
       if (bSignExtend == true)
       {
-         T mask = (T)((~0) << numBits);
+         T mask = (T)(~(ULONGLONG)0 << numBits);
          dataOut |= mask;
       }
    }
@@ -80,6 +80,111 @@ void ByteSwap( T & data )
    }
 };
 
+/*===========================================================================
+METHOD:
+   LoadBitWindow (Inline Public Method)
+
+DESCRIPTION:
+   Load up to eight bytes from an (unaligned) buffer into a 64-bit window,
+   the first byte being the least significant byte of the window when
+   processing LSB -> MSB and the most significant byte otherwise, bytes
+   that are not loaded are zero
+
+PARAMETERS:
+   pData       [ I ] - Data buffer
+   numBytes    [ I ] - Number of bytes available in the above buffer
+   bLSB        [ I ] - Processing LSB -> MSB?
+
+RETURN VALUE:
+   ULONGLONG
+===========================================================================*/
+inline ULONGLONG LoadBitWindow(
+   const BYTE *               pData,
+   ULONG                      numBytes,
+   bool                       bLSB )
+{
+   ULONGLONG window = 0;
+   if (numBytes >= (ULONG)sizeof( window ))
+   {
+      memcpy( (LPVOID)&window, (LPCVOID)pData, sizeof( window ) );
+      if (bLSB == true)
+      {
+         window = le64toh( window );
+      }
+      else
+      {
+         window = be64toh( window );
+      }
+
+      return window;
+   }
+
+   for (ULONG b = 0; b < numBytes; b++)
+   {
+      if (bLSB == true)
+      {
+         window |= (ULONGLONG)pData[b] << (b * 8);
+      }
+      else
+      {
+         window |= (ULONGLONG)pData[b] << (56 - (b * 8));
+      }
+   }
+
+   return window;
+};
+
+/*===========================================================================
+METHOD:
+   StoreBitWindow (Inline Public Method)
+
+DESCRIPTION:
+   Store (up to eight bytes of) a 64-bit window to an (unaligned) buffer,
+   the inverse of LoadBitWindow()
+
+PARAMETERS:
+   pData       [ O ] - Data buffer
+   numBytes    [ I ] - Number of bytes available in the above buffer
+   window      [ I ] - Window to store
+   bLSB        [ I ] - Processing LSB -> MSB?
+
+RETURN VALUE:
+   None
+===========================================================================*/
+inline void StoreBitWindow(
+   BYTE *                     pData,
+   ULONG                      numBytes,
+   ULONGLONG                  window,
+   bool                       bLSB )
+{
+   if (numBytes >= (ULONG)sizeof( window ))
+   {
+      if (bLSB == true)
+      {
+         window = htole64( window );
+      }
+      else
+      {
+         window = htobe64( window );
+      }
+
+      memcpy( (LPVOID)pData, (LPCVOID)&window, sizeof( window ) );
+      return;
+   }
+
+   for (ULONG b = 0; b < numBytes; b++)
+   {
+      if (bLSB == true)
+      {
+         pData[b] = (BYTE)(window >> (b * 8));
+      }
+      else
+      {
+         pData[b] = (BYTE)(window >> (56 - (b * 8)));
+      }
+   }
+};
+
 /*=========================================================================*/
 // Class cBitParser
 //
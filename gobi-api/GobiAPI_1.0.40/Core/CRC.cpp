@@ -9,6 +9,7 @@ PUBLIC CLASSES AND METHODS:
    SetCRC()
    CheckCRC()
    CalculateCRC()
+   UpdateCRC()
 
 Copyright (c) 2011, Code Aurora Forum. All rights reserved.
 
@@ -170,11 +171,38 @@ USHORT CalculateCRC(
    // There must be a buffer
    ASSERT( pBuf != 0 );
  
-   USHORT CRC;
-   for (CRC = CRC_16_L_SEED; bitLen >= 8; bitLen -= 8, pBuf++) 
+   USHORT CRC = UpdateCRC( CRC_16_L_SEED, pBuf, bitLen / 8 );
+   return ~CRC;
+}
+
+/*===========================================================================
+METHOD:
+   UpdateCRC (Free Method)
+
+DESCRIPTION:
+   Continue a 16-bit CRC computation over more data, the running value
+   starts out as CRC_16_L_SEED and is not inverted (so the CRC of all
+   data processed so far is ~value, and appending that CRC yields a
+   running value of ~CRC_16_L_OK)
+  
+PARAMETERS:
+   CRC         [ I ] - The running CRC value
+   pBuf        [ I ] - The data buffer
+   len         [ I ] - The length of the above buffer (in bytes)
+
+RETURN VALUE:
+   USHORT: The updated running CRC value
+===========================================================================*/
+USHORT UpdateCRC(
+   USHORT                     CRC,
+   const BYTE *               pBuf, 
+   ULONG                      len )
+{
+   const BYTE * pEnd = pBuf + len;
+   while (pBuf < pEnd)
    {
-      CRC = CRCTable[(CRC ^ *pBuf) & 0x00ff] ^ (CRC >> 8);
+      CRC = CRCTable[(CRC ^ *pBuf++) & 0x00ff] ^ (CRC >> 8);
    }
 
-   return ~CRC;
+   return CRC;
 }
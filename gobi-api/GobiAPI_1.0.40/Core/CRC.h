@@ -9,6 +9,7 @@ PUBLIC CLASSES AND METHODS:
    SetCRC()
    CheckCRC()
    CalculateCRC()
+   UpdateCRC()
 
 Copyright (c) 2011, Code Aurora Forum. All rights reserved.
 
@@ -73,3 +74,9 @@ USHORT CalculateCRC(
    const BYTE *               pBuf, 
    ULONG                      bitLen );
 
+// Continue a (non-inverted) running CRC value over the given data
+USHORT UpdateCRC( 
+   USHORT                     CRC,
+   const BYTE *               pBuf, 
+   ULONG                      len );
+
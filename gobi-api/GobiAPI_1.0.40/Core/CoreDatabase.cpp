@@ -47,6 +47,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "DB2NavTree.h"
 
 #include "CoreUtilities.h"
+#include "MemoryMappedFile.h"
 
 //---------------------------------------------------------------------------
 // Definitions
@@ -55,6 +56,13 @@ POSSIBILITY OF SUCH DAMAGE.
 // Uncomment out to enable database load/save timing through cCoreDatabase
 // #define TIME_DB 1
 
+// Compiled database image file (installed by the database build)
+#ifndef DB2_IMAGE_FILE
+#define DB2_IMAGE_FILE "/usr/share/GobiAPI/QMI.db"
+#endif
+
+LPCSTR DB2_FILE_IMAGE = DB2_IMAGE_FILE;
+
 // Database table file names
 LPCSTR DB2_FILE_PROTOCOL_FIELD   = "Field.txt";
 LPCSTR DB2_FILE_PROTOCOL_STRUCT  = "Struct.txt";
@@ -69,6 +77,9 @@ LPCSTR DB2_TABLE_PROTOCOL_ENTITY = "Entity";
 LPCSTR DB2_TABLE_ENUM_MAIN       = "Enum";
 LPCSTR DB2_TABLE_ENUM_ENTRY      = "Enum Entry";
 
+// Compiled database image name (for error reporting)
+LPCSTR DB2_TABLE_IMAGE           = "Image";
+
 // An empty (but not NULL) string
 LPCSTR EMPTY_STRING = "";
 
@@ -141,6 +152,32 @@ LPCSTR CopyQuotedString( LPSTR pString )
    return 0;
 }
 
+/*===========================================================================
+METHOD:
+   HashTextTable (Public Method)
+
+DESCRIPTION:
+   Continue a running compiled database image hash over a database text
+   table (the table size is hashed too, to separate the tables)
+  
+PARAMETERS:
+   hash        [ I ] - Running hash
+   pTable      [ I ] - Table text
+   tableSz     [ I ] - Size of table text
+
+RETURN VALUE:
+   UINT - Updated hash
+===========================================================================*/
+UINT HashTextTable( 
+   UINT                       hash,
+   LPCVOID                    pTable,
+   ULONG                      tableSz )
+{
+   UINT sz = (UINT)tableSz;
+   hash = DB2ImageHash( hash, (const BYTE *)&sz, (ULONG)sizeof( sz ) );
+   return DB2ImageHash( hash, (const BYTE *)pTable, tableSz );
+}
+
 /*=========================================================================*/
 // sDB2ProtocolEntity Methods
 /*=========================================================================*/
@@ -216,6 +253,77 @@ bool sDB2ProtocolEntity::FromString( LPSTR pStr )
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   FromImage (Public Method)
+
+DESCRIPTION:
+   Populate this object from a compiled database image record
+
+PARAMETERS:
+   image       [ I ] - Image the record belongs to
+   rec         [ I ] - Record to populate object from
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool sDB2ProtocolEntity::FromImage( 
+   const cDB2Image &          image,
+   const sDB2ImageEntity &    rec )
+{
+   mType = (eDB2EntityType)rec.mType;
+
+   mID.reserve( rec.mIDCount );
+   for (UINT i = 0; i < rec.mIDCount; i++)
+   {
+      mID.push_back( image.GetEntityID( rec.mIDOffset + i ) );
+   }
+
+   mStructID   = rec.mStructID;
+   mFormatID   = rec.mFormatID;
+   mbInternal  = (rec.mbInternal != 0);
+   mFormatExID = rec.mFormatExID;
+   mpName      = image.GetString( rec.mName );
+
+   return IsValid();
+}
+
+/*===========================================================================
+METHOD:
+   ToImage (Public Method)
+
+DESCRIPTION:
+   Convert this object to a compiled database image record
+
+PARAMETERS:
+   ids         [I/O] - Image protocol entity ID table
+   strings     [I/O] - Image string pool
+   rec         [ O ] - Resulting record
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2ProtocolEntity::ToImage( 
+   std::vector <UINT> &       ids,
+   cDB2ImageStringPool &      strings,
+   sDB2ImageEntity &          rec ) const
+{
+   rec.mType     = (UINT)mType;
+   rec.mIDOffset = (UINT)ids.size();
+   rec.mIDCount  = (UINT)mID.size();
+
+   for (ULONG i = 0; i < (ULONG)mID.size(); i++)
+   {
+      ids.push_back( (UINT)mID[i] );
+   }
+
+   rec.mStructID   = mStructID;
+   rec.mFormatID   = mFormatID;
+   rec.mFormatExID = mFormatExID;
+   rec.mbInternal  = (mbInternal == true ? 1 : 0);
+   rec.mName       = strings.Add( mpName );
+}
+
 /*===========================================================================
 METHOD:
    IsValid (Public Method)
@@ -330,6 +438,64 @@ bool sDB2Fragment::FromString( LPSTR pStr )
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   FromImage (Public Method)
+
+DESCRIPTION:
+   Populate this object from a compiled database image record
+
+PARAMETERS:
+   image       [ I ] - Image the record belongs to
+   rec         [ I ] - Record to populate object from
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool sDB2Fragment::FromImage( 
+   const cDB2Image &          image,
+   const sDB2ImageFragment &  rec )
+{
+   mStructID       = rec.mStructID;
+   mFragmentOrder  = rec.mFragmentOrder;
+   mFragmentValue  = rec.mFragmentValue;
+   mFragmentOffset = rec.mFragmentOffset;
+   mFragmentType   = (eDB2FragmentType)rec.mFragmentType;
+   mModifierType   = (eDB2ModifierType)rec.mModifierType;
+   mpModifierValue = image.GetString( rec.mModifierValue );
+   mpName          = image.GetString( rec.mName );
+
+   return IsValid();
+}
+
+/*===========================================================================
+METHOD:
+   ToImage (Public Method)
+
+DESCRIPTION:
+   Convert this object to a compiled database image record
+
+PARAMETERS:
+   strings     [I/O] - Image string pool
+   rec         [ O ] - Resulting record
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2Fragment::ToImage( 
+   cDB2ImageStringPool &      strings,
+   sDB2ImageFragment &        rec ) const
+{
+   rec.mStructID       = (UINT)mStructID;
+   rec.mFragmentOrder  = (UINT)mFragmentOrder;
+   rec.mFragmentValue  = (UINT)mFragmentValue;
+   rec.mFragmentOffset = mFragmentOffset;
+   rec.mFragmentType   = (UINT)mFragmentType;
+   rec.mModifierType   = (UINT)mModifierType;
+   rec.mModifierValue  = strings.Add( mpModifierValue );
+   rec.mName           = strings.Add( mpName );
+}
+
 /*===========================================================================
 METHOD:
    IsValid (Public Method)
@@ -1155,6 +1321,64 @@ bool sDB2Field::FromString( LPSTR pStr )
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   FromImage (Public Method)
+
+DESCRIPTION:
+   Populate this object from a compiled database image record
+
+PARAMETERS:
+   image       [ I ] - Image the record belongs to
+   rec         [ I ] - Record to populate object from
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool sDB2Field::FromImage( 
+   const cDB2Image &          image,
+   const sDB2ImageField &     rec )
+{
+   mID            = rec.mID;
+   mSize          = rec.mSize;
+   mpName         = image.GetString( rec.mName );
+   mType          = (eDB2FieldType)rec.mType;
+   mTypeVal       = rec.mTypeVal;
+   mbHex          = (rec.mbHex != 0);
+   mDescriptionID = rec.mDescriptionID;
+   mbInternal     = (rec.mbInternal != 0);
+
+   return IsValid();
+}
+
+/*===========================================================================
+METHOD:
+   ToImage (Public Method)
+
+DESCRIPTION:
+   Convert this object to a compiled database image record
+
+PARAMETERS:
+   strings     [I/O] - Image string pool
+   rec         [ O ] - Resulting record
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2Field::ToImage( 
+   cDB2ImageStringPool &      strings,
+   sDB2ImageField &           rec ) const
+{
+   rec.mID            = (UINT)mID;
+   rec.mSize          = (UINT)mSize;
+   rec.mName          = strings.Add( mpName );
+   rec.mType          = (UINT)mType;
+   rec.mTypeVal       = (UINT)mTypeVal;
+   rec.mbHex          = (mbHex == true ? 1 : 0);
+   rec.mDescriptionID = mDescriptionID;
+   rec.mbInternal     = (mbInternal == true ? 1 : 0);
+}
+
 /*===========================================================================
 METHOD:
    IsValid (Public Method)
@@ -1519,6 +1743,56 @@ bool sDB2Enum::FromString( LPSTR pStr )
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   FromImage (Public Method)
+
+DESCRIPTION:
+   Populate this object from a compiled database image record
+
+PARAMETERS:
+   image       [ I ] - Image the record belongs to
+   rec         [ I ] - Record to populate object from
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool sDB2Enum::FromImage( 
+   const cDB2Image &          image,
+   const sDB2ImageEnum &      rec )
+{
+   mID            = rec.mID;
+   mbInternal     = (rec.mbInternal != 0);
+   mpName         = image.GetString( rec.mName );
+   mDescriptionID = rec.mDescriptionID;
+
+   return IsValid();
+}
+
+/*===========================================================================
+METHOD:
+   ToImage (Public Method)
+
+DESCRIPTION:
+   Convert this object to a compiled database image record
+
+PARAMETERS:
+   strings     [I/O] - Image string pool
+   rec         [ O ] - Resulting record
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2Enum::ToImage( 
+   cDB2ImageStringPool &      strings,
+   sDB2ImageEnum &            rec ) const
+{
+   rec.mID            = (UINT)mID;
+   rec.mbInternal     = (mbInternal == true ? 1 : 0);
+   rec.mName          = strings.Add( mpName );
+   rec.mDescriptionID = mDescriptionID;
+}
+
 /*===========================================================================
 METHOD:
    IsValid (Public Method)
@@ -1609,6 +1883,58 @@ bool sDB2EnumEntry::FromString( LPSTR pStr )
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   FromImage (Public Method)
+
+DESCRIPTION:
+   Populate this object from a compiled database image record
+
+PARAMETERS:
+   image       [ I ] - Image the record belongs to
+   rec         [ I ] - Record to populate object from
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool sDB2EnumEntry::FromImage( 
+   const cDB2Image &          image,
+   const sDB2ImageEnumEntry & rec )
+{
+   mID            = rec.mID;
+   mValue         = rec.mValue;
+   mbHex          = (rec.mbHex != 0);
+   mpName         = image.GetString( rec.mName );
+   mDescriptionID = rec.mDescriptionID;
+
+   return IsValid();
+}
+
+/*===========================================================================
+METHOD:
+   ToImage (Public Method)
+
+DESCRIPTION:
+   Convert this object to a compiled database image record
+
+PARAMETERS:
+   strings     [I/O] - Image string pool
+   rec         [ O ] - Resulting record
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2EnumEntry::ToImage( 
+   cDB2ImageStringPool &      strings,
+   sDB2ImageEnumEntry &       rec ) const
+{
+   rec.mID            = (UINT)mID;
+   rec.mValue         = mValue;
+   rec.mbHex          = (mbHex == true ? 1 : 0);
+   rec.mName          = strings.Add( mpName );
+   rec.mDescriptionID = mDescriptionID;
+}
+
 /*===========================================================================
 METHOD:
    IsValid (Public Method)
@@ -1635,6 +1961,97 @@ bool sDB2EnumEntry::IsValid() const
    return true;
 }
 
+/*===========================================================================
+METHOD:
+   PackEntityKey (Free Method)
+
+DESCRIPTION:
+   Pack a protocol entity key into 64 bits for the flat entity index, the
+   key length takes 2 bits, the entity type 14 bits, and up to two more
+   ID values 24 bits each
+  
+PARAMETERS:
+   key         [ I ] - Protocol entity key
+   packed      [ O ] - The packed key
+
+RETURN VALUE:
+   bool - Could the key be packed?
+===========================================================================*/
+static bool PackEntityKey(
+   const std::vector <ULONG> &   key,
+   ULONGLONG &                   packed )
+{
+   const ULONG TYPE_BITS = 14;
+   const ULONG ID_BITS = 24;
+
+   ULONG keyLen = (ULONG)key.size();
+   if (keyLen == 0 || keyLen > 3 || key[0] >= (1UL << TYPE_BITS))
+   {
+      return false;
+   }
+
+   packed = (ULONGLONG)(keyLen - 1) << (TYPE_BITS + 2 * ID_BITS);
+   packed |= (ULONGLONG)key[0] << (2 * ID_BITS);
+
+   for (ULONG i = 1; i < keyLen; i++)
+   {
+      if (key[i] >= (1UL << ID_BITS))
+      {
+         return false;
+      }
+
+      packed |= (ULONGLONG)key[i] << ((2 - i) * ID_BITS);
+   }
+
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   PackEnumEntryKey (Free Method)
+
+DESCRIPTION:
+   Pack an enum ID/value pair into 64 bits for the flat enum entry index
+  
+PARAMETERS:
+   enumID      [ I ] - ID of the enumeration
+   enumVal     [ I ] - Enum value
+   packed      [ O ] - The packed key
+
+RETURN VALUE:
+   bool - Could the key be packed?
+===========================================================================*/
+static bool PackEnumEntryKey(
+   ULONG                      enumID,
+   int                        enumVal,
+   ULONGLONG &                packed )
+{
+   if ((ULONGLONG)enumID > 0xFFFFFFFFULL)
+   {
+      return false;
+   }
+
+   packed = ((ULONGLONG)enumID << 32) | (ULONGLONG)(UINT)enumVal;
+   return true;
+}
+
+/*=========================================================================*/
+// Struct sDB2EntityKeyCmp
+//
+//    Orders the flat protocol entity list against a protocol entity key
+/*=========================================================================*/
+struct sDB2EntityKeyCmp
+{
+   public:
+      // (Inline) Is the entity key < the given key?
+      bool operator () (
+         const sDB2ProtocolEntity *    pEntity,
+         const std::vector <ULONG> &   key ) const
+      {
+         return (pEntity->mID < key);
+      };
+};
+
 /*=========================================================================*/
 // cCoreDatabase Methods
 /*=========================================================================*/
@@ -1650,9 +2067,22 @@ RETURN VALUE:
    None
 ===========================================================================*/
 cCoreDatabase::cCoreDatabase()
-   :  mpLog( &gDB2DefaultLog )
+   :  mpLog( &gDB2DefaultLog ),
+      mpImageFile( 0 ),
+      mSourceHash( 0 ),
+      mbNavTreesBuilt( false ),
+      mbUnpackedEntityKeys( false ),
+      mEntityNameIndex( true ),
+      mEnumIndex( false )
 {
-   // Nothing to do - database empty, call Initialize()
+   // Database empty, call Initialize()
+   int nRet = pthread_rwlock_init( &mNavTreeLock, NULL );
+   if (nRet != 0)
+   {
+      TRACE( "cCoreDatabase: Unable to init nav tree lock. Error %d: %s\n",
+             nRet,
+             strerror( nRet ) );
+   }
 }
 
 /*===========================================================================
@@ -1668,6 +2098,8 @@ RETURN VALUE:
 cCoreDatabase::~cCoreDatabase()
 {
    Exit();
+
+   pthread_rwlock_destroy( &mNavTreeLock );
 }
 
 /*===========================================================================
@@ -1694,10 +2126,14 @@ bool cCoreDatabase::Initialize( LPCSTR pBasePath )
 
    bRC &= LoadEnumTables( pBasePath );
    bRC &= LoadStructureTables( pBasePath );
+   bRC &= HashTextTables( pBasePath, mSourceHash );
 
    // Build the modifier tables
    bRC &= BuildModifierTables();
 
+   // Build the lookup indexes
+   BuildIndexes();
+
    return bRC;
 }
 
@@ -1709,6 +2145,10 @@ DESCRIPTION:
    Version to Load from internal pointers
    Initialize the database - this must be done once (and only once)
    prior to the database being accessed
+
+   The installed compiled database image is used when present, valid
+   and compiled from the embedded database text, otherwise the embedded
+   database text is parsed
   
 PARAMETERS
 
@@ -1722,103 +2162,430 @@ bool cCoreDatabase::Initialize()
    // Cleanup the last database (if necessary)
    Exit();
 
+   struct stat fileInfo;
+   if (stat( DB2_FILE_IMAGE, &fileInfo ) == 0)
+   {
+      cMemoryMappedFile * pImageFile = new cMemoryMappedFile( DB2_FILE_IMAGE );
+      if (LoadImage( pImageFile, true ) == true)
+      {
+         return true;
+      }
+   }
+
    bRC &= LoadEnumTables();
    bRC &= LoadStructureTables();
+   mSourceHash = HashTextTables();
 
    // Build the modifier tables
    bRC &= BuildModifierTables();
 
+   // Build the lookup indexes
+   BuildIndexes();
+
    return bRC;
 }
 
 /*===========================================================================
 METHOD:
-   Exit (Public Method)
+   InitializeFromImage (Public Method)
 
 DESCRIPTION:
-   Exit (cleanup) the database
+   Version to Load from a compiled database image file
+   Initialize the database - this must be done once (and only once)
+   prior to the database being accessed
+
+   The image file is memory mapped (and so shared by every process using
+   it) and remains mapped until the database is exited
   
+PARAMETERS
+   pImageFile        [ I ] - Compiled database image file
+
 RETURN VALUE:
-   None
+   bool
 ===========================================================================*/
-void cCoreDatabase::Exit()
+bool cCoreDatabase::InitializeFromImage( LPCSTR pImageFile )
 {
-   FreeDB2Table( mEntityFields );
-   FreeDB2Table( mEntityStructs );
-   FreeDB2Table( mProtocolEntities );
-
-   FreeDB2Table( mEnumNameMap );
-   FreeDB2Table( mEnumEntryMap );
+   // Cleanup the last database (if necessary)
+   Exit();
 
-   tDB2EntityNavMap::iterator pIter = mEntityNavMap.begin();
-   while (pIter != mEntityNavMap.end())
+   if (pImageFile == 0 || pImageFile[0] == 0)
    {
-      cDB2NavTree * pNav = pIter->second;
-      if (pNav != 0)
-      {
-         delete pNav;
-      }
-
-      pIter++;
+      return false;
    }
 
-   mEntityNavMap.clear();
+   cMemoryMappedFile * pFile = new cMemoryMappedFile( pImageFile );
+   return LoadImage( pFile, false );
 }
 
 /*===========================================================================
 METHOD:
-   GetEntityNavTree (Public Method)
+   SaveImage (Public Method)
 
 DESCRIPTION:
-   Get the entity navigation tree for the given protocol entity, if none 
-   exists one will be built and returned
+   Save the database as a compiled database image file
+
+   The image holds the loaded (and hence validated and repaired) tables
+   in key order, followed by a string pool shared by all tables
   
-PARAMETERS   
-   key         [ I ] - Protocol entity key
+PARAMETERS
+   pImageFile        [ I ] - Compiled database image file
 
 RETURN VALUE:
-   const cDB2NavTree * (0 upon error)
+   bool
 ===========================================================================*/
-const cDB2NavTree * cCoreDatabase::GetEntityNavTree( 
-   const std::vector <ULONG> &   key ) const
+bool cCoreDatabase::SaveImage( LPCSTR pImageFile ) const
 {
-   // Look up entity definition (to find DB string address)
-   sDB2ProtocolEntity tmpEntity;
-   bool bFound = FindEntity( key, tmpEntity );
-
-   // Did we find it?
-   if (bFound == false)
+   if (pImageFile == 0 || pImageFile[0] == 0)
    {
-      // No matching definition in database
-      return 0;
+      return false;
    }
 
-   // Obtain the canonical key and use it to look up the nav tree
-   tDB2EntityNavMap::const_iterator pIter = mEntityNavMap.find( key );
-   if (pIter != mEntityNavMap.end())
-   {
-      return pIter->second;
-   }
+   cDB2ImageStringPool strings;
+
+   std::vector <sDB2ImageEntity> entities;
+   std::vector <UINT> ids;
+   std::map <std::vector <ULONG>, UINT> indices;
+   tDB2EntityMap::const_iterator pEntity = mProtocolEntities.begin();
+   while (pEntity != mProtocolEntities.end())
+   {
+      sDB2ImageEntity rec;
+      pEntity->second.ToImage( ids, strings, rec );
+
+      indices.insert( std::make_pair( pEntity->first, 
+                                      (UINT)entities.size() ) );
+
+      entities.push_back( rec );
+      pEntity++;
+   }
+
+   // Protocol entities in (case insensitive) name order
+   std::vector <UINT> names;
+   tDB2EntityNameMap::const_iterator pName = mEntityNames.begin();
+   while (pName != mEntityNames.end())
+   {
+      names.push_back( indices[pName->second] );
+      pName++;
+   }
+
+   std::vector <sDB2ImageFragment> frags;
+   tDB2FragmentMap::const_iterator pFrag = mEntityStructs.begin();
+   while (pFrag != mEntityStructs.end())
+   {
+      sDB2ImageFragment rec;
+      pFrag->second.ToImage( strings, rec );
+      frags.push_back( rec );
+
+      pFrag++;
+   }
+
+   std::vector <sDB2ImageField> fields;
+   tDB2FieldMap::const_iterator pField = mEntityFields.begin();
+   while (pField != mEntityFields.end())
+   {
+      sDB2ImageField rec;
+      pField->second.ToImage( strings, rec );
+      fields.push_back( rec );
+
+      pField++;
+   }
+
+   std::vector <sDB2ImageEnum> enums;
+   tDB2EnumNameMap::const_iterator pEnum = mEnumNameMap.begin();
+   while (pEnum != mEnumNameMap.end())
+   {
+      sDB2ImageEnum rec;
+      pEnum->second.ToImage( strings, rec );
+      enums.push_back( rec );
+
+      pEnum++;
+   }
+
+   std::vector <sDB2ImageEnumEntry> entries;
+   tDB2EnumEntryMap::const_iterator pEntry = mEnumEntryMap.begin();
+   while (pEntry != mEnumEntryMap.end())
+   {
+      sDB2ImageEnumEntry rec;
+      pEntry->second.ToImage( strings, rec );
+      entries.push_back( rec );
+
+      pEntry++;
+   }
+
+   const std::string & pool = strings.GetContents();
+
+   // Lay out the tables (in table order) after the header
+   const void * pTables[eDB2_IMAGE_TABLE_ENUM_END];
+   ULONG counts[eDB2_IMAGE_TABLE_ENUM_END];
+
+   pTables[eDB2_IMAGE_TABLE_ENTITY] = entities.empty() ? 0 : &entities[0];
+   counts[eDB2_IMAGE_TABLE_ENTITY] = (ULONG)entities.size();
+
+   pTables[eDB2_IMAGE_TABLE_ENTITY_ID] = ids.empty() ? 0 : &ids[0];
+   counts[eDB2_IMAGE_TABLE_ENTITY_ID] = (ULONG)ids.size();
+
+   pTables[eDB2_IMAGE_TABLE_ENTITY_NAME] = names.empty() ? 0 : &names[0];
+   counts[eDB2_IMAGE_TABLE_ENTITY_NAME] = (ULONG)names.size();
+
+   pTables[eDB2_IMAGE_TABLE_STRUCT] = frags.empty() ? 0 : &frags[0];
+   counts[eDB2_IMAGE_TABLE_STRUCT] = (ULONG)frags.size();
+
+   pTables[eDB2_IMAGE_TABLE_FIELD] = fields.empty() ? 0 : &fields[0];
+   counts[eDB2_IMAGE_TABLE_FIELD] = (ULONG)fields.size();
+
+   pTables[eDB2_IMAGE_TABLE_ENUM] = enums.empty() ? 0 : &enums[0];
+   counts[eDB2_IMAGE_TABLE_ENUM] = (ULONG)enums.size();
+
+   pTables[eDB2_IMAGE_TABLE_ENUM_ENTRY] = entries.empty() ? 0 : &entries[0];
+   counts[eDB2_IMAGE_TABLE_ENUM_ENTRY] = (ULONG)entries.size();
+
+   pTables[eDB2_IMAGE_TABLE_STRINGS] = pool.data();
+   counts[eDB2_IMAGE_TABLE_STRINGS] = (ULONG)pool.size();
+
+   sDB2ImageHeader hdr;
+   memset( (LPVOID)&hdr, 0, sizeof( hdr ) );
+   hdr.mMagic = DB2_IMAGE_MAGIC;
+   hdr.mVersion = DB2_IMAGE_VERSION;
+   hdr.mSourceHash = mSourceHash;
+   hdr.mChecksum = DB2_IMAGE_HASH_SEED;
+
+   UINT offset = sizeof( hdr );
+   for (ULONG t = 0; t < (ULONG)eDB2_IMAGE_TABLE_ENUM_END; t++)
+   {
+      sDB2ImageTable & table = hdr.mTables[t];
+      table.mOffset = offset;
+      table.mCount = (UINT)counts[t];
+      table.mRecordSize = DB2_IMAGE_RECORD_SIZE[t];
+
+      offset += table.mCount * table.mRecordSize;
+      if (table.mCount > 0)
+      {
+         hdr.mChecksum = DB2ImageHash( hdr.mChecksum,
+                                       (const BYTE *)pTables[t],
+                                       table.mCount * table.mRecordSize );
+      }
+   }
+
+   hdr.mSize = offset;
+
+   std::ofstream outFile;
+   outFile.open( pImageFile, std::ios::out | std::ios::binary | std::ios::trunc );
+   if (outFile.fail() == true)
+   {
+      std::ostringstream tmp;
+      tmp << "DB [" << DB2_TABLE_IMAGE << "] Error creating file \'" 
+          << pImageFile << "\'";
+
+      mpLog->Log( tmp.str(), eDB2_STATUS_ERROR );
+      return false;
+   }
+
+   outFile.write( (const char *)&hdr, sizeof( hdr ) );
+   for (ULONG t = 0; t < (ULONG)eDB2_IMAGE_TABLE_ENUM_END; t++)
+   {
+      const sDB2ImageTable & table = hdr.mTables[t];
+      if (table.mCount > 0)
+      {
+         outFile.write( (const char *)pTables[t], 
+                        table.mCount * table.mRecordSize );
+      }
+   }
+
+   outFile.close();
+   return (outFile.fail() == false);
+}
+
+/*===========================================================================
+METHOD:
+   Exit (Public Method)
+
+DESCRIPTION:
+   Exit (cleanup) the database
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void cCoreDatabase::Exit()
+{
+   std::vector <cDB2NavTree *>::iterator pNavIter = mEntityNavList.begin();
+   while (pNavIter != mEntityNavList.end())
+   {
+      cDB2NavTree * pNav = *pNavIter;
+      if (pNav != 0)
+      {
+         delete pNav;
+      }
+
+      pNavIter++;
+   }
+
+   mEntityNavList.clear();
+   mbNavTreesBuilt = false;
+
+   // Indexes reference the loaded tables
+   mEntityList.clear();
+   mEntityIndex.Clear();
+   mEntityNameIndex.Clear();
+   mEnumEntryNames.clear();
+   mEnumEntryIndex.Clear();
+   mEnumIndex.Clear();
+   mbUnpackedEntityKeys = false;
+
+   // Tables derived from the loaded tables reference their strings
+   mEntityNames.clear();
+   mEnumMap.clear();
+   mOptionalModMap.clear();
+   mExpressionModMap.clear();
+   mArray1ModMap.clear();
+   mArray2ModMap.clear();
+
+   if (mpImageFile != 0)
+   {
+      // Strings belong to the image
+      mEntityFields.clear();
+      mEntityStructs.clear();
+      mProtocolEntities.clear();
+
+      mEnumNameMap.clear();
+      mEnumEntryMap.clear();
+
+      delete mpImageFile;
+      mpImageFile = 0;
+   }
+   else
+   {
+      FreeDB2Table( mEntityFields );
+      FreeDB2Table( mEntityStructs );
+      FreeDB2Table( mProtocolEntities );
+
+      FreeDB2Table( mEnumNameMap );
+      FreeDB2Table( mEnumEntryMap );
+   }
+}
+
+/*===========================================================================
+METHOD:
+   GetEntityNavTree (Public Method)
+
+DESCRIPTION:
+   Get the entity navigation tree for the given protocol entity, if none 
+   exists one will be built and returned
+  
+PARAMETERS   
+   key         [ I ] - Protocol entity key
+
+RETURN VALUE:
+   const cDB2NavTree * (0 upon error)
+===========================================================================*/
+const cDB2NavTree * cCoreDatabase::GetEntityNavTree( 
+   const std::vector <ULONG> &   key ) const
+{
+   // Look up entity definition
+   ULONG index = FindEntityIndex( key );
+   if (index == DB2_INDEX_NOT_FOUND)
+   {
+      // No matching definition in database
+      return 0;
+   }
+
+   // Nav trees are kept alongside the entity, once all have been built
+   // they are never modified again
+   if (mbNavTreesBuilt == true)
+   {
+      return mEntityNavList[index];
+   }
+
+   pthread_rwlock_rdlock( &mNavTreeLock );
+   cDB2NavTree * pNavTree = mEntityNavList[index];
+   pthread_rwlock_unlock( &mNavTreeLock );
 
-   // None found, go ahead and build one
-   cDB2NavTree * pNavTree = new cDB2NavTree( *this );
    if (pNavTree != 0)
    {
-      bool bOK = pNavTree->BuildTree( key );
+      return pNavTree;
+   }
+
+   // None found, go ahead and build one (unless another thread beat us)
+   pthread_rwlock_wrlock( &mNavTreeLock );
+
+   pNavTree = mEntityNavList[index];
+   if (pNavTree == 0)
+   {
+      pNavTree = new cDB2NavTree( *this );
+      if (pNavTree != 0)
+      {
+         bool bOK = pNavTree->BuildTree( key );
+         if (bOK == true)
+         {
+            // Store it and return it to the user
+            mEntityNavList[index] = pNavTree;
+         }
+         else
+         {
+            delete pNavTree;
+            pNavTree = 0;
+         }
+      }
+   }
+
+   pthread_rwlock_unlock( &mNavTreeLock );
+   return pNavTree;
+}
+
+/*===========================================================================
+METHOD:
+   BuildNavTrees (Public Method)
+
+DESCRIPTION:
+   Build the navigation trees of all protocol entities up front, after
+   which GetEntityNavTree() neither builds nor locks; this should be
+   called before the database is shared between threads
+  
+RETURN VALUE:
+   bool - Were all navigation trees built?
+===========================================================================*/
+bool cCoreDatabase::BuildNavTrees()
+{
+   // Assume success
+   bool bRC = true;
+
+   pthread_rwlock_wrlock( &mNavTreeLock );
+
+   for (ULONG e = 0; e < (ULONG)mEntityList.size(); e++)
+   {
+      if (mEntityNavList[e] != 0)
+      {
+         continue;
+      }
+
+      cDB2NavTree * pNavTree = new cDB2NavTree( *this );
+      if (pNavTree == 0)
+      {
+         bRC = false;
+         continue;
+      }
+
+      bool bOK = pNavTree->BuildTree( mEntityList[e]->mID );
       if (bOK == true)
       {
-         // Store it and return it to the user
-         std::pair <std::vector <ULONG>, cDB2NavTree *> e( key, pNavTree );
-         mEntityNavMap.insert( e );
+         mEntityNavList[e] = pNavTree;
       }
       else
       {
+         std::ostringstream tmp;
+         tmp << "DB [" << DB2_TABLE_PROTOCOL_ENTITY 
+             << "] Unable to build navigation tree \'" 
+             << mEntityList[e]->mpName << "\'";
+
+         mpLog->Log( tmp.str(), eDB2_STATUS_WARNING );
+
          delete pNavTree;
-         pNavTree = 0;
+         bRC = false;
       }
    }
 
-   return pNavTree;
+   mbNavTreesBuilt = true;
+
+   pthread_rwlock_unlock( &mNavTreeLock );
+   return bRC;
 }
 
 /*===========================================================================
@@ -1842,10 +2609,10 @@ bool cCoreDatabase::FindEntity(
    // Assume failure
    bool bFound = false;
 
-   tDB2EntityMap::const_iterator pEntity = mProtocolEntities.find( key );
-   if (pEntity != mProtocolEntities.end())
+   ULONG index = FindEntityIndex( key );
+   if (index != DB2_INDEX_NOT_FOUND)
    {
-      entity = pEntity->second;
+      entity = *mEntityList[index];
       bFound = true;
    }
 
@@ -1874,11 +2641,11 @@ bool cCoreDatabase::FindEntity(
    bool bFound = false;
    if (pEntityName != 0 && pEntityName[0] != 0)
    {
-      tDB2EntityNameMap::const_iterator pIter = mEntityNames.find( pEntityName );
-      if (pIter != mEntityNames.end())
+      ULONG index = mEntityNameIndex.Find( pEntityName );
+      if (index != DB2_INDEX_NOT_FOUND)
       {
-         const std::vector <ULONG> & key = pIter->second;
-         bFound = FindEntity( key, entity );
+         entity = *mEntityList[index];
+         bFound = true;
       }
    }
 
@@ -1908,24 +2675,28 @@ bool cCoreDatabase::MapEntityNameToID(
 
    if (pName != 0 && pName[0] != 0)
    {
-      std::string tmp = pName;
-      
-      // std::string version of Trim()
-      int nFirst = tmp.find_first_not_of( ' ' );
-      int nLast = tmp.find_last_not_of( ' ' );
-      if (nFirst == -1 || nLast == -1)
+      // Trim() the name in place
+      LPCSTR pLast = pName + strlen( pName );
+      while (pName < pLast && *pName == ' ')
+      {
+         pName++;
+      }
+
+      while (pLast > pName && *(pLast - 1) == ' ')
+      {
+         pLast--;
+      }
+
+      if (pName == pLast)
       {
          // Something went wrong, empty string or all spaces
          return false;
       }
 
-      tmp = tmp.substr( nFirst, nLast - nFirst + 1 );
-     
-      
-      tDB2EntityNameMap::const_iterator pIter = mEntityNames.find( tmp.c_str() );
-      if (pIter != mEntityNames.end())
+      ULONG index = mEntityNameIndex.Find( pName, (ULONG)(pLast - pName) );
+      if (index != DB2_INDEX_NOT_FOUND)
       {
-         key = pIter->second;
+         key = mEntityList[index]->mID;
          bOK = true;
       }
    }
@@ -1963,15 +2734,11 @@ std::string cCoreDatabase::MapEnumToString(
 {
    std::string retStr = "";
 
-   // Form the lookup key
-   std::pair <ULONG, int> key( enumID, enumVal );
-
-   // Look up the enum value descriptor
-   tDB2EnumEntryMap::const_iterator pVals = mEnumEntryMap.find( key );
-   if (pVals != mEnumEntryMap.end())
+   // Look up the enum value name
+   LPCSTR pName = FindEnumEntryName( enumID, enumVal );
+   if (pName != 0)
    {
-      const sDB2EnumEntry & entry = pVals->second;
-      retStr = entry.mpName;
+      retStr = pName;
    }
 
    // No string?
@@ -2030,16 +2797,13 @@ std::string cCoreDatabase::MapEnumToString(
 {
    std::string retStr = "";
 
-   tDB2EnumMap::const_iterator pEnumMapIter = mEnumMap.find( pEnumName );      
-   if (pEnumMapIter != mEnumMap.end())
+   ULONG enumID = mEnumIndex.Find( pEnumName );
+   if (enumID != DB2_INDEX_NOT_FOUND)
    {
-      const std::map <int, LPCSTR> & entries = pEnumMapIter->second.second;
-      std::map <int, LPCSTR>::const_iterator pEntry;
-
-      pEntry = entries.find( enumVal );
-      if (pEntry != entries.end())
+      LPCSTR pName = FindEnumEntryName( enumID, enumVal );
+      if (pName != 0)
       {
-         retStr = pEntry->second;
+         retStr = pName;
       }
    }
 
@@ -2074,6 +2838,293 @@ std::string cCoreDatabase::MapEnumToString(
    return retStr;
 }
 
+/*===========================================================================
+METHOD:
+   LoadImage (Internal Method)
+
+DESCRIPTION:
+   Load all tables from a compiled database image, the image was built
+   from validated tables so structure validation is skipped; upon 
+   failure the database is left empty
+  
+PARAMETERS
+   pImageFile     [ I ] - Compiled database image (ownership is taken)
+   bCheckSource   [ I ] - Reject the image unless it was compiled from
+                          the embedded database text?
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cCoreDatabase::LoadImage( 
+   cMemoryMappedFile *        pImageFile,
+   bool                       bCheckSource )
+{
+   if (pImageFile == 0)
+   {
+      return false;
+   }
+
+   cDB2Image image( pImageFile->GetContents(), pImageFile->GetSize() );
+   if (image.IsValid() == false)
+   {
+      std::ostringstream tmp;
+      tmp << "DB [" << DB2_TABLE_IMAGE << "] Invalid image";
+
+      mpLog->Log( tmp.str(), eDB2_STATUS_WARNING );
+
+      delete pImageFile;
+      return false;
+   }
+
+   // An image left over from other database text would silently
+   // override the embedded tables
+   if ( (bCheckSource == true)
+   &&   (image.GetSourceHash() != HashTextTables()) )
+   {
+      std::ostringstream tmp;
+      tmp << "DB [" << DB2_TABLE_IMAGE << "] Image is out of date";
+
+      mpLog->Log( tmp.str(), eDB2_STATUS_WARNING );
+
+      delete pImageFile;
+      return false;
+   }
+
+   // From here on the image owns the table strings
+   mpImageFile = pImageFile;
+   mSourceHash = image.GetSourceHash();
+
+   bool bRC = true;
+   bRC &= LoadDB2Table <sDB2ImageEnum>( image,
+                                        eDB2_IMAGE_TABLE_ENUM,
+                                        mEnumNameMap,
+                                        DB2_TABLE_ENUM_MAIN,
+                                        *mpLog );
+
+   bRC &= LoadDB2Table <sDB2ImageEnumEntry>( image,
+                                             eDB2_IMAGE_TABLE_ENUM_ENTRY,
+                                             mEnumEntryMap,
+                                             DB2_TABLE_ENUM_ENTRY,
+                                             *mpLog );
+
+   bRC &= LoadDB2Table <sDB2ImageField>( image,
+                                         eDB2_IMAGE_TABLE_FIELD,
+                                         mEntityFields,
+                                         DB2_TABLE_PROTOCOL_FIELD,
+                                         *mpLog );
+
+   bRC &= LoadDB2Table <sDB2ImageFragment>( image,
+                                            eDB2_IMAGE_TABLE_STRUCT,
+                                            mEntityStructs,
+                                            DB2_TABLE_PROTOCOL_STRUCT,
+                                            *mpLog );
+
+   bRC &= LoadDB2Table <sDB2ImageEntity>( image,
+                                          eDB2_IMAGE_TABLE_ENTITY,
+                                          mProtocolEntities,
+                                          DB2_TABLE_PROTOCOL_ENTITY,
+                                          *mpLog );
+
+   // Protocol entity names were sorted when the image was compiled
+   ULONG names = image.GetCount( eDB2_IMAGE_TABLE_ENTITY_NAME );
+   for (ULONG n = 0; n < names; n++)
+   {
+      UINT index = 0;
+      image.GetRecord( eDB2_IMAGE_TABLE_ENTITY_NAME, n, index );
+
+      sDB2ImageEntity rec;
+      image.GetRecord( eDB2_IMAGE_TABLE_ENTITY, index, rec );
+
+      std::vector <ULONG> key;
+      key.reserve( rec.mIDCount );
+      for (UINT i = 0; i < rec.mIDCount; i++)
+      {
+         key.push_back( image.GetEntityID( rec.mIDOffset + i ) );
+      }
+
+      LPCSTR pName = image.GetString( rec.mName );
+      mEntityNames.insert( mEntityNames.end(), std::make_pair( pName, key ) );
+   }
+
+   bRC &= AssembleEnumMap();
+   bRC &= BuildModifierTables();
+
+   BuildIndexes();
+
+   if (bRC == false)
+   {
+      Exit();
+   }
+
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   BuildIndexes (Internal Method)
+
+DESCRIPTION:
+   Build the flat lookup indexes over the loaded tables, these back the
+   public lookup methods (the tables themselves are left as they are)
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void cCoreDatabase::BuildIndexes()
+{
+   // Protocol entities, by key
+   mEntityList.reserve( mProtocolEntities.size() );
+   mEntityNavList.assign( mProtocolEntities.size(), (cDB2NavTree *)0 );
+
+   tDB2EntityMap::const_iterator pEntity = mProtocolEntities.begin();
+   while (pEntity != mProtocolEntities.end())
+   {
+      ULONG index = (ULONG)mEntityList.size();
+      mEntityList.push_back( &pEntity->second );
+
+      ULONGLONG packed = 0;
+      if (PackEntityKey( pEntity->first, packed ) == true)
+      {
+         mEntityIndex.Add( packed, index );
+      }
+      else
+      {
+         mbUnpackedEntityKeys = true;
+      }
+
+      pEntity++;
+   }
+
+   mEntityIndex.Sort();
+
+   // Protocol entities, by name
+   tDB2EntityNameMap::const_iterator pName = mEntityNames.begin();
+   while (pName != mEntityNames.end())
+   {
+      ULONG index = FindEntityIndex( pName->second );
+      if (index != DB2_INDEX_NOT_FOUND)
+      {
+         mEntityNameIndex.Add( pName->first, index );
+      }
+
+      pName++;
+   }
+
+   mEntityNameIndex.Build();
+
+   // Enum entries, by enum ID/value (entries with an ID too large to
+   // pack are looked up in the enum entry table)
+   tDB2EnumEntryMap::const_iterator pEntry = mEnumEntryMap.begin();
+   while (pEntry != mEnumEntryMap.end())
+   {
+      ULONGLONG packed = 0;
+      if (PackEnumEntryKey( pEntry->first.first,
+                            pEntry->first.second,
+                            packed ) == true)
+      {
+         mEnumEntryIndex.Add( packed, (ULONG)mEnumEntryNames.size() );
+         mEnumEntryNames.push_back( pEntry->second.mpName );
+      }
+
+      pEntry++;
+   }
+
+   mEnumEntryIndex.Sort();
+
+   // Enum IDs, by name
+   tDB2EnumMap::const_iterator pEnum = mEnumMap.begin();
+   while (pEnum != mEnumMap.end())
+   {
+      mEnumIndex.Add( pEnum->first, pEnum->second.first );
+      pEnum++;
+   }
+
+   mEnumIndex.Build();
+}
+
+/*===========================================================================
+METHOD:
+   FindEntityIndex (Internal Method)
+
+DESCRIPTION:
+   Find the index (into the flat entity list) of the protocol entity
+   with the specified key
+  
+PARAMETERS:
+   key         [ I ] - Protocol entity key to find
+
+RETURN VALUE:
+   ULONG - The index (DB2_INDEX_NOT_FOUND if not found)
+===========================================================================*/
+ULONG cCoreDatabase::FindEntityIndex( const std::vector <ULONG> & key ) const
+{
+   ULONGLONG packed = 0;
+   if (PackEntityKey( key, packed ) == true)
+   {
+      return mEntityIndex.Find( packed );
+   }
+
+   if (mbUnpackedEntityKeys == false)
+   {
+      return DB2_INDEX_NOT_FOUND;
+   }
+
+   // The entity list is in key order
+   std::vector <const sDB2ProtocolEntity *>::const_iterator pIter;
+   pIter = std::lower_bound( mEntityList.begin(),
+                             mEntityList.end(),
+                             key,
+                             sDB2EntityKeyCmp() );
+
+   if (pIter == mEntityList.end() || (*pIter)->mID != key)
+   {
+      return DB2_INDEX_NOT_FOUND;
+   }
+
+   return (ULONG)(pIter - mEntityList.begin());
+}
+
+/*===========================================================================
+METHOD:
+   FindEnumEntryName (Internal Method)
+
+DESCRIPTION:
+   Find the name of the enum entry with the specified enum ID/value
+  
+PARAMETERS:
+   enumID      [ I ] - ID of the enumeration
+   enumVal     [ I ] - Enum value
+
+RETURN VALUE:
+   LPCSTR - The enum entry name (0 if not found)
+===========================================================================*/
+LPCSTR cCoreDatabase::FindEnumEntryName(
+   ULONG                      enumID,
+   int                        enumVal ) const
+{
+   ULONGLONG packed = 0;
+   if (PackEnumEntryKey( enumID, enumVal, packed ) == true)
+   {
+      ULONG index = mEnumEntryIndex.Find( packed );
+      if (index == DB2_INDEX_NOT_FOUND)
+      {
+         return 0;
+      }
+
+      return mEnumEntryNames[index];
+   }
+
+   std::pair <ULONG, int> key( enumID, enumVal );
+
+   tDB2EnumEntryMap::const_iterator pEntry = mEnumEntryMap.find( key );
+   if (pEntry == mEnumEntryMap.end())
+   {
+      return 0;
+   }
+
+   return pEntry->second.mpName;
+}
+
 /*===========================================================================
 METHOD:
    AssembleEnumMap (Internal Method)
@@ -2615,6 +3666,99 @@ bool cCoreDatabase::LoadEnumTables()
    return bRC;
 }
 
+/*===========================================================================
+METHOD:
+   HashTextTables (Internal Method)
+
+DESCRIPTION:
+   Hash all database text tables found in the given directory (as 
+   recorded in compiled database images)
+  
+PARAMETERS
+   pBasePath   [ I ] - Base path to database files
+   hash        [ O ] - Hash of the database text tables
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cCoreDatabase::HashTextTables( 
+   LPCSTR                     pBasePath,
+   UINT &                     hash ) const
+{
+   std::string basePath = CheckAndSetBasePath( pBasePath );
+   basePath += "/";
+
+   // Same order as the embedded tables
+   LPCSTR pFiles[] = 
+   {
+      DB2_FILE_PROTOCOL_FIELD,
+      DB2_FILE_PROTOCOL_STRUCT,
+      DB2_FILE_PROTOCOL_ENTITY,
+      DB2_FILE_ENUM_MAIN,
+      DB2_FILE_ENUM_ENTRY
+   };
+
+   hash = DB2_IMAGE_HASH_SEED;
+   for (ULONG f = 0; f < (ULONG)(sizeof( pFiles ) / sizeof( pFiles[0] )); f++)
+   {
+      std::string fn = basePath;
+      fn += pFiles[f];
+
+      cMemoryMappedFile file( fn.c_str() );
+      if (file.GetStatus() != NO_ERROR)
+      {
+         return false;
+      }
+
+      hash = HashTextTable( hash, file.GetContents(), file.GetSize() );
+   }
+
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   HashTextTables (Internal Method)
+
+DESCRIPTION:
+   Hash all embedded database text tables (as recorded in compiled 
+   database images)
+  
+RETURN VALUE:
+   UINT
+===========================================================================*/
+UINT cCoreDatabase::HashTextTables() const
+{
+   UINT hash = DB2_IMAGE_HASH_SEED;
+
+   hash = HashTextTable( hash,
+                         &_binary_QMI_Field_txt_start,
+                         (const char*)&_binary_QMI_Field_txt_end - 
+                            (const char*)&_binary_QMI_Field_txt_start );
+
+   hash = HashTextTable( hash,
+                         &_binary_QMI_Struct_txt_start,
+                         (const char*)&_binary_QMI_Struct_txt_end - 
+                            (const char*)&_binary_QMI_Struct_txt_start );
+
+   hash = HashTextTable( hash,
+                         &_binary_QMI_Entity_txt_start,
+                         (const char*)&_binary_QMI_Entity_txt_end - 
+                            (const char*)&_binary_QMI_Entity_txt_start );
+
+   hash = HashTextTable( hash,
+                         &_binary_QMI_Enum_txt_start,
+                         (const char*)&_binary_QMI_Enum_txt_end - 
+                            (const char*)&_binary_QMI_Enum_txt_start );
+
+   hash = HashTextTable( hash,
+                         &_binary_QMI_EnumEntry_txt_start,
+                         (const char*)&_binary_QMI_EnumEntry_txt_end - 
+                            (const char*)&_binary_QMI_EnumEntry_txt_start );
+
+   return hash;
+}
+
 /*===========================================================================
 METHOD:
    ValidateStructures (Internal Method)
@@ -52,11 +52,14 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include "DB2TextFile.h"
+#include "DB2Image.h"
+#include "DB2Index.h"
 
 //---------------------------------------------------------------------------
 // Forward Declarations
 //---------------------------------------------------------------------------
 class cDB2NavTree;
+class cMemoryMappedFile;
 
 //---------------------------------------------------------------------------
 // Prototypes 
@@ -66,6 +69,13 @@ class cDB2NavTree;
 // an allocated buffer
 LPCSTR CopyQuotedString( LPSTR pString );
 
+// Continue a running compiled database image hash over a database text
+// table
+UINT HashTextTable( 
+   UINT                       hash,
+   LPCVOID                    pTable,
+   ULONG                      tableSz );
+
 //---------------------------------------------------------------------------
 // Definitions
 //---------------------------------------------------------------------------
@@ -86,6 +96,9 @@ extern LPCSTR DB2_FILE_PROTOCOL_ENTITY;
 extern LPCSTR DB2_FILE_ENUM_MAIN;
 extern LPCSTR DB2_FILE_ENUM_ENTRY;
 
+// Compiled database image file
+extern LPCSTR DB2_FILE_IMAGE;
+
 // Database start pointers
 extern const int _binary_QMI_Field_txt_start;
 extern const int _binary_QMI_Struct_txt_start;
@@ -462,6 +475,68 @@ bool LoadDB2Table(
    return bRC;
 };
 
+/*===========================================================================
+METHOD:
+   LoadDB2Table (Free Public Method)
+
+DESCRIPTION:
+   Load a database table from a compiled database image, the strings of
+   the resulting objects point into the image
+  
+PARAMETERS:   
+   image          [ I ] - Compiled database image
+   table          [ I ] - Image table to load
+   cont           [I/0] - The current/resulting database table
+   pName          [ I ] - Name (for error reporting)
+   log            [I/O] - Where to log errors
+   
+RETURN VALUE:
+   bool
+===========================================================================*/
+template <class Record, class Container>
+bool LoadDB2Table( 
+   const cDB2Image &          image,
+   eDB2ImageTable             table,
+   Container &                cont,
+   LPCSTR                     pName = 0,
+   cDB2StatusLog &            log = gDB2DefaultLog )
+{
+   // Assume success
+   bool bRC = true;
+
+   // Sanity check error reporting name
+   if (pName == 0 || pName[0] == 0)
+   {
+      pName = "?";
+   }
+
+   ULONG count = image.GetCount( table );
+   for (ULONG r = 0; r < count; r++)
+   {
+      Record rec;
+      image.GetRecord( table, r, rec );
+
+      typename Container::mapped_type theType;
+      bool bOK = theType.FromImage( image, rec );
+      if (bOK == true)
+      {
+         // Records are stored in key order, so they always go at the end
+         typename Container::value_type entry( theType.GetKey(), theType );
+         cont.insert( cont.end(), entry );
+      }
+      else
+      {
+         std::ostringstream tmp;
+         tmp << "DB [" << pName << "] Invalid image record " << r;
+
+         log.Log( tmp.str(), eDB2_STATUS_ERROR );
+         bRC = false;
+      }
+   }
+
+   return bRC;
+};
+
 /*===========================================================================
 METHOD:
    FreeDB2Table (Free Public Method)
@@ -1155,6 +1230,17 @@ struct sDB2ProtocolEntity
       // Populate this object from a string
       bool FromString( LPSTR pStr );
 
+      // Populate this object from a compiled database image record
+      bool FromImage( 
+         const cDB2Image &          image,
+         const sDB2ImageEntity &    rec );
+
+      // Convert this object to a compiled database image record
+      void ToImage( 
+         std::vector <UINT> &       ids,
+         cDB2ImageStringPool &      strings,
+         sDB2ImageEntity &          rec ) const;
+
       // Is this object valid?
       bool IsValid() const;
 
@@ -1226,6 +1312,16 @@ struct sDB2Fragment
       // Populate this object from a string
       bool FromString( LPSTR pStr );
 
+      // Populate this object from a compiled database image record
+      bool FromImage( 
+         const cDB2Image &          image,
+         const sDB2ImageFragment &  rec );
+
+      // Convert this object to a compiled database image record
+      void ToImage( 
+         cDB2ImageStringPool &      strings,
+         sDB2ImageFragment &        rec ) const;
+
       // Is this object valid?
       bool IsValid() const;
 
@@ -1336,6 +1432,16 @@ struct sDB2Field
 
       // Populate this object from a string
       bool FromString( LPSTR pStr );
+
+      // Populate this object from a compiled database image record
+      bool FromImage( 
+         const cDB2Image &          image,
+         const sDB2ImageField &     rec );
+
+      // Convert this object to a compiled database image record
+      void ToImage( 
+         cDB2ImageStringPool &      strings,
+         sDB2ImageField &           rec ) const;
  
       // Is this object valid?
       bool IsValid() const;
@@ -1648,6 +1754,16 @@ struct sDB2Enum
       // Populate this object from a string
       bool FromString( LPSTR pStr );
 
+      // Populate this object from a compiled database image record
+      bool FromImage( 
+         const cDB2Image &          image,
+         const sDB2ImageEnum &      rec );
+
+      // Convert this object to a compiled database image record
+      void ToImage( 
+         cDB2ImageStringPool &      strings,
+         sDB2ImageEnum &            rec ) const;
+
       // Is this object valid?
       bool IsValid() const;
 
@@ -1701,6 +1817,16 @@ struct sDB2EnumEntry
       // (Inline) Populate this object from a string
       bool FromString( LPSTR pStr );
 
+      // Populate this object from a compiled database image record
+      bool FromImage( 
+         const cDB2Image &          image,
+         const sDB2ImageEnumEntry & rec );
+
+      // Convert this object to a compiled database image record
+      void ToImage( 
+         cDB2ImageStringPool &      strings,
+         sDB2ImageEnumEntry &       rec ) const;
+
       // Is this object valid?
       bool IsValid() const;
 
@@ -1918,14 +2044,26 @@ class cCoreDatabase
       virtual bool Initialize( LPCSTR pBasePath );
       virtual bool Initialize();
 
+      // Initialize the database from a compiled database image file, the
+      // file is memory mapped and used for the lifetime of the database
+      virtual bool InitializeFromImage( LPCSTR pImageFile );
+
+      // Save the database as a compiled database image file
+      bool SaveImage( LPCSTR pImageFile ) const;
+
       // Exit (cleanup) the database
       virtual void Exit();
 
       // Get the entity navigation tree for the given protocol entity, if
-      // none exists one will be built and returned
+      // none exists one will be built and returned (thread safe)
       const cDB2NavTree * GetEntityNavTree( 
          const std::vector <ULONG> &   key ) const;
 
+      // Build the navigation trees of all protocol entities up front, so
+      // that GetEntityNavTree() neither builds nor locks (call before the
+      // database is shared between threads)
+      bool BuildNavTrees();
+
       // Find the protocol entity with the specified key
       bool FindEntity( 
          const std::vector <ULONG> &   key,
@@ -2036,6 +2174,23 @@ class cCoreDatabase
       };
 
    protected:
+      // Load all tables from a compiled database image
+      bool LoadImage( 
+         cMemoryMappedFile *        pImageFile,
+         bool                       bCheckSource );
+
+      // Build the flat lookup indexes over the loaded tables
+      void BuildIndexes();
+
+      // Find the index (into the flat entity list) of the protocol
+      // entity with the specified key
+      ULONG FindEntityIndex( const std::vector <ULONG> & key ) const;
+
+      // Find the name of the enum entry with the specified enum ID/value
+      LPCSTR FindEnumEntryName(
+         ULONG                      enumID,
+         int                        enumVal ) const;
+
       // Assemble the internal enum map
       bool AssembleEnumMap();
 
@@ -2056,6 +2211,12 @@ class cCoreDatabase
       bool LoadEnumTables( LPCSTR pBasePath );
       bool LoadEnumTables();
 
+      // Hash all database text tables
+      bool HashTextTables( 
+         LPCSTR                     pBasePath,
+         UINT &                     hash ) const;
+      UINT HashTextTables() const;
+
       // Validate (and attempt repair of) structure related tables
       bool ValidateStructures();
 
@@ -2089,15 +2250,18 @@ class cCoreDatabase
       /* Status log */
       cDB2StatusLog * mpLog;
 
+      /* Compiled database image the tables were loaded from (if any) */
+      cMemoryMappedFile * mpImageFile;
+
+      /* Hash of the database text tables the tables were loaded from */
+      UINT mSourceHash;
+
       /* Protocol entity table, referenced by multi-value key */
       tDB2EntityMap mProtocolEntities;
 
       /* Protocol entity keys, referenced by indexed by entity name */
       tDB2EntityNameMap mEntityNames;
 
-      /* The on-demand Protocol entity navigation map */
-      mutable tDB2EntityNavMap mEntityNavMap;
-
       /* Protocol entity struct table, indexed by struct ID & fragment order */
       tDB2FragmentMap mEntityStructs;
 
@@ -2124,4 +2288,32 @@ class cCoreDatabase
 
       /* Parsed fragment modifier map - start/stop index specified arrays */
       tDB2Array2ModMap mArray2ModMap;
+
+      /* Protocol entities (in key order) referenced by the flat indexes */
+      std::vector <const sDB2ProtocolEntity *> mEntityList;
+
+      /* The on-demand navigation trees, parallel to the entity list */
+      mutable std::vector <cDB2NavTree *> mEntityNavList;
+
+      /* Navigation tree lock (guards on-demand building) */
+      mutable pthread_rwlock_t mNavTreeLock;
+
+      /* Have all navigation trees been built? */
+      bool mbNavTreesBuilt;
+
+      /* Entity list index, indexed by packed protocol entity key */
+      sDB2PackedIndex mEntityIndex;
+
+      /* Are there protocol entities whose key cannot be packed? */
+      bool mbUnpackedEntityKeys;
+
+      /* Entity list index, indexed by protocol entity name */
+      cDB2NameIndex mEntityNameIndex;
+
+      /* Enum entry names, indexed by packed enum ID/value pair */
+      std::vector <LPCSTR> mEnumEntryNames;
+      sDB2PackedIndex mEnumEntryIndex;
+
+      /* Enum ID, indexed by enum name */
+      cDB2NameIndex mEnumIndex;
 };
@@ -0,0 +1,398 @@
+/*===========================================================================
+FILE:
+   DB2Image.cpp
+
+DESCRIPTION:
+   Implementation of the cDB2Image and cDB2ImageStringPool classes
+
+PUBLIC CLASSES AND METHODS:
+   cDB2Image
+      The cDB2Image class validates a compiled database image held in
+      memory (typically a memory mapped file) and provides read only
+      access to the tables and string pool contained therein
+
+   cDB2ImageStringPool
+      The cDB2ImageStringPool class builds the string pool of a compiled
+      database image, folding duplicate strings into a single entry
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//-----------------------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "CoreDatabase.h"
+
+//-----------------------------------------------------------------------------
+// Definitions
+//-----------------------------------------------------------------------------
+
+// Expected record size of each image table
+const UINT DB2_IMAGE_RECORD_SIZE[eDB2_IMAGE_TABLE_ENUM_END] =
+{
+   sizeof( sDB2ImageEntity ),
+   sizeof( UINT ),
+   sizeof( UINT ),
+   sizeof( sDB2ImageFragment ),
+   sizeof( sDB2ImageField ),
+   sizeof( sDB2ImageEnum ),
+   sizeof( sDB2ImageEnumEntry ),
+   sizeof( CHAR )
+};
+
+/*=========================================================================*/
+// Free Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   DB2ImageHash (Free Method)
+
+DESCRIPTION:
+   Continue a running compiled database image hash (32-bit FNV-1a, start
+   with DB2_IMAGE_HASH_SEED) over the given data, any single changed byte
+   always changes the result
+
+PARAMETERS
+   hash        [ I ] - Running hash
+   pBuf        [ I ] - Data to hash
+   len         [ I ] - Length of data
+
+RETURN VALUE:
+   UINT - Updated hash
+===========================================================================*/
+UINT DB2ImageHash( 
+   UINT                       hash,
+   const BYTE *               pBuf, 
+   ULONG                      len )
+{
+   for (ULONG i = 0; i < len; i++)
+   {
+      hash ^= pBuf[i];
+      hash *= 0x01000193;
+   }
+
+   return hash;
+}
+
+/*=========================================================================*/
+// cDB2Image Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cDB2Image (Public Method)
+
+DESCRIPTION:
+   Construct object/validate the image, the buffer must exist for the
+   lifetime of this object (and of any strings obtained from it)
+
+PARAMETERS
+   pBuffer     [ I ] - Image contents
+   bufferLen   [ I ] - Image size
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cDB2Image::cDB2Image(
+   LPCVOID                    pBuffer,
+   ULONG                      bufferLen )
+   :  mpBuffer( (const BYTE *)pBuffer ),
+      mpStrings( 0 ),
+      mbValid( false )
+{
+   memset( (LPVOID)&mHeader, 0, sizeof( mHeader ) );
+
+   if (pBuffer == 0 || bufferLen < sizeof( mHeader ))
+   {
+      return;
+   }
+
+   memcpy( (LPVOID)&mHeader, pBuffer, sizeof( mHeader ) );
+   if ( (mHeader.mMagic != DB2_IMAGE_MAGIC)
+   ||   (mHeader.mVersion != DB2_IMAGE_VERSION)
+   ||   (mHeader.mSize != bufferLen) )
+   {
+      return;
+   }
+
+   // The tables follow the header back to back (in table order) and
+   // fill the remainder of the image
+   ULONGLONG end = sizeof( mHeader );
+   for (ULONG t = 0; t < (ULONG)eDB2_IMAGE_TABLE_ENUM_END; t++)
+   {
+      const sDB2ImageTable & table = mHeader.mTables[t];
+      if ( (table.mRecordSize != DB2_IMAGE_RECORD_SIZE[t])
+      ||   (table.mOffset != end) )
+      {
+         return;
+      }
+
+      end += (ULONGLONG)table.mCount * (ULONGLONG)table.mRecordSize;
+   }
+
+   if (end != (ULONGLONG)bufferLen)
+   {
+      return;
+   }
+
+   // Reject images that were corrupted after being compiled
+   UINT checksum = DB2ImageHash( DB2_IMAGE_HASH_SEED,
+                                 mpBuffer + sizeof( mHeader ),
+                                 bufferLen - sizeof( mHeader ) );
+
+   if (checksum != mHeader.mChecksum)
+   {
+      return;
+   }
+
+   // The string pool starts with the empty string and is terminated
+   const sDB2ImageTable & strings = mHeader.mTables[eDB2_IMAGE_TABLE_STRINGS];
+   mpStrings = (LPCSTR)mpBuffer + strings.mOffset;
+   if ( (strings.mCount == 0)
+   ||   (mpStrings[0] != 0)
+   ||   (mpStrings[strings.mCount - 1] != 0) )
+   {
+      return;
+   }
+
+   mbValid = ValidateRecords();
+}
+
+/*===========================================================================
+METHOD:
+   GetEntityID (Public Method)
+
+DESCRIPTION:
+   Return the protocol entity ID value at the given index
+
+PARAMETERS
+   index       [ I ] - Index into protocol entity ID table
+
+RETURN VALUE:
+   ULONG
+===========================================================================*/
+ULONG cDB2Image::GetEntityID( ULONG index ) const
+{
+   UINT id = 0;
+   GetRecord( eDB2_IMAGE_TABLE_ENTITY_ID, index, id );
+   return (ULONG)id;
+}
+
+/*===========================================================================
+METHOD:
+   GetString (Public Method)
+
+DESCRIPTION:
+   Return the string at the given string pool offset, the empty string
+   is always returned as EMPTY_STRING (as it is when loading text)
+
+PARAMETERS
+   offset      [ I ] - String pool offset
+
+RETURN VALUE:
+   LPCSTR
+===========================================================================*/
+LPCSTR cDB2Image::GetString( UINT offset ) const
+{
+   LPCSTR pStr = mpStrings + offset;
+   if (pStr[0] == 0)
+   {
+      pStr = EMPTY_STRING;
+   }
+
+   return pStr;
+}
+
+/*===========================================================================
+METHOD:
+   ValidateRecords (Internal Method)
+
+DESCRIPTION:
+   Validate the records of all tables, i.e. check that every string,
+   protocol entity ID and protocol entity reference lies within the image
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDB2Image::ValidateRecords() const
+{
+   ULONG ids = GetCount( eDB2_IMAGE_TABLE_ENTITY_ID );
+
+   ULONG count = GetCount( eDB2_IMAGE_TABLE_ENTITY );
+   for (ULONG r = 0; r < count; r++)
+   {
+      sDB2ImageEntity rec;
+      GetRecord( eDB2_IMAGE_TABLE_ENTITY, r, rec );
+
+      if ( (rec.mIDOffset > ids)
+      ||   (rec.mIDCount > ids - rec.mIDOffset)
+      ||   (ValidateString( rec.mName ) == false) )
+      {
+         return false;
+      }
+   }
+
+   ULONG entities = count;
+   count = GetCount( eDB2_IMAGE_TABLE_ENTITY_NAME );
+   for (ULONG r = 0; r < count; r++)
+   {
+      UINT index = 0;
+      GetRecord( eDB2_IMAGE_TABLE_ENTITY_NAME, r, index );
+
+      if (index >= entities)
+      {
+         return false;
+      }
+   }
+
+   count = GetCount( eDB2_IMAGE_TABLE_STRUCT );
+   for (ULONG r = 0; r < count; r++)
+   {
+      sDB2ImageFragment rec;
+      GetRecord( eDB2_IMAGE_TABLE_STRUCT, r, rec );
+
+      if ( (ValidateString( rec.mModifierValue ) == false)
+      ||   (ValidateString( rec.mName ) == false) )
+      {
+         return false;
+      }
+   }
+
+   count = GetCount( eDB2_IMAGE_TABLE_FIELD );
+   for (ULONG r = 0; r < count; r++)
+   {
+      sDB2ImageField rec;
+      GetRecord( eDB2_IMAGE_TABLE_FIELD, r, rec );
+
+      if (ValidateString( rec.mName ) == false)
+      {
+         return false;
+      }
+   }
+
+   count = GetCount( eDB2_IMAGE_TABLE_ENUM );
+   for (ULONG r = 0; r < count; r++)
+   {
+      sDB2ImageEnum rec;
+      GetRecord( eDB2_IMAGE_TABLE_ENUM, r, rec );
+
+      if (ValidateString( rec.mName ) == false)
+      {
+         return false;
+      }
+   }
+
+   count = GetCount( eDB2_IMAGE_TABLE_ENUM_ENTRY );
+   for (ULONG r = 0; r < count; r++)
+   {
+      sDB2ImageEnumEntry rec;
+      GetRecord( eDB2_IMAGE_TABLE_ENUM_ENTRY, r, rec );
+
+      if (ValidateString( rec.mName ) == false)
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   ValidateString (Internal Method)
+
+DESCRIPTION:
+   Validate a string pool offset (the pool itself is known to be
+   terminated, so any offset inside of it yields a valid string)
+
+PARAMETERS
+   offset      [ I ] - String pool offset
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDB2Image::ValidateString( UINT offset ) const
+{
+   return (offset < mHeader.mTables[eDB2_IMAGE_TABLE_STRINGS].mCount);
+}
+
+/*=========================================================================*/
+// cDB2ImageStringPool Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cDB2ImageStringPool (Public Method)
+
+DESCRIPTION:
+   Constructor, the pool always starts with the empty string (offset 0)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cDB2ImageStringPool::cDB2ImageStringPool()
+   :  mPool( 1, 0 )
+{
+   mOffsets[""] = 0;
+}
+
+/*===========================================================================
+METHOD:
+   Add (Public Method)
+
+DESCRIPTION:
+   Add a string to the pool, returning the string pool offset
+
+PARAMETERS
+   pStr        [ I ] - String to add (0 is treated as the empty string)
+
+RETURN VALUE:
+   UINT - String pool offset
+===========================================================================*/
+UINT cDB2ImageStringPool::Add( LPCSTR pStr )
+{
+   if (pStr == 0 || pStr[0] == 0)
+   {
+      return 0;
+   }
+
+   std::string str( pStr );
+   std::map <std::string, UINT>::const_iterator pIter = mOffsets.find( str );
+   if (pIter != mOffsets.end())
+   {
+      return pIter->second;
+   }
+
+   UINT offset = (UINT)mPool.size();
+   mPool.append( str.c_str(), str.size() + 1 );
+
+   mOffsets[str] = offset;
+   return offset;
+}
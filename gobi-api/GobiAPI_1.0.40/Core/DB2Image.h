@@ -0,0 +1,323 @@
+/*===========================================================================
+FILE:
+   DB2Image.h
+
+DESCRIPTION:
+   Declaration of the compiled (binary) database image format and the
+   cDB2Image class
+
+PUBLIC CLASSES AND METHODS:
+   cDB2Image
+      The cDB2Image class validates a compiled database image held in
+      memory (typically a memory mapped file) and provides read only
+      access to the tables and string pool contained therein
+
+   cDB2ImageStringPool
+      The cDB2ImageStringPool class builds the string pool of a compiled
+      database image, folding duplicate strings into a single entry
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Pragmas
+//---------------------------------------------------------------------------
+#pragma once
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include <map>
+#include <string>
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Compiled database image signature ('DB2I')
+const UINT DB2_IMAGE_MAGIC = 0x49324244;
+
+// Compiled database image format version, bump on any layout change
+const UINT DB2_IMAGE_VERSION = 2;
+
+// Initial value of a compiled database image hash (32-bit FNV-1a)
+const UINT DB2_IMAGE_HASH_SEED = 0x811C9DC5;
+
+/*=========================================================================*/
+// eDB2ImageTable Enumeration
+//
+//    Tables contained in a compiled database image
+/*=========================================================================*/
+enum eDB2ImageTable
+{
+   eDB2_IMAGE_TABLE_ENUM_BEGIN = -1,
+
+   eDB2_IMAGE_TABLE_ENTITY,      // 0  Protocol entities (sDB2ImageEntity)
+   eDB2_IMAGE_TABLE_ENTITY_ID,   // 1  Protocol entity ID values (UINT)
+   eDB2_IMAGE_TABLE_ENTITY_NAME, // 2  Protocol entity indices, name order (UINT)
+   eDB2_IMAGE_TABLE_STRUCT,      // 3  Protocol fragments (sDB2ImageFragment)
+   eDB2_IMAGE_TABLE_FIELD,       // 4  Protocol fields (sDB2ImageField)
+   eDB2_IMAGE_TABLE_ENUM,        // 5  Enums (sDB2ImageEnum)
+   eDB2_IMAGE_TABLE_ENUM_ENTRY,  // 6  Enum entries (sDB2ImageEnumEntry)
+   eDB2_IMAGE_TABLE_STRINGS,     // 7  String pool (CHAR)
+
+   eDB2_IMAGE_TABLE_ENUM_END
+};
+
+// Expected record size of each image table
+extern const UINT DB2_IMAGE_RECORD_SIZE[eDB2_IMAGE_TABLE_ENUM_END];
+
+/*=========================================================================*/
+// Prototypes
+/*=========================================================================*/
+
+// Continue a running compiled database image hash over the given data
+UINT DB2ImageHash( 
+   UINT                       hash,
+   const BYTE *               pBuf, 
+   ULONG                      len );
+
+/*=========================================================================*/
+// Struct sDB2ImageTable
+//
+//    Location of a table within a compiled database image
+/*=========================================================================*/
+struct sDB2ImageTable
+{
+   /* Offset (in bytes) of the table from the start of the image */
+   UINT mOffset;
+
+   /* Number of records in the table */
+   UINT mCount;
+
+   /* Size (in bytes) of a single record */
+   UINT mRecordSize;
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageHeader
+//
+//    Header found at the start of every compiled database image, the
+//    image only contains offsets so it can be mapped at any address
+/*=========================================================================*/
+struct sDB2ImageHeader
+{
+   /* Image signature (DB2_IMAGE_MAGIC, also detects byte order) */
+   UINT mMagic;
+
+   /* Image format version (DB2_IMAGE_VERSION) */
+   UINT mVersion;
+
+   /* Total size (in bytes) of the image */
+   UINT mSize;
+
+   /* Hash of the database text tables the image was compiled from */
+   UINT mSourceHash;
+
+   /* Hash of the image contents following the header */
+   UINT mChecksum;
+
+   /* Table locations */
+   sDB2ImageTable mTables[eDB2_IMAGE_TABLE_ENUM_END];
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageEntity
+//
+//    Compiled protocol entity record (see sDB2ProtocolEntity), strings are offsets into the
+//    string pool and ID values are found in the entity ID table
+/*=========================================================================*/
+struct sDB2ImageEntity
+{
+   UINT mType;
+   UINT mIDOffset;
+   UINT mIDCount;
+   INT mStructID;
+   INT mFormatID;
+   INT mFormatExID;
+   UINT mbInternal;
+   UINT mName;
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageFragment
+//
+//    Compiled protocol structure fragment record (see sDB2Fragment)
+/*=========================================================================*/
+struct sDB2ImageFragment
+{
+   UINT mStructID;
+   UINT mFragmentOrder;
+   INT mFragmentOffset;
+   UINT mFragmentType;
+   UINT mFragmentValue;
+   UINT mModifierType;
+   UINT mModifierValue;
+   UINT mName;
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageField
+//
+//    Compiled protocol field record (see sDB2Field)
+/*=========================================================================*/
+struct sDB2ImageField
+{
+   UINT mID;
+   UINT mSize;
+   UINT mType;
+   UINT mTypeVal;
+   UINT mbHex;
+   UINT mbInternal;
+   INT mDescriptionID;
+   UINT mName;
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageEnum
+//
+//    Compiled enum record (see sDB2Enum)
+/*=========================================================================*/
+struct sDB2ImageEnum
+{
+   UINT mID;
+   UINT mbInternal;
+   INT mDescriptionID;
+   UINT mName;
+};
+
+/*=========================================================================*/
+// Struct sDB2ImageEnumEntry
+//
+//    Compiled enum entry record (see sDB2EnumEntry)
+/*=========================================================================*/
+struct sDB2ImageEnumEntry
+{
+   UINT mID;
+   INT mValue;
+   UINT mbHex;
+   INT mDescriptionID;
+   UINT mName;
+};
+
+/*=========================================================================*/
+// Class cDB2Image
+/*=========================================================================*/
+class cDB2Image
+{
+   public:
+      // Constructor (validates image)
+      cDB2Image(
+         LPCVOID                    pBuffer,
+         ULONG                      bufferLen );
+
+      // (Inline) Is the image valid?
+      bool IsValid() const
+      {
+         return mbValid;
+      };
+
+      // (Inline) Return the hash of the text tables the image was
+      // compiled from
+      UINT GetSourceHash() const
+      {
+         return mHeader.mSourceHash;
+      };
+
+      // (Inline) Return the number of records in the given table
+      ULONG GetCount( eDB2ImageTable table ) const
+      {
+         return mHeader.mTables[table].mCount;
+      };
+
+      // (Inline) Copy out a record of the given table (the image
+      // carries no alignment guarantees, so records are never
+      // accessed in place)
+      template <class Record>
+      void GetRecord(
+         eDB2ImageTable             table,
+         ULONG                      index,
+         Record &                   rec ) const
+      {
+         const BYTE * pRec = mpBuffer + mHeader.mTables[table].mOffset;
+         pRec += index * sizeof( Record );
+
+         memcpy( (LPVOID)&rec, (LPCVOID)pRec, sizeof( Record ) );
+      };
+
+      // Return the protocol entity ID value at the given index
+      ULONG GetEntityID( ULONG index ) const;
+
+      // Return the string at the given string pool offset
+      LPCSTR GetString( UINT offset ) const;
+
+   protected:
+      // Validate the records of all tables
+      bool ValidateRecords() const;
+
+      // Validate a string pool offset
+      bool ValidateString( UINT offset ) const;
+
+      /* Image contents */
+      const BYTE * mpBuffer;
+
+      /* Image header (copy) */
+      sDB2ImageHeader mHeader;
+
+      /* String pool */
+      LPCSTR mpStrings;
+
+      /* Is the image valid? */
+      bool mbValid;
+};
+
+/*=========================================================================*/
+// Class cDB2ImageStringPool
+/*=========================================================================*/
+class cDB2ImageStringPool
+{
+   public:
+      // Constructor
+      cDB2ImageStringPool();
+
+      // Add a string to the pool, returning the string pool offset
+      UINT Add( LPCSTR pStr );
+
+      // (Inline) Return the string pool contents
+      const std::string & GetContents() const
+      {
+         return mPool;
+      };
+
+   protected:
+      /* String pool contents */
+      std::string mPool;
+
+      /* Offsets of strings already in the pool */
+      std::map <std::string, UINT> mOffsets;
+};
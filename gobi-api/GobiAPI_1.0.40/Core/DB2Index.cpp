@@ -0,0 +1,340 @@
+/*===========================================================================
+FILE:
+   DB2Index.cpp
+
+DESCRIPTION:
+   Implementation of the flat database lookup indexes
+
+PUBLIC CLASSES AND METHODS:
+   sDB2PackedIndex
+      Sorted array of 64-bit packed keys, searched with a binary search
+      over contiguous memory
+
+   cDB2NameIndex
+      Open addressing hash table mapping (optionally case insensitive)
+      names to values
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//-----------------------------------------------------------------------------
+// Include Files
+//-----------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "DB2Index.h"
+
+/*=========================================================================*/
+// sDB2PackedIndex Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   Sort (Public Method)
+
+DESCRIPTION:
+   Sort the keys, when a key was added more than once the first value
+   added is kept (matching std::map::insert() semantics)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void sDB2PackedIndex::Sort()
+{
+   std::stable_sort( mEntries.begin(), mEntries.end() );
+
+   std::vector <sEntry>::iterator pEnd = mEntries.begin();
+   std::vector <sEntry>::iterator pIter = mEntries.begin();
+   while (pIter != mEntries.end())
+   {
+      if (pEnd == mEntries.begin() || (pEnd - 1)->mKey != pIter->mKey)
+      {
+         *pEnd++ = *pIter;
+      }
+
+      pIter++;
+   }
+
+   mEntries.erase( pEnd, mEntries.end() );
+
+   // Release the slack, the index is not modified again until cleared
+   std::vector <sEntry>( mEntries ).swap( mEntries );
+}
+
+/*===========================================================================
+METHOD:
+   Find (Public Method)
+
+DESCRIPTION:
+   Find the value associated with the given key
+
+PARAMETERS:
+   key         [ I ] - Packed key to look up
+
+RETURN VALUE:
+   ULONG - The value (DB2_INDEX_NOT_FOUND if the key is not present)
+===========================================================================*/
+ULONG sDB2PackedIndex::Find( ULONGLONG key ) const
+{
+   std::vector <sEntry>::const_iterator pIter;
+   pIter = std::lower_bound( mEntries.begin(),
+                             mEntries.end(),
+                             sEntry( key, 0 ) );
+
+   if (pIter == mEntries.end() || pIter->mKey != key)
+   {
+      return DB2_INDEX_NOT_FOUND;
+   }
+
+   return pIter->mValue;
+}
+
+/*=========================================================================*/
+// cDB2NameIndex Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cDB2NameIndex (Public Method)
+
+DESCRIPTION:
+   Constructor
+
+PARAMETERS:
+   bCaseInsensitive  [ I ] - Compare names without regard to case?
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cDB2NameIndex::cDB2NameIndex( bool bCaseInsensitive )
+   :  mbCaseInsensitive( bCaseInsensitive ),
+      mMask( 0 )
+{
+   // Nothing to do
+}
+
+/*===========================================================================
+METHOD:
+   Add (Public Method)
+
+DESCRIPTION:
+   Add a name, the name is not copied and must outlive the index
+
+PARAMETERS:
+   pName       [ I ] - Name
+   val         [ I ] - Associated value
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cDB2NameIndex::Add(
+   LPCSTR                     pName,
+   ULONG                      val )
+{
+   if (pName != 0)
+   {
+      mPending.push_back( std::pair <LPCSTR, ULONG>( pName, val ) );
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Build (Public Method)
+
+DESCRIPTION:
+   Build the hash table from all names added, when a name was added more
+   than once the first value added is kept (matching std::map::insert()
+   semantics)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cDB2NameIndex::Build()
+{
+   // Keep the load factor at or below one half
+   ULONG slots = 16;
+   while (slots < mPending.size() * 2)
+   {
+      slots <<= 1;
+   }
+
+   mSlots.assign( slots, sSlot() );
+   mMask = slots - 1;
+
+   for (ULONG n = 0; n < (ULONG)mPending.size(); n++)
+   {
+      LPCSTR pName = mPending[n].first;
+      ULONG nameLen = (ULONG)strlen( pName );
+      ULONG hash = Hash( pName, nameLen );
+
+      ULONG s = hash & mMask;
+      while (mSlots[s].mpName != 0)
+      {
+         const sSlot & slot = mSlots[s];
+         if ( (slot.mHash == hash)
+         &&   (slot.mNameLen == nameLen)
+         &&   (Match( slot.mpName, pName, nameLen ) == true) )
+         {
+            break;
+         }
+
+         s = (s + 1) & mMask;
+      }
+
+      if (mSlots[s].mpName == 0)
+      {
+         sSlot & slot = mSlots[s];
+         slot.mpName = pName;
+         slot.mNameLen = nameLen;
+         slot.mHash = hash;
+         slot.mValue = mPending[n].second;
+      }
+   }
+
+   std::vector < std::pair <LPCSTR, ULONG> >().swap( mPending );
+}
+
+/*===========================================================================
+METHOD:
+   Find (Public Method)
+
+DESCRIPTION:
+   Find the value associated with the given name
+
+PARAMETERS:
+   pName       [ I ] - Name (need not be terminated)
+   nameLen     [ I ] - Length of name
+
+RETURN VALUE:
+   ULONG - The value (DB2_INDEX_NOT_FOUND if the name is not present)
+===========================================================================*/
+ULONG cDB2NameIndex::Find(
+   LPCSTR                     pName,
+   ULONG                      nameLen ) const
+{
+   if (pName == 0 || mSlots.size() == 0)
+   {
+      return DB2_INDEX_NOT_FOUND;
+   }
+
+   ULONG hash = Hash( pName, nameLen );
+
+   ULONG s = hash & mMask;
+   while (mSlots[s].mpName != 0)
+   {
+      const sSlot & slot = mSlots[s];
+      if ( (slot.mHash == hash)
+      &&   (slot.mNameLen == nameLen)
+      &&   (Match( slot.mpName, pName, nameLen ) == true) )
+      {
+         return slot.mValue;
+      }
+
+      s = (s + 1) & mMask;
+   }
+
+   return DB2_INDEX_NOT_FOUND;
+}
+
+/*===========================================================================
+METHOD:
+   Clear (Public Method)
+
+DESCRIPTION:
+   Empty the index
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cDB2NameIndex::Clear()
+{
+   std::vector < std::pair <LPCSTR, ULONG> >().swap( mPending );
+   std::vector <sSlot>().swap( mSlots );
+   mMask = 0;
+}
+
+/*===========================================================================
+METHOD:
+   Hash (Internal Method)
+
+DESCRIPTION:
+   Hash a name (32-bit FNV-1a, folding case when case insensitive)
+
+PARAMETERS:
+   pName       [ I ] - Name
+   nameLen     [ I ] - Length of name
+
+RETURN VALUE:
+   ULONG
+===========================================================================*/
+ULONG cDB2NameIndex::Hash(
+   LPCSTR                     pName,
+   ULONG                      nameLen ) const
+{
+   UINT hash = 2166136261U;
+   for (ULONG c = 0; c < nameLen; c++)
+   {
+      UINT ch = (UINT)(BYTE)pName[c];
+      if (mbCaseInsensitive == true)
+      {
+         ch = (UINT)tolower( (int)ch );
+      }
+
+      hash ^= ch;
+      hash *= 16777619U;
+   }
+
+   return (ULONG)hash;
+}
+
+/*===========================================================================
+METHOD:
+   Match (Internal Method)
+
+DESCRIPTION:
+   Do the two names (both of the given length) match?
+
+PARAMETERS:
+   pNameA      [ I ] - First name
+   pNameB      [ I ] - Second name
+   nameLen     [ I ] - Length of both names
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDB2NameIndex::Match(
+   LPCSTR                     pNameA,
+   LPCSTR                     pNameB,
+   ULONG                      nameLen ) const
+{
+   if (mbCaseInsensitive == false)
+   {
+      return (memcmp( (LPCVOID)pNameA, (LPCVOID)pNameB, nameLen ) == 0);
+   }
+
+   return (strncasecmp( pNameA, pNameB, nameLen ) == 0);
+}
@@ -0,0 +1,191 @@
+/*===========================================================================
+FILE:
+   DB2Index.h
+
+DESCRIPTION:
+   Declaration of the flat database lookup indexes
+
+PUBLIC CLASSES AND METHODS:
+   sDB2PackedIndex
+      Sorted array of 64-bit packed keys, searched with a binary search
+      over contiguous memory
+
+   cDB2NameIndex
+      Open addressing hash table mapping (optionally case insensitive)
+      names to values
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Pragmas
+//---------------------------------------------------------------------------
+#pragma once
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include <vector>
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Value returned by index lookups that fail
+const ULONG DB2_INDEX_NOT_FOUND = ULONG_MAX;
+
+/*=========================================================================*/
+// Struct sDB2PackedIndex
+//
+//    Sorted array of 64-bit packed keys, each key being associated with
+//    a value (typically an index into a parallel array)
+/*=========================================================================*/
+struct sDB2PackedIndex
+{
+   public:
+      // (Inline) Add a key (Sort() must be called before lookups)
+      void Add(
+         ULONGLONG                  key,
+         ULONG                      val )
+      {
+         mEntries.push_back( sEntry( key, val ) );
+      };
+
+      // Sort the keys, the first value added for a key is kept
+      void Sort();
+
+      // Find the value associated with the given key
+      ULONG Find( ULONGLONG key ) const;
+
+      // (Inline) Empty the index
+      void Clear()
+      {
+         mEntries.clear();
+      };
+
+   protected:
+      /* An index entry */
+      struct sEntry
+      {
+         sEntry( ULONGLONG key, ULONG val )
+            :  mKey( key ),
+               mValue( val )
+         { };
+
+         bool operator < ( const sEntry & other ) const
+         {
+            return (mKey < other.mKey);
+         };
+
+         ULONGLONG mKey;
+         ULONG mValue;
+      };
+
+      /* Entries, in key order */
+      std::vector <sEntry> mEntries;
+};
+
+/*=========================================================================*/
+// Class cDB2NameIndex
+//
+//    Open addressing (linear probing) hash table from names to values,
+//    names are not copied and must outlive the index
+/*=========================================================================*/
+class cDB2NameIndex
+{
+   public:
+      // Constructor
+      cDB2NameIndex( bool bCaseInsensitive );
+
+      // Add a name (Build() must be called before lookups)
+      void Add(
+         LPCSTR                     pName,
+         ULONG                      val );
+
+      // Build the hash table, the first value added for a name is kept
+      void Build();
+
+      // Find the value associated with the given name
+      ULONG Find(
+         LPCSTR                     pName,
+         ULONG                      nameLen ) const;
+
+      // (Inline) Find the value associated with the given name
+      ULONG Find( LPCSTR pName ) const
+      {
+         if (pName == 0)
+         {
+            return DB2_INDEX_NOT_FOUND;
+         }
+
+         return Find( pName, (ULONG)strlen( pName ) );
+      };
+
+      // Empty the index
+      void Clear();
+
+   protected:
+      // Hash a name
+      ULONG Hash(
+         LPCSTR                     pName,
+         ULONG                      nameLen ) const;
+
+      // Do the two names match?
+      bool Match(
+         LPCSTR                     pNameA,
+         LPCSTR                     pNameB,
+         ULONG                      nameLen ) const;
+
+      /* A hash table slot */
+      struct sSlot
+      {
+         sSlot()
+            :  mpName( 0 ),
+               mNameLen( 0 ),
+               mHash( 0 ),
+               mValue( DB2_INDEX_NOT_FOUND )
+         { };
+
+         LPCSTR mpName;
+         ULONG mNameLen;
+         ULONG mHash;
+         ULONG mValue;
+      };
+
+      /* Case insensitive names? */
+      bool mbCaseInsensitive;
+
+      /* Names added since the last build, in order */
+      std::vector < std::pair <LPCSTR, ULONG> > mPending;
+
+      /* Hash table (size is a power of two) */
+      std::vector <sSlot> mSlots;
+
+      /* Hash table size - 1 */
+      ULONG mMask;
+};
@@ -7,6 +7,7 @@ DESCRIPTION:
    
 PUBLIC CLASSES AND METHODS:
    sDB2NavFragment
+   sDB2DecodeOp
    cDB2NavTree
       This class distills the database description of a protocol
       entity into a simple tree structure more suited to
@@ -45,11 +46,80 @@ POSSIBILITY OF SUCH DAMAGE.
 //---------------------------------------------------------------------------
 #include "StdAfx.h"
 #include "DB2NavTree.h"
+#include "BitParser.h"
 
 //---------------------------------------------------------------------------
 // Definitions
 //---------------------------------------------------------------------------
 
+// No fragment (while building)
+const ULONG DB2_NAV_NO_FRAGMENT = ULONG_MAX;
+
+/*===========================================================================
+METHOD:
+   GetDecodeBits (Free Method)
+
+DESCRIPTION:
+   Return the maximum number of bits a field can have and still be
+   decoded as a single value (this matches the width of the type used
+   when parsing the field)
+
+PARAMETERS:
+   field       [ I ] - Field to check
+
+RETURN VALUE:
+   ULONG - Maximum number of bits (0 = not decodable as a single value)
+===========================================================================*/
+static ULONG GetDecodeBits( const sDB2Field & field )
+{
+   ULONG bytes = 0;
+
+   switch (field.mType)
+   {
+      case eDB2_FIELD_STD:
+         switch ((eDB2StdFieldType)field.mTypeVal)
+         {
+            case eDB2_FIELD_STDTYPE_BOOL:
+            case eDB2_FIELD_STDTYPE_INT8:
+            case eDB2_FIELD_STDTYPE_UINT8:
+               bytes = (ULONG)sizeof( UCHAR );
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT16:
+            case eDB2_FIELD_STDTYPE_UINT16:
+               bytes = (ULONG)sizeof( USHORT );
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT32:
+            case eDB2_FIELD_STDTYPE_UINT32:
+            case eDB2_FIELD_STDTYPE_FLOAT32:
+               bytes = (ULONG)sizeof( ULONG );
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT64:
+            case eDB2_FIELD_STDTYPE_UINT64:
+            case eDB2_FIELD_STDTYPE_FLOAT64:
+               bytes = (ULONG)sizeof( ULONGLONG );
+               break;
+
+            default:
+               // Strings are not single values
+               break;
+         }
+         break;
+
+      case eDB2_FIELD_ENUM_UNSIGNED:
+      case eDB2_FIELD_ENUM_SIGNED:
+         bytes = (ULONG)sizeof( ULONG );
+         break;
+
+      default:
+         break;
+   }
+
+   return bytes * BITS_PER_BYTE;
+}
+
 /*=========================================================================*/
 // sDB2NavFragment Methods
 /*=========================================================================*/
@@ -73,6 +143,29 @@ sDB2NavFragment::sDB2NavFragment()
    // Nothing to do
 }
 
+/*=========================================================================*/
+// sDB2DecodeOp Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   sDB2DecodeOp (Public Method)
+
+DESCRIPTION:
+   Constructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+sDB2DecodeOp::sDB2DecodeOp()
+   :  mpField( 0 ),
+      mOffset( 0 ),
+      mRequiredBits( 0 ),
+      mbLSB( true )
+{
+   // Nothing to do
+}
+
 /*=========================================================================*/
 // cDB2NavTree Methods
 /*=========================================================================*/
@@ -91,7 +184,9 @@ RETURN VALUE:
    None
 ===========================================================================*/
 cDB2NavTree::cDB2NavTree( const cCoreDatabase & db )
-   :  mDB( db )
+   :  mDB( db ),
+      mbFixedLayout( false ),
+      mFixedBits( 0 )
 {
    // Nothing to do
 }
@@ -108,16 +203,7 @@ RETURN VALUE:
 ===========================================================================*/
 cDB2NavTree::~cDB2NavTree()
 {
-   // Clean-up our fragment allocations
-   std::list <sDB2NavFragment *>::iterator pIter;
-   for (pIter = mFragments.begin(); pIter != mFragments.end(); pIter++)
-   {
-      sDB2NavFragment * pFrag = *pIter;
-      if (pFrag != 0)
-      {
-         delete pFrag;
-      }
-   }
+   // Nothing to do
 }
 
 /*===========================================================================
@@ -176,7 +262,33 @@ bool cDB2NavTree::BuildTree( const std::vector <ULONG> & key )
    }
 
    // Process the initial structure
-   bRC = ProcessStruct( &pFrag->second, 0 );
+   bRC = ProcessStruct( &pFrag->second, DB2_NAV_NO_FRAGMENT );
+
+   // The fragments no longer move, hook them up
+   LinkFragments();
+
+   // Compile the decoding operations (parsers start LSB -> MSB)
+   if (bRC == true && mFragments.size() > 0)
+   {
+      ULONG offset = 0;
+      ULONG requiredBits = 0;
+
+      mbFixedLayout = CompileStruct( &mFragments.front(),
+                                     offset,
+                                     true,
+                                     requiredBits );
+
+      if (mbFixedLayout == true)
+      {
+         std::vector <sDB2DecodeOp>( mDecodeOps ).swap( mDecodeOps );
+         mFixedBits = requiredBits;
+      }
+      else
+      {
+         std::vector <sDB2DecodeOp>().swap( mDecodeOps );
+      }
+   }
+
    return bRC;
 }
 
@@ -189,14 +301,14 @@ DESCRIPTION:
 
 PARAMETERS:
    frag        [ I ] - Entry point for structure
-   pOwner      [ I ] - Owning fragment
+   ownerIndex  [ I ] - Index of owning fragment (DB2_NAV_NO_FRAGMENT = none)
   
 RETURN VALUE:
    bool
 ===========================================================================*/
 bool cDB2NavTree::ProcessStruct( 
    const sDB2Fragment *       pFrag,
-   sDB2NavFragment *          pOwner )
+   ULONG                      ownerIndex )
 {
    // Assume success
    bool bRC = true;
@@ -219,9 +331,10 @@ bool cDB2NavTree::ProcessStruct(
       return bRC;
    }
 
-   // Fragments we allocate along the way
-   sDB2NavFragment * pOld = 0;
-   sDB2NavFragment * pNew = 0;
+   // Fragments we add along the way (as indices, since the fragment
+   // array may be reallocated until the tree is complete)
+   ULONG oldIndex = DB2_NAV_NO_FRAGMENT;
+   ULONG newIndex = DB2_NAV_NO_FRAGMENT;
 
    // Process each fragment in the structure
    while ( (pFragIter != structTable.end())
@@ -229,28 +342,28 @@ bool cDB2NavTree::ProcessStruct(
    {      
       pFrag = &pFragIter->second;
 
-      // Allocate our new fragment
-      pNew = new sDB2NavFragment;
-      if (pNew == 0)
-      {
-         bRC = false;
-         break;
-      }
-      
-      // Store DB fragemnt
-      pNew->mpFragment = pFrag;
-      mFragments.push_back( pNew );
+      // Add our new fragment, storing the DB fragment
+      newIndex = (ULONG)mFragments.size();
+      mFragments.push_back( sDB2NavFragment() );
+      mFragments.back().mpFragment = pFrag;
+
+      std::pair <ULONG, ULONG> noLinks( DB2_NAV_NO_FRAGMENT, 
+                                        DB2_NAV_NO_FRAGMENT );
+
+      mLinks.push_back( noLinks );
 
       // Hook previous up to us
-      if (pOld != 0 && pOld->mpNextFragment == 0)
+      if ( (oldIndex != DB2_NAV_NO_FRAGMENT) 
+      &&   (mLinks[oldIndex].first == DB2_NAV_NO_FRAGMENT) )
       {
-         pOld->mpNextFragment = pNew;
+         mLinks[oldIndex].first = newIndex;
       }
 
       // Hook owner up to us
-      if (pOwner != 0 && pOwner->mpLinkFragment == 0)
+      if ( (ownerIndex != DB2_NAV_NO_FRAGMENT) 
+      &&   (mLinks[ownerIndex].second == DB2_NAV_NO_FRAGMENT) )
       {
-         pOwner->mpLinkFragment = pNew;
+         mLinks[ownerIndex].second = newIndex;
       }   
 
       // Modified?
@@ -371,7 +484,7 @@ bool cDB2NavTree::ProcessStruct(
             tDB2FieldMap::const_iterator pField = fieldTable.find( fieldID );
             if (pField != fieldTable.end())
             {
-               pNew->mpField = &pField->second;
+               mFragments[newIndex].mpField = &pField->second;
             }
             else
             {
@@ -392,7 +505,7 @@ bool cDB2NavTree::ProcessStruct(
             if (pFragIterTmp != structTable.end())
             {        
                pFrag = &pFragIterTmp->second;    
-               bRC = ProcessStruct( pFrag, pNew );
+               bRC = ProcessStruct( pFrag, newIndex );
             }
             else
             {
@@ -421,8 +534,8 @@ bool cDB2NavTree::ProcessStruct(
       {
          pFragIter++;
 
-         pOld = pNew;
-         pNew = 0;
+         oldIndex = newIndex;
+         newIndex = DB2_NAV_NO_FRAGMENT;
       }
       else
       {
@@ -432,3 +545,279 @@ bool cDB2NavTree::ProcessStruct(
 
    return bRC;
 }
+
+/*===========================================================================
+METHOD:
+   LinkFragments (Internal Method)
+
+DESCRIPTION:
+   Resolve the next/link fragment indices recorded while building into
+   fragment pointers, the fragment array is trimmed to size first as it
+   is never modified again
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cDB2NavTree::LinkFragments()
+{
+   std::vector <sDB2NavFragment>( mFragments ).swap( mFragments );
+
+   for (ULONG f = 0; f < (ULONG)mFragments.size(); f++)
+   {
+      sDB2NavFragment & frag = mFragments[f];
+
+      ULONG next = mLinks[f].first;
+      if (next != DB2_NAV_NO_FRAGMENT)
+      {
+         frag.mpNextFragment = &mFragments[next];
+      }
+
+      ULONG link = mLinks[f].second;
+      if (link != DB2_NAV_NO_FRAGMENT)
+      {
+         frag.mpLinkFragment = &mFragments[link];
+      }
+   }
+
+   std::vector < std::pair <ULONG, ULONG> >().swap( mLinks );
+}
+
+/*===========================================================================
+METHOD:
+   CompileStruct (Internal Method)
+
+DESCRIPTION:
+   Compile the decoding operations of the structure described by the
+   given initial fragment, this mirrors cProtocolEntityNav::ProcessStruct()
+   but is evaluated once, so it fails for anything whose layout depends
+   on the data (optional fragments, variable arrays/strings/pads, etc.)
+
+PARAMETERS:
+   pFrag          [ I ] - First fragment in structure
+   offset         [I/O] - Current offset (in bits, from start of payload)
+   bLSB           [ I ] - Current navigation order (LSB -> MSB?)
+   requiredBits   [I/O] - Payload size (in bits) required so far
+  
+RETURN VALUE:
+   bool - Is the structure of fixed layout?
+===========================================================================*/
+bool cDB2NavTree::CompileStruct(
+   const sDB2NavFragment *    pFrag,
+   ULONG &                    offset,
+   bool                       bLSB,
+   ULONG &                    requiredBits )
+{
+   ULONG structSz = 0;
+   ULONG structOffset = offset;
+
+   bool bOldLSB = bLSB;
+   bool bNewLSB = bOldLSB;
+
+   // Check for directives (switching order requires a byte boundary)
+   if (pFrag != 0)
+   {
+      eDB2FragmentType ft = pFrag->mpFragment->mFragmentType;
+      if (ft == eDB2_FRAGMENT_MSB_2_LSB || ft == eDB2_FRAGMENT_LSB_2_MSB)
+      {
+         bNewLSB = (ft == eDB2_FRAGMENT_LSB_2_MSB);
+         if (bNewLSB != bOldLSB && (offset % BITS_PER_BYTE) != 0)
+         {
+            return false;
+         }
+
+         pFrag = pFrag->mpNextFragment;
+      }
+   }
+
+   // Compile each fragment in the structure
+   while (pFrag != 0)
+   {
+      bool bOK = CompileFragment( pFrag, 
+                                  structOffset, 
+                                  structSz, 
+                                  offset, 
+                                  bNewLSB, 
+                                  requiredBits );
+
+      if (bOK == false)
+      {
+         return false;
+      }
+
+      pFrag = pFrag->mpNextFragment;
+   }
+
+   // Restore navigation order
+   if (bNewLSB != bOldLSB && (offset % BITS_PER_BYTE) != 0)
+   {
+      return false;
+   }
+
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   CompileFragment (Internal Method)
+
+DESCRIPTION:
+   Compile the decoding operation(s) of the given fragment, this mirrors
+   cProtocolEntityNav::ProcessFragment()
+
+PARAMETERS:
+   pFrag          [ I ] - Fragment to be compiled
+   structOffset   [ I ] - Offset (from start of payload) of enclosing struct
+   structSize     [I/O] - Current size of enclosing struct
+   offset         [I/O] - Current offset (in bits, from start of payload)
+   bLSB           [ I ] - Current navigation order (LSB -> MSB?)
+   requiredBits   [I/O] - Payload size (in bits) required so far
+  
+RETURN VALUE:
+   bool - Is the fragment of fixed layout?
+===========================================================================*/
+bool cDB2NavTree::CompileFragment(
+   const sDB2NavFragment *    pFrag,
+   ULONG                      structOffset,
+   ULONG &                    structSize,
+   ULONG &                    offset,
+   bool                       bLSB,
+   ULONG &                    requiredBits )
+{
+   const sDB2Fragment & frag = *pFrag->mpFragment;
+
+   // Constant arrays simply repeat the fragment, any other modifier 
+   // makes the layout depend on the data
+   ULONG arraySz = 1;
+   if (frag.mModifierType == eDB2_MOD_CONSTANT_ARRAY)
+   {
+      const tDB2Array1ModMap & arrays1 = mDB.GetArray1Mods();
+
+      tDB2Array1ModMap::const_iterator pTmp;
+      pTmp = arrays1.find( frag.mpModifierValue );
+      if (pTmp == arrays1.end())
+      {
+         return false;
+      }
+
+      // No array to process?
+      arraySz = pTmp->second;
+      if (arraySz == 0)
+      {
+         return true;
+      }
+   }
+   else if (frag.mModifierType != eDB2_MOD_NONE)
+   {
+      return false;
+   }
+
+   // Is this fragment offset?
+   if (frag.mFragmentOffset < -1)
+   {
+      return false;
+   }
+   else if (frag.mFragmentOffset != -1)
+   {
+      offset = frag.mFragmentOffset + structOffset;
+      requiredBits = std::max( requiredBits, offset );
+   }   
+
+   switch (frag.mFragmentType)
+   {
+      case eDB2_FRAGMENT_FIELD:
+      {
+         const sDB2Field * pField = pFrag->mpField;
+         if (pField == 0)
+         {
+            return false;
+         }
+
+         ULONG sz = pField->mSize;
+         if (sz == 0 || sz > GetDecodeBits( *pField ))
+         {
+            return false;
+         }
+
+         for (ULONG i = 0; i < arraySz; i++)
+         {
+            sDB2DecodeOp op;
+            op.mpField = pField;
+            op.mOffset = offset;
+            op.mbLSB = bLSB;
+
+            offset += sz;
+            requiredBits = std::max( requiredBits, offset );
+            op.mRequiredBits = requiredBits;
+
+            mDecodeOps.push_back( op );
+         }
+      }
+      break;
+
+      case eDB2_FRAGMENT_STRUCT:
+      {
+         if (pFrag->mpLinkFragment == 0)
+         {
+            return false;
+         }
+
+         for (ULONG i = 0; i < arraySz; i++)
+         {
+            bool bOK = CompileStruct( pFrag->mpLinkFragment,
+                                      offset,
+                                      bLSB,
+                                      requiredBits );
+
+            if (bOK == false)
+            {
+               return false;
+            }
+         }
+      }
+      break;
+
+      case eDB2_FRAGMENT_CONSTANT_PAD:
+      {
+         ULONG totalSz = frag.mFragmentValue;
+         if (totalSz >= structSize)
+         {
+            offset = structOffset + totalSz;
+            requiredBits = std::max( requiredBits, offset );
+         }
+      }
+      break;
+
+      case eDB2_FRAGMENT_FULL_BYTE_PAD:
+      {
+         ULONG totalSz = structSize;
+         while ((totalSz % BITS_PER_BYTE) != 0)
+         {
+            totalSz++;
+         }
+
+         if (totalSz > structSize)
+         {
+            offset = structOffset + totalSz;
+            requiredBits = std::max( requiredBits, offset );
+         }
+      }
+      break;
+
+      default:
+         // Variable pads depend on the data, directives are only
+         // valid at the start of a structure
+         return false;
+   }
+
+   // Adjust struct size?
+   if (offset > structOffset)
+   {
+      ULONG newSz = offset - structOffset;
+      if (newSz > structSize)
+      {
+         structSize = newSz;
+      }
+   }
+
+   return true;
+}
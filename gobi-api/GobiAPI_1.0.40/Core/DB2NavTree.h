@@ -7,6 +7,7 @@ DESCRIPTION:
    
 PUBLIC CLASSES AND METHODS:
    sDB2NavFragment
+   sDB2DecodeOp
    cDB2NavTree
       This class distills the database description of a protocol
       entity into a simple tree structure more suited to
@@ -50,8 +51,8 @@ POSSIBILITY OF SUCH DAMAGE.
 //---------------------------------------------------------------------------
 #include "CoreDatabase.h"
 
-#include <list>
 #include <map>
+#include <vector>
 
 //---------------------------------------------------------------------------
 // Definitions
@@ -80,6 +81,30 @@ struct sDB2NavFragment
       const sDB2NavFragment * mpLinkFragment;
 };
 
+/*=========================================================================*/
+// Struct sDB2DecodeOp
+//    Compiled decoding operation for a single field of a protocol entity
+//    with a fixed layout
+/*=========================================================================*/
+struct sDB2DecodeOp
+{
+   public:
+      // Constructor
+      sDB2DecodeOp();
+
+      /* Associated DB field (never empty) */
+      const sDB2Field * mpField;
+
+      /* Offset of the field (in bits, from the start of the payload) */
+      ULONG mOffset;
+
+      /* Payload size (in bits) needed to decode this and all prior fields */
+      ULONG mRequiredBits;
+
+      /* Is the field parsed LSB -> MSB? */
+      bool mbLSB;
+};
+
 /*=========================================================================*/
 // Class cDB2NavTree
 //    Class to describe a protocol entity suited to efficient navigation
@@ -102,23 +127,66 @@ class cDB2NavTree
          return mEntity;
       };
 
-      // (Inline) Return fragments
-      const std::list <sDB2NavFragment *> & GetFragments() const
+      // (Inline) Return fragments (depth first order, i.e. the fragments
+      // of a structure are immediately followed by those of any structure
+      // it contains)
+      const std::vector <sDB2NavFragment> & GetFragments() const
       {
          return mFragments;
       };
 
-      // Return a map of all tracked fields
-      std::map <ULONG, std::pair <bool, LONGLONG> > GetTrackedFields() const
+      // (Inline) Return a map of all tracked fields
+      const std::map <ULONG, std::pair <bool, LONGLONG> > & 
+         GetTrackedFields() const
       {
          return mTrackedFields;
       };
 
+      // (Inline) Does the protocol entity have a fixed layout, i.e. one
+      // that can be decoded without navigating the fragments?
+      bool IsFixedLayout() const
+      {
+         return mbFixedLayout;
+      };
+
+      // (Inline) Return the decoding operations of a fixed layout entity
+      // (one per field, in the order the fields would be parsed)
+      const std::vector <sDB2DecodeOp> & GetDecodeOps() const
+      {
+         return mDecodeOps;
+      };
+
+      // (Inline) Return the payload size (in bits) of a fixed layout 
+      // entity, including any trailing padding
+      ULONG GetFixedBits() const
+      {
+         return mFixedBits;
+      };
+
    protected:     
       // Process a structure described by the given initial fragment
       bool ProcessStruct( 
          const sDB2Fragment *       pFrag,
-         sDB2NavFragment *          pOwner );
+         ULONG                      ownerIndex );
+
+      // Resolve the fragment links recorded while building
+      void LinkFragments();
+
+      // Compile the decoding operations of a fixed layout entity
+      bool CompileStruct(
+         const sDB2NavFragment *    pFrag,
+         ULONG &                    offset,
+         bool                       bLSB,
+         ULONG &                    requiredBits );
+
+      // Compile the decoding operation(s) of the given fragment
+      bool CompileFragment(
+         const sDB2NavFragment *    pFrag,
+         ULONG                      structOffset,
+         ULONG &                    structSize,
+         ULONG &                    offset,
+         bool                       bLSB,
+         ULONG &                    requiredBits );
       
       /* Protocol entity being navigated */
       sDB2ProtocolEntity mEntity;
@@ -126,11 +194,23 @@ class cDB2NavTree
       /* Database reference */
       const cCoreDatabase & mDB;
 
-      /* List of all allocated fragments */
-      std::list <sDB2NavFragment *> mFragments;
+      /* All fragments, stored contiguously */
+      std::vector <sDB2NavFragment> mFragments;
+
+      /* Next/link fragment indices, only used while building */
+      std::vector < std::pair <ULONG, ULONG> > mLinks;
 
       /* Map of all 'tracked' fields */
       std::map <ULONG, std::pair <bool, LONGLONG> > mTrackedFields;      
+
+      /* Does the protocol entity have a fixed layout? */
+      bool mbFixedLayout;
+
+      /* Decoding operations (fixed layout entities only) */
+      std::vector <sDB2DecodeOp> mDecodeOps;
+
+      /* Payload size (in bits, fixed layout entities only) */
+      ULONG mFixedBits;
 };
 
 
@@ -637,6 +637,141 @@ sSharedBuffer * DB2BuildQMIBuffer(
    return pRef;
 }
 
+/*===========================================================================
+METHOD:
+   DB2StoreQMIPayload (Internal Method)
+
+DESCRIPTION:
+   Store a packed TLV payload into the given buffer, adjusting the
+   payload as QMI requires
+
+PARAMETERS:
+   db          [ I ] - Database to use
+   key         [ I ] - Protocol entity key of the TLV
+   pData       [ I ] - Packed payload
+   dataLen     [ I ] - Length of above payload
+   pBuffer     [ O ] - Buffer to store the payload in
+   bufferLen   [I/O] - Size of above buffer/size of stored payload
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+static bool DB2StoreQMIPayload(
+   const cCoreDatabase &         db,
+   const std::vector <ULONG> &   key,
+   const BYTE *                  pData,
+   ULONG                         dataLen,
+   BYTE *                        pBuffer,
+   ULONG &                       bufferLen )
+{
+   // Check if we need to adjust buffer (strings are never part of
+   // a fixed layout, so there is no need to enumerate those fields)
+   const cDB2NavTree * pNavTree = db.GetEntityNavTree( key );
+   if (pNavTree == 0 || pNavTree->IsFixedLayout() == false)
+   {
+      cProtocolEntityFieldEnumerator pefe( db, key );
+      bool bEnum = pefe.Enumerate();
+      if (bEnum == true)
+      {
+         const std::vector <ULONG> & fieldIDs = pefe.GetFields();
+         ULONG fieldCount = (ULONG)fieldIDs.size();
+         if (fieldCount == 1)
+         {
+            const tDB2FieldMap & dbFields = db.GetProtocolFields();
+
+            tDB2FieldMap::const_iterator pField = dbFields.find( fieldIDs[0] );
+            if (pField != dbFields.end())
+            {
+               const sDB2Field & theField = pField->second;
+               if ( (theField.mType == eDB2_FIELD_STD)
+               &&   (theField.mTypeVal == (ULONG)eDB2_FIELD_STDTYPE_STRING_ANT) )
+               {
+                  // For QMI we need to strip out the trailing NULL 
+                  // string terminator when the TLV consists solely
+                  // of a string since the length contained in the 
+                  // TLV structure itself renders the trailing NULL 
+                  // redundant
+                  if (dataLen > 2)
+                  {
+                     dataLen--;
+                  }
+                  else 
+                  {
+                     // This is the only way to specify an empty string in QMI
+                     // when the TLV consists solely of a string
+                     if (dataLen == 1)
+                     {
+                        dataLen--;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   // What we are building cannot be too large
+   if (dataLen > bufferLen)
+   {
+      return false;
+   }
+
+   if (dataLen > 0)
+   {
+      memcpy( (LPVOID)pBuffer, (LPCVOID)pData, (SIZE_T)dataLen );
+   }
+
+   bufferLen = dataLen;
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   DB2PackQMIPayload (Internal Method)
+
+DESCRIPTION:
+   Pack a TLV payload and store it into the given buffer (the packed
+   data belongs to the packer, so it is stored before the packer goes
+   away)
+
+PARAMETERS:
+   db          [ I ] - Database to use
+   key         [ I ] - Protocol entity key of the TLV
+   dp          [ I ] - Packer for the TLV
+   pBuffer     [ O ] - Buffer to store the payload in
+   bufferLen   [I/O] - Size of above buffer/size of stored payload
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+static bool DB2PackQMIPayload(
+   const cCoreDatabase &         db,
+   const std::vector <ULONG> &   key,
+   cDataPacker &                 dp,
+   BYTE *                        pBuffer,
+   ULONG &                       bufferLen )
+{
+   bool bOK = dp.Pack();
+   if (bOK == false)
+   {
+      return false;
+   }
+
+   ULONG packedLen = 0;
+   const BYTE * pPackedData = dp.GetBuffer( packedLen );
+   if (pPackedData == 0)
+   {
+      return false;
+   }
+
+   return DB2StoreQMIPayload( db, 
+                              key, 
+                              pPackedData, 
+                              packedLen, 
+                              pBuffer, 
+                              bufferLen );
+}
+
 /*===========================================================================
 METHOD:
    DB2PackQMIBuffer (Internal Method)
@@ -706,109 +841,60 @@ sSharedBuffer * DB2PackQMIBuffer(
    BYTE buf[QMI_MAX_BUFFER_SIZE];
    ULONG bufLen = 0;
 
-   sQMIRawContentHeader * pTLV = 0;
-   pTLV = (sQMIRawContentHeader *)&buf[0];
-
    bool bOK = true;
    for (t = 0; t < tlvs; t++)
    {
-      ULONG packedLen = 0;
-      const BYTE * pPackedData = 0;
-
       const sDB2PackingInput & tlv2Input = input[t];
 
-      if (tlv2Input.mbString == true)
+      // What we are building cannot be too large
+      ULONG hdrLen = (ULONG)sizeof(sQMIRawContentHeader);
+      if (bufLen + hdrLen > QMI_MAX_BUFFER_SIZE)
       {
-         if (tlv2Input.mValues.empty() == false)
-         {
-            // Convert field string to input fields
-            std::list <sUnpackedField> fields 
-               = cDataPacker::LoadValues( tlv2Input.mValues );
-
-            // Now pack
-            cDataPacker dp( db, tlv2Input.mKey, fields );
-            bOK = dp.Pack();
-            if (bOK == false)
-            {
-               break;
-            }
-
-            pPackedData = dp.GetBuffer( packedLen );
-            if (pPackedData == 0)
-            {
-               bOK = false;
-               break;
-            }
-         }
+         bOK = false;
+         break;
       }
-      else
+
+      sQMIRawContentHeader * pTLV = (sQMIRawContentHeader *)&buf[bufLen];
+      bufLen += hdrLen;
+
+      // Pack the payload in place
+      BYTE * pPayload = &buf[bufLen];
+      ULONG payloadLen = QMI_MAX_BUFFER_SIZE - bufLen;
+
+      if (tlv2Input.mbTyped == true)
       {
-         packedLen = tlv2Input.mDataLen;
-         pPackedData = tlv2Input.mpData;
+         // Typed values go straight to the packer
+         cDataPacker dp( db, tlv2Input.mKey, tlv2Input.mTypedValues );
+         bOK = DB2PackQMIPayload( db, tlv2Input.mKey, dp, pPayload, payloadLen );
       }
-
-      // Check if we need to adjust buffer
-      cProtocolEntityFieldEnumerator pefe( db, tlv2Input.mKey );
-      bool bEnum = pefe.Enumerate();
-      if (bEnum == true)
+      else if (tlv2Input.mbString == true && tlv2Input.mValues.empty() == false)
       {
-         const std::vector <ULONG> & fieldIDs = pefe.GetFields();
-         ULONG fieldCount = (ULONG)fieldIDs.size();
-         if (fieldCount == 1)
-         {
-            const tDB2FieldMap & dbFields = db.GetProtocolFields();
+         // Convert field string to input fields
+         std::list <sUnpackedField> fields 
+            = cDataPacker::LoadValues( tlv2Input.mValues );
 
-            tDB2FieldMap::const_iterator pField = dbFields.find( fieldIDs[0] );
-            if (pField != dbFields.end())
-            {
-               const sDB2Field & theField = pField->second;
-               if ( (theField.mType == eDB2_FIELD_STD)
-               &&   (theField.mTypeVal == (ULONG)eDB2_FIELD_STDTYPE_STRING_ANT) )
-               {
-                  // For QMI we need to strip out the trailing NULL 
-                  // string terminator when the TLV consists solely
-                  // of a string since the length contained in the 
-                  // TLV structure itself renders the trailing NULL 
-                  // redundant
-                  if (packedLen > 2)
-                  {
-                     packedLen--;
-                  }
-                  else 
-                  {
-                     // This is the only way to specify an empty string in QMI
-                     // when the TLV consists solely of a string
-                     if (packedLen == 1)
-                     {
-                        packedLen--;
-                     }
-                  }
-               }
-            }
-         }
+         // Now pack
+         cDataPacker dp( db, tlv2Input.mKey, fields );
+         bOK = DB2PackQMIPayload( db, tlv2Input.mKey, dp, pPayload, payloadLen );
+      }
+      else
+      {
+         bOK = DB2StoreQMIPayload( db,
+                                   tlv2Input.mKey,
+                                   tlv2Input.mpData,
+                                   tlv2Input.mDataLen,
+                                   pPayload,
+                                   payloadLen );
       }
 
-      bufLen += (ULONG)sizeof(sQMIRawContentHeader);
-      bufLen += packedLen;
-
-      // What we are building cannot be too large
-      if (bufLen > QMI_MAX_BUFFER_SIZE)
+      if (bOK == false)
       {
-         bOK = false;
          break;
       }
 
       pTLV->mTypeID = (BYTE)tlv2Input.mKey[2];
-      pTLV->mLength = (WORD)packedLen;
-      pTLV++;
-
-      const BYTE * pPayload = (const BYTE *)pTLV;
-      memcpy( (LPVOID)pPayload, 
-              (LPCVOID)pPackedData, 
-              (SIZE_T)packedLen );
-
-      pPayload += packedLen;
-      pTLV = (sQMIRawContentHeader *)pPayload;
+      pTLV->mLength = (WORD)payloadLen;
+      bufLen += payloadLen;
    }
 
    if (bOK == false)
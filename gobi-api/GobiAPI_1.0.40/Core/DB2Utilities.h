@@ -59,6 +59,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "SharedBuffer.h"
 #include "ProtocolBuffer.h"
 #include "QMIEnum.h"
+#include "DataPacker.h"
 
 #include <vector>
 
@@ -141,7 +142,8 @@ struct sDB2PackingInput
       sDB2PackingInput()
          :  mpData( 0 ),
             mDataLen( 0 ),
-            mbString( true )
+            mbString( true ),
+            mbTyped( false )
       { };
  
       // (Inline) Constructor - parameterized (string payload)
@@ -151,7 +153,8 @@ struct sDB2PackingInput
          :  mKey( key ),
             mpData( 0 ),
             mDataLen( 0 ),
-            mbString( true )
+            mbString( true ),
+            mbTyped( false )
       { 
          if (pValue != 0 && pValue[0] != 0)
          {
@@ -167,11 +170,30 @@ struct sDB2PackingInput
          :  mKey( key ),
             mpData( pData ),
             mDataLen( dataLen ),
-            mbString( false )
+            mbString( false ),
+            mbTyped( false )
       { 
          // Nothing to do
       };
 
+      // (Inline) Constructor - parameterized (typed payload, values are
+      // given in field order)
+      sDB2PackingInput( 
+         const sProtocolEntityKey & key,
+         const sDataPackerValue *   pValues,
+         ULONG                      valueCount )
+         :  mKey( key ),
+            mbString( false ),
+            mpData( 0 ),
+            mDataLen( 0 ),
+            mbTyped( true )
+      { 
+         if (pValues != 0 && valueCount > 0)
+         {
+            mTypedValues.assign( pValues, pValues + valueCount );
+         }
+      };
+
       // (Inline) Is this object in a valid state?
       bool IsValid() const
       {
@@ -198,6 +220,12 @@ struct sDB2PackingInput
 
       /* Length of above buffer */
       ULONG mDataLen;
+
+      /* Are the values specified as typed values? */
+      bool mbTyped;
+
+      /* Typed field values (in field order) */
+      std::vector <sDataPackerValue> mTypedValues;
 };
 
 /*=========================================================================*/
@@ -0,0 +1,426 @@
+/*===========================================================================
+FILE:
+   DataDecoder.cpp
+
+DESCRIPTION:
+   Implementation of cDataDecoder
+   
+PUBLIC CLASSES AND METHODS:
+   cDataDecoder
+      Class to decode a buffer straight into typed values using the
+      decoding operations compiled for a fixed layout protocol entity,
+      i.e. without navigating the DB definition or generating strings
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "DataDecoder.h"
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+/*===========================================================================
+METHOD:
+   StoreInteger (Free Method)
+
+DESCRIPTION:
+   Store an integer value into a target of the given type (truncating)
+
+PARAMETERS:
+   val         [ I ] - Value to store
+   pTarget     [ O ] - Target
+
+RETURN VALUE:
+   None
+===========================================================================*/
+template <class T> 
+static void StoreInteger( 
+   ULONGLONG                  val,
+   LPVOID                     pTarget )
+{
+   T tmp = (T)val;
+   memcpy( pTarget, (LPCVOID)&tmp, sizeof( T ) );
+}
+
+/*=========================================================================*/
+// cDataDecoder Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cDataDecoder (Public Method)
+
+DESCRIPTION:
+   Constructor
+
+PARAMETERS:
+   db          [ I ] - Database to use
+   key         [ I ] - Key into the protocol entity table
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cDataDecoder::cDataDecoder(
+   const cCoreDatabase &      db,
+   const std::vector <ULONG> & key )
+   :  mDB( db ),
+      mpOps( 0 )
+{
+   const cDB2NavTree * pNavTree = db.GetEntityNavTree( key );
+   if (pNavTree != 0 && pNavTree->IsFixedLayout() == true)
+   {
+      mpOps = &pNavTree->GetDecodeOps();
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Decode (Public Method)
+
+DESCRIPTION:
+   Decode the leading fields of the given buffer into the targets (one
+   target per field, in field order), the values are identical to those
+   cDataParser would produce for the same fields
+
+   Nothing is stored unless every field can be decoded
+
+PARAMETERS:
+   pData       [ I ] - Data to decode
+   dataLen     [ I ] - Length of above buffer
+   pTargets    [ I ] - Targets
+   targetCount [ I ] - Number of targets (i.e. fields to decode)
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDataDecoder::Decode(
+   const BYTE *               pData,
+   ULONG                      dataLen,
+   const sDataDecoderTarget * pTargets,
+   ULONG                      targetCount ) const
+{
+   // Assume failure
+   bool bRC = false;
+   if ( (mpOps == 0)
+   ||   (pData == 0)
+   ||   (pTargets == 0)
+   ||   (targetCount == 0)
+   ||   (targetCount > (ULONG)mpOps->size()) )
+   {
+      return bRC;
+   }
+
+   // Is there enough data for all the fields?
+   const std::vector <sDB2DecodeOp> & ops = *mpOps;
+   ULONG dataBits = dataLen * BITS_PER_BYTE;
+   if (ops[targetCount - 1].mRequiredBits > dataBits)
+   {
+      return bRC;
+   }
+
+   for (ULONG t = 0; t < targetCount; t++)
+   {
+      if (CheckTarget( *ops[t].mpField, pTargets[t] ) == false)
+      {
+         return bRC;
+      }
+   }
+
+   // The layout is fixed, so go straight to each field (the parser is 
+   // never clamped as all offsets lie within the data)
+   static const std::string noName = "";
+   cBitParser bp( pData, dataBits );
+
+   for (ULONG t = 0; t < targetCount; t++)
+   {
+      if (pTargets[t].mpValue == 0)
+      {
+         continue;
+      }
+
+      const sDB2DecodeOp & op = ops[t];
+      bp.SetLSBMode( op.mbLSB );
+      bp.SetOffset( op.mOffset );
+
+      sParsedField theField( mDB, op.mpField, noName, bp, false );
+      if (theField.IsValid() == false)
+      {
+         // This should not happen
+         ASSERT( 0 );
+         return bRC;
+      }
+
+      StoreValue( theField, pTargets[t] );
+   }
+
+   bRC = true;
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   Store (Static Public Method)
+
+DESCRIPTION:
+   Store the leading fields of a parsed buffer into the targets (one
+   target per field, in field order), converting as Decode() does
+
+   Nothing is stored unless every field can be stored
+
+PARAMETERS:
+   fields      [ I ] - Parsed fields
+   pTargets    [ I ] - Targets
+   targetCount [ I ] - Number of targets (i.e. fields to store)
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDataDecoder::Store(
+   const cDataParser::tParsedFields &  fields,
+   const sDataDecoderTarget *          pTargets,
+   ULONG                               targetCount )
+{
+   // Assume failure
+   bool bRC = false;
+   if ( (pTargets == 0)
+   ||   (targetCount == 0)
+   ||   (targetCount > (ULONG)fields.size()) )
+   {
+      return bRC;
+   }
+
+   for (ULONG t = 0; t < targetCount; t++)
+   {
+      if (CheckTarget( fields[t].mField, pTargets[t] ) == false)
+      {
+         return bRC;
+      }
+   }
+
+   for (ULONG t = 0; t < targetCount; t++)
+   {
+      if (pTargets[t].mpValue != 0)
+      {
+         StoreValue( fields[t], pTargets[t] );
+      }
+   }
+
+   bRC = true;
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   CheckTarget (Static Internal Method)
+
+DESCRIPTION:
+   Can the given field be stored into the given target?
+
+PARAMETERS:
+   field       [ I ] - Field
+   target      [ I ] - Target
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDataDecoder::CheckTarget( 
+   const sDB2Field &          field,
+   const sDataDecoderTarget & target )
+{
+   // Skipped fields need no storage
+   if (target.mpValue == 0)
+   {
+      return true;
+   }
+
+   bool bFloat = false;
+   switch (field.mType)
+   {
+      case eDB2_FIELD_STD:
+         switch ((eDB2StdFieldType)field.mTypeVal)
+         {
+            case eDB2_FIELD_STDTYPE_FLOAT32:
+            case eDB2_FIELD_STDTYPE_FLOAT64:
+               bFloat = true;
+               break;
+
+            case eDB2_FIELD_STDTYPE_STRING_A:
+            case eDB2_FIELD_STDTYPE_STRING_U:
+            case eDB2_FIELD_STDTYPE_STRING_ANT:
+            case eDB2_FIELD_STDTYPE_STRING_UNT:
+            case eDB2_FIELD_STDTYPE_STRING_U8:
+            case eDB2_FIELD_STDTYPE_STRING_U8NT:
+               return false;
+
+            default:
+               break;
+         }
+         break;
+
+      case eDB2_FIELD_ENUM_UNSIGNED:
+      case eDB2_FIELD_ENUM_SIGNED:
+         break;
+
+      default:
+         return false;
+   }
+
+   if (bFloat == true)
+   {
+      return (target.mSize == sizeof( FLOAT ) || target.mSize == sizeof( DOUBLE ));
+   }
+
+   return ( (target.mSize == sizeof( UCHAR ))
+        ||  (target.mSize == sizeof( USHORT ))
+        ||  (target.mSize == sizeof( UINT ))
+        ||  (target.mSize == sizeof( ULONGLONG )) );
+}
+
+/*===========================================================================
+METHOD:
+   StoreValue (Static Internal Method)
+
+DESCRIPTION:
+   Store a parsed field value into the given target (which has already
+   been checked by CheckTarget())
+
+PARAMETERS:
+   field       [ I ] - Parsed field
+   target      [ I ] - Target
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void cDataDecoder::StoreValue( 
+   const sParsedField &       field,
+   const sDataDecoderTarget & target )
+{
+   // Widen to 64 bits first (sign extending signed values)
+   ULONGLONG val = 0;
+
+   const uFields & fv = field.mValue;
+   switch (field.mField.mType)
+   {
+      case eDB2_FIELD_STD:
+         switch ((eDB2StdFieldType)field.mField.mTypeVal)
+         {
+            case eDB2_FIELD_STDTYPE_BOOL:
+            case eDB2_FIELD_STDTYPE_UINT8:
+               val = (ULONGLONG)fv.mU8;
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT8:
+               val = (ULONGLONG)(LONGLONG)fv.mS8;
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT16:
+               val = (ULONGLONG)(LONGLONG)fv.mS16;
+               break;
+
+            case eDB2_FIELD_STDTYPE_UINT16:
+               val = (ULONGLONG)fv.mU16;
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT32:
+               val = (ULONGLONG)(LONGLONG)fv.mS32;
+               break;
+
+            case eDB2_FIELD_STDTYPE_UINT32:
+               val = (ULONGLONG)fv.mU32;
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT64:
+            case eDB2_FIELD_STDTYPE_UINT64:
+               val = fv.mU64;
+               break;
+
+            case eDB2_FIELD_STDTYPE_FLOAT32:
+               if (target.mSize == sizeof( FLOAT ))
+               {
+                  memcpy( target.mpValue, (LPCVOID)&fv.mFP32, sizeof( FLOAT ) );
+               }
+               else
+               {
+                  DOUBLE tmp = (DOUBLE)fv.mFP32;
+                  memcpy( target.mpValue, (LPCVOID)&tmp, sizeof( DOUBLE ) );
+               }
+               return;
+
+            case eDB2_FIELD_STDTYPE_FLOAT64:
+               if (target.mSize == sizeof( DOUBLE ))
+               {
+                  memcpy( target.mpValue, (LPCVOID)&fv.mFP64, sizeof( DOUBLE ) );
+               }
+               else
+               {
+                  FLOAT tmp = (FLOAT)fv.mFP64;
+                  memcpy( target.mpValue, (LPCVOID)&tmp, sizeof( FLOAT ) );
+               }
+               return;
+
+            default:
+               return;
+         }
+         break;
+
+      case eDB2_FIELD_ENUM_UNSIGNED:
+         val = (ULONGLONG)fv.mU32;
+         break;
+
+      case eDB2_FIELD_ENUM_SIGNED:
+         val = (ULONGLONG)(LONGLONG)fv.mS32;
+         break;
+
+      default:
+         return;
+   }
+
+   switch (target.mSize)
+   {
+      case sizeof( UCHAR ):
+         StoreInteger <UCHAR>( val, target.mpValue );
+         break;
+
+      case sizeof( USHORT ):
+         StoreInteger <USHORT>( val, target.mpValue );
+         break;
+
+      case sizeof( UINT ):
+         StoreInteger <UINT>( val, target.mpValue );
+         break;
+
+      case sizeof( ULONGLONG ):
+         StoreInteger <ULONGLONG>( val, target.mpValue );
+         break;
+   }
+}
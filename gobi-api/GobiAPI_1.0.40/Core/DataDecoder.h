@@ -0,0 +1,141 @@
+/*===========================================================================
+FILE:
+   DataDecoder.h
+
+DESCRIPTION:
+   Declaration of cDataDecoder
+   
+PUBLIC CLASSES AND METHODS:
+   sDataDecoderTarget
+      Structure describing where (and how wide) a decoded field value
+      is to be stored
+
+   cDataDecoder
+      Class to decode a buffer straight into typed values using the
+      decoding operations compiled for a fixed layout protocol entity,
+      i.e. without navigating the DB definition or generating strings
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Pragmas
+//---------------------------------------------------------------------------
+#pragma once
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "DataParser.h"
+#include "DB2NavTree.h"
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Describe a typed variable (or structure member) as a decoding target
+#define DATA_DECODER_TARGET( var ) \
+   { (LPVOID)&(var), (ULONG)sizeof( var ) }
+
+/*=========================================================================*/
+// Struct sDataDecoderTarget
+//
+//    Structure describing where a decoded field value is to be stored,
+//    integer values (including enums) are converted to the size of the
+//    target (1, 2, 4 or 8 bytes, signed values are sign extended) while
+//    floating point values are stored as a FLOAT (4) or a DOUBLE (8)
+/*=========================================================================*/
+struct sDataDecoderTarget
+{
+   /* Where to store the value (0 = skip the field) */
+   LPVOID mpValue;
+
+   /* Size (in bytes) of the above */
+   ULONG mSize;
+};
+
+/*=========================================================================*/
+// Class cDataDecoder
+/*=========================================================================*/
+class cDataDecoder
+{
+   public:
+      // Constructor
+      cDataDecoder(
+         const cCoreDatabase &      db,
+         const std::vector <ULONG> & key );
+
+      // (Inline) Does the protocol entity have compiled decoding
+      // operations (i.e. a fixed layout)?
+      bool IsValid() const
+      {
+         return (mpOps != 0);
+      };
+
+      // (Inline) Return the number of fields the entity decodes to
+      ULONG GetFieldCount() const
+      {
+         ULONG count = 0;
+         if (mpOps != 0)
+         {
+            count = (ULONG)mpOps->size();
+         }
+
+         return count;
+      };
+
+      // Decode the leading fields of the given buffer into the targets
+      bool Decode(
+         const BYTE *               pData,
+         ULONG                      dataLen,
+         const sDataDecoderTarget * pTargets,
+         ULONG                      targetCount ) const;
+
+      // Store the leading fields of a parsed buffer into the targets
+      static bool Store(
+         const cDataParser::tParsedFields &  fields,
+         const sDataDecoderTarget *          pTargets,
+         ULONG                               targetCount );
+
+   protected:
+      // Can the given field be stored into the given target?
+      static bool CheckTarget( 
+         const sDB2Field &          field,
+         const sDataDecoderTarget & target );
+
+      // Store a parsed field value into the given target
+      static void StoreValue( 
+         const sParsedField &       field,
+         const sDataDecoderTarget & target );
+
+      /* Database reference */
+      const cCoreDatabase & mDB;
+
+      /* Compiled decoding operations (0 = entity is not fixed layout) */
+      const std::vector <sDB2DecodeOp> * mpOps;
+};
@@ -11,6 +11,9 @@ PUBLIC CLASSES AND METHODS:
       field value as a string and an optional field name (either fully
       qualified) or partial
 
+   sDataPackerValue
+      Structure to represent a single typed (input) field value
+
    cDataPacker
       Class to pack bit/byte specified fields into a buffer accordinging
       to a database description, uses cProtocolEntityNav to navigate the DB
@@ -59,6 +62,43 @@ POSSIBILITY OF SUCH DAMAGE.
 // Definitions
 //---------------------------------------------------------------------------
 
+/*===========================================================================
+METHOD:
+   GetInteger (Free Method)
+
+DESCRIPTION:
+   Return the integer value of a typed value, provided it lies within
+   the given range (the range of the type a field is packed as)
+
+PARAMETERS:
+   value       [ I ] - Typed value
+   minVal      [ I ] - Minimum allowed value
+   maxVal      [ I ] - Maximum allowed value
+   val         [ O ] - The value
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+static bool GetInteger(
+   const sDataPackerValue &   value,
+   LONGLONG                   minVal,
+   ULONGLONG                  maxVal,
+   LONGLONG &                 val )
+{
+   if (value.mbFloat == true || value.mpString != 0)
+   {
+      return false;
+   }
+
+   val = (LONGLONG)value.mValue;
+   if (value.mbSigned == true && val < 0)
+   {
+      return (val >= minVal);
+   }
+
+   return (value.mValue <= maxVal);
+}
+
 /*=========================================================================*/
 // cDataPacker Methods
 /*=========================================================================*/
@@ -86,6 +126,7 @@ cDataPacker::cDataPacker(
       mKey( key ),
       mbValuesOnly( true ),
       mProcessedFields( 0 ),
+      mbTyped( false ),
       mbPacked( false )
 {
    // Initialize internal buffer
@@ -116,6 +157,49 @@ cDataPacker::cDataPacker(
    }
 }
 
+/*===========================================================================
+METHOD:
+   cDataPacker (Public Method)
+
+DESCRIPTION:
+   Constructor (typed values, one per field in the order the fields are
+   packed, i.e. the typed equivalent of value only mode)
+
+PARAMETERS:
+   db             [ I ] - Database to use
+   key            [ I ] - Key into protocol entity table
+   values         [ I ] - Values to pack into buffer
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cDataPacker::cDataPacker( 
+   const cCoreDatabase &                  db,
+   const std::vector <ULONG> &            key,
+   const std::vector <sDataPackerValue> & values )
+   :  cProtocolEntityNav( db ),
+      mKey( key ),
+      mTypedValues( values ),
+      mbValuesOnly( true ),
+      mProcessedFields( 0 ),
+      mbTyped( true ),
+      mbPacked( false )
+{
+   // The internal buffer is initialized when packing (only as much
+   // of it as is needed)
+
+   // Compute bits left in buffer
+   ULONG bits = MAX_SHARED_BUFFER_SIZE * BITS_PER_BYTE;
+   if (mKey.size() > 0)
+   {
+      eDB2EntityType et = (eDB2EntityType)mKey[0];
+      bits = DB2GetMaxBufferSize( et ) * BITS_PER_BYTE;
+   }
+   
+   // Setup the bit packer
+   mBitsy.SetData( mBuffer, bits );
+}
+
 /*===========================================================================
 METHOD:
    ~cDataPacker (Public Method)
@@ -144,6 +228,26 @@ RETURN VALUE:
 ===========================================================================*/
 bool cDataPacker::Pack()
 {
+   // Typed values for an entity of fixed layout can be packed without
+   // navigating the entity
+   if (mbPacked == false && mbTyped == true)
+   {
+      const cDB2NavTree * pNavTree = mDB.GetEntityNavTree( mKey );
+      if ( (pNavTree != 0) 
+      &&   (pNavTree->IsFixedLayout() == true)
+      &&   (pNavTree->GetDecodeOps().size() == mTypedValues.size()) )
+      {
+         ULONG bytes = pNavTree->GetFixedBits() + BITS_PER_BYTE - 1;
+         bytes = std::min( bytes / BITS_PER_BYTE, MAX_SHARED_BUFFER_SIZE );
+         memset( &mBuffer[0], 0, (SIZE_T)bytes );
+
+         mbPacked = PackFixed( *pNavTree );
+         return mbPacked;
+      }
+
+      memset( &mBuffer[0], 0, (SIZE_T)MAX_SHARED_BUFFER_SIZE );
+   }
+
    // Process (pack) the protocol entity
    if (mbPacked == false)
    {
@@ -487,6 +591,253 @@ bool cDataPacker::PackString(
    return bOK;
 }
 
+/*===========================================================================
+METHOD:
+   PackValue (Internal Method)
+
+DESCRIPTION:
+   Pack the typed value into the buffer as the given field, this is the 
+   typed equivalent of ProcessField() (the same range checks apply and 
+   the same values are recorded)
+  
+PARAMETERS:
+   field       [ I ] - The field being packed
+   value       [ I ] - The value to pack
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDataPacker::PackValue(
+   const sDB2Field &          field,
+   const sDataPackerValue &   value )
+{
+   // Assume failure
+   bool bOK = false;
+
+   LONGLONG val = 0;
+   DWORD rc = ERROR_INVALID_PARAMETER;
+   bool bRecord = true;
+
+   // What type is this field?    
+   switch (field.mType)
+   {
+      case eDB2_FIELD_STD:
+      {
+         // Standard field, what kind?
+         eDB2StdFieldType ft = (eDB2StdFieldType)field.mTypeVal;
+         switch (ft)
+         {              
+            case eDB2_FIELD_STDTYPE_BOOL:
+            case eDB2_FIELD_STDTYPE_UINT8:
+               if (GetInteger( value, 0, UCHAR_MAX, val ) == true)
+               {
+                  if (ft == eDB2_FIELD_STDTYPE_BOOL && val > 1)
+                  {
+                     val = 1;
+                  }
+
+                  rc = mBitsy.Set( field.mSize, (UCHAR)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT8:
+               if (GetInteger( value, SCHAR_MIN, SCHAR_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (CHAR)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT16: 
+               if (GetInteger( value, SHRT_MIN, SHRT_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (SHORT)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_UINT16:
+               if (GetInteger( value, 0, USHRT_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (USHORT)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT32:
+               if (GetInteger( value, LONG_MIN, LONG_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (LONG)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_UINT32:
+               if (GetInteger( value, 0, ULONG_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (ULONG)val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_INT64:
+               if (GetInteger( value, LLONG_MIN, LLONG_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, val );
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_UINT64:
+               if (GetInteger( value, 0, ULLONG_MAX, val ) == true)
+               {
+                  rc = mBitsy.Set( field.mSize, (ULONGLONG)val );
+                  bRecord = (value.mValue <= LLONG_MAX);
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_STRING_A:
+            case eDB2_FIELD_STDTYPE_STRING_U:
+            case eDB2_FIELD_STDTYPE_STRING_ANT:
+            case eDB2_FIELD_STDTYPE_STRING_UNT:
+            {
+               // Set the character size
+               ULONG charSz = sizeof(CHAR);
+               if ( (ft == eDB2_FIELD_STDTYPE_STRING_U)
+               ||   (ft == eDB2_FIELD_STDTYPE_STRING_UNT) )
+               {
+                  charSz = sizeof(USHORT);
+               }
+
+               // Compute the number of characters?
+               ULONG numChars = 0;
+               if ( (ft == eDB2_FIELD_STDTYPE_STRING_A)
+               ||   (ft == eDB2_FIELD_STDTYPE_STRING_U) )
+               {
+                  numChars = (field.mSize / BITS_PER_BYTE) / charSz;
+               }
+
+               // Pack the string (strings are never recorded)
+               return PackString( numChars, value.mpString );
+            }
+
+            case eDB2_FIELD_STDTYPE_FLOAT32:
+               if (value.mpString == 0)
+               {
+                  FLOAT fval = (FLOAT)value.mFloat;
+                  if (value.mbFloat == false)
+                  {
+                     fval = (value.mbSigned == true ? (FLOAT)(LONGLONG)value.mValue 
+                                                    : (FLOAT)value.mValue);
+                  }
+
+                  // We pack as a UINT (the bits of the FLOAT)
+                  UINT tmp = 0;
+                  memcpy( (LPVOID)&tmp, (LPCVOID)&fval, sizeof( tmp ) );
+
+                  rc = mBitsy.Set( field.mSize, (ULONG)tmp );
+                  bRecord = false;
+               }
+               break;
+
+            case eDB2_FIELD_STDTYPE_FLOAT64:
+               if (value.mpString == 0)
+               {
+                  DOUBLE dval = value.mFloat;
+                  if (value.mbFloat == false)
+                  {
+                     dval = (value.mbSigned == true ? (DOUBLE)(LONGLONG)value.mValue 
+                                                    : (DOUBLE)value.mValue);
+                  }
+
+                  // We pack as a ULONGLONG (the bits of the DOUBLE)
+                  ULONGLONG tmp = 0;
+                  memcpy( (LPVOID)&tmp, (LPCVOID)&dval, sizeof( tmp ) );
+
+                  rc = mBitsy.Set( field.mSize, tmp );
+                  bRecord = false;
+               }
+               break;
+
+            default:
+               // UTF-8 strings are unsupported in the Linux adaptation
+               break;
+         }
+      }
+      break;
+
+      case eDB2_FIELD_ENUM_UNSIGNED:
+         if (GetInteger( value, 0, ULONG_MAX, val ) == true)
+         {
+            rc = mBitsy.Set( field.mSize, (ULONG)val );
+         }
+         break;
+
+      case eDB2_FIELD_ENUM_SIGNED:
+         if (GetInteger( value, LONG_MIN, LONG_MAX, val ) == true)
+         {
+            rc = mBitsy.Set( field.mSize, (LONG)val );
+         }
+         break;
+
+      default:
+         break;
+   }      
+
+   if (rc == NO_ERROR)
+   {
+      // Success!
+      if (bRecord == true)
+      {
+         std::pair <ULONG, LONGLONG> entry( field.mID, val );
+         mValues.push_back( entry );
+      }
+
+      bOK = true;
+   }
+
+   return bOK;
+}
+
+/*===========================================================================
+METHOD:
+   PackFixed (Internal Method)
+
+DESCRIPTION:
+   Pack the typed values using the compiled layout of the entity (the
+   decoding operations double as packing operations since the offset
+   of each field is known up front), the buffer is identical to the
+   one navigating the entity would produce
+  
+PARAMETERS:
+   navTree     [ I ] - Nav tree of the (fixed layout) entity
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cDataPacker::PackFixed( const cDB2NavTree & navTree )
+{
+   const std::vector <sDB2DecodeOp> & ops = navTree.GetDecodeOps();
+
+   ULONG opCount = (ULONG)ops.size();
+   if (opCount != (ULONG)mTypedValues.size())
+   {
+      return false;
+   }
+
+   for (ULONG o = 0; o < opCount; o++)
+   {
+      // Order switches were checked for alignment when compiling
+      const sDB2DecodeOp & op = ops[o];
+      mBitsy.SetLSBMode( op.mbLSB );
+      mBitsy.SetOffset( op.mOffset );
+
+      bool bOK = PackValue( *op.mpField, mTypedValues[o] );
+      if (bOK == false)
+      {
+         return false;
+      }
+   }
+
+   // Account for any trailing padding
+   mBitsy.SetOffset( navTree.GetFixedBits() );
+   return true;
+}
+
 /*===========================================================================
 METHOD:
    ProcessField (Internal Method)
@@ -515,6 +866,17 @@ bool cDataPacker::ProcessField(
       return bOK;
    }
 
+   // Typed values are packed as is, in field order
+   if (mbTyped == true)
+   {
+      if (mProcessedFields < (ULONG)mTypedValues.size())
+      {
+         bOK = PackValue( *pField, mTypedValues[mProcessedFields++] );
+      }
+
+      return bOK;
+   }
+
    // Find given value for field
    LPCSTR pVal = 0;
    bool bVal = GetValueString( *pField, fieldName, pVal );
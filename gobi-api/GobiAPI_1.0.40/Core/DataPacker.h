@@ -57,6 +57,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "BitPacker.h"
 #include "SharedBuffer.h"
 #include "ProtocolEntityNav.h"
+#include "DB2NavTree.h"
 
 #include <list>
 #include <vector>
@@ -94,6 +95,113 @@ struct sUnpackedField
       std::string mName;
 };
 
+/*=========================================================================*/
+// Struct sDataPackerValue
+//
+//    Structure to represent a typed (input) field value, integer values 
+//    (including enums) must fit the type the field is packed as, floating
+//    point values are converted as needed and strings are not copied
+/*=========================================================================*/
+struct sDataPackerValue
+{
+   public:
+      // (Inline) Constructor - default
+      sDataPackerValue()
+         :  mValue( 0 ),
+            mFloat( 0.0 ),
+            mpString( 0 ),
+            mbSigned( false ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - signed integer
+      sDataPackerValue( INT val )
+         :  mValue( (ULONGLONG)(LONGLONG)val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( true ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - unsigned integer
+      sDataPackerValue( UINT val )
+         :  mValue( (ULONGLONG)val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( false ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - signed integer
+      sDataPackerValue( LONG val )
+         :  mValue( (ULONGLONG)(LONGLONG)val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( true ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - unsigned integer
+      sDataPackerValue( ULONG val )
+         :  mValue( (ULONGLONG)val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( false ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - signed integer
+      sDataPackerValue( LONGLONG val )
+         :  mValue( (ULONGLONG)val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( true ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - unsigned integer
+      sDataPackerValue( ULONGLONG val )
+         :  mValue( val ),
+            mFloat( (DOUBLE)val ),
+            mpString( 0 ),
+            mbSigned( false ),
+            mbFloat( false )
+      { };
+
+      // (Inline) Constructor - floating point
+      sDataPackerValue( DOUBLE val )
+         :  mValue( 0 ),
+            mFloat( val ),
+            mpString( 0 ),
+            mbSigned( false ),
+            mbFloat( true )
+      { };
+
+      // (Inline) Constructor - string (not copied)
+      sDataPackerValue( LPCSTR pStr )
+         :  mValue( 0 ),
+            mFloat( 0.0 ),
+            mpString( pStr ),
+            mbSigned( false ),
+            mbFloat( false )
+      { };
+
+      /* Integer value (two's complement when signed) */
+      ULONGLONG mValue;
+
+      /* Floating point value */
+      DOUBLE mFloat;
+
+      /* String value (0 = not a string) */
+      LPCSTR mpString;
+
+      /* Is the integer value signed? */
+      bool mbSigned;
+
+      /* Is this a floating point value? */
+      bool mbFloat;
+};
+
 /*=========================================================================*/
 // Class cDataPacker
 //    Class to pack bit/byte specified fields into a buffer
@@ -106,6 +214,12 @@ class cDataPacker : public cProtocolEntityNav
          const cCoreDatabase &               db,
          const std::vector <ULONG> &         key,
          const std::list <sUnpackedField> &  fields );
+
+      // Constructor (typed values, in field order)
+      cDataPacker( 
+         const cCoreDatabase &                  db,
+         const std::vector <ULONG> &            key,
+         const std::vector <sDataPackerValue> & values );
          
       // Destructor
       virtual ~cDataPacker();
@@ -146,6 +260,14 @@ class cDataPacker : public cProtocolEntityNav
          ULONG                      numChars,
          LPCSTR                     pStr );
 
+      // Pack the typed value into the buffer as the given field
+      virtual bool PackValue(
+         const sDB2Field &          field,
+         const sDataPackerValue &   value );
+
+      // Pack the typed values using the compiled layout of the entity
+      virtual bool PackFixed( const cDB2NavTree & navTree );
+
       // Process the given field 
       virtual bool ProcessField(
          const sDB2Field *          pField,
@@ -201,10 +323,16 @@ class cDataPacker : public cProtocolEntityNav
       /* The vector of fields */
       std::vector <sUnpackedField> mFields;
 
+      /* Typed values (in field order) */
+      std::vector <sDataPackerValue> mTypedValues;
+
       /* Are we operating in value only mode, i.e. no field names given? */
       bool mbValuesOnly;
       ULONG mProcessedFields;
 
+      /* Are we packing typed values (rather than value strings)? */
+      bool mbTyped;
+
       /* Raw field values associated with field ID */
       std::list < std::pair <ULONG, LONGLONG> > mValues;
 
@@ -10,6 +10,9 @@ PUBLIC CLASSES AND METHODS:
    HDLCDecode()
    HDLCEncode()
 
+   cHDLCDecoder
+      Incremental decoder extracting HDLC frames from a byte stream
+
 Copyright (c) 2011, Code Aurora Forum. All rights reserved.
 
 Redistribution and use in source and binary forms, with or without
@@ -231,6 +234,274 @@ sSharedBuffer * HDLCEncode( sSharedBuffer * pBuf )
    return pRet;
 }
 
+/*=========================================================================*/
+// cHDLCDecoder Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cHDLCDecoder (Public Method)
+
+DESCRIPTION:
+   Constructor
+
+PARAMETERS:
+   maxFrameSize   [ I ] - Maximum size of a decoded frame (including CRC)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cHDLCDecoder::cHDLCDecoder( ULONG maxFrameSize )
+   :  mpFrame( 0 ),
+      mMaxFrameSize( 0 ),
+      mFrameLen( 0 ),
+      mEncodedLen( 0 ),
+      mCRC( CRC_16_L_SEED ),
+      mbInEscape( false ),
+      mbHunting( false )
+{
+   memset( (LPVOID)&mStats, 0, sizeof( mStats ) );
+
+   if (maxFrameSize > 0)
+   {
+      mpFrame = new BYTE[maxFrameSize];
+      if (mpFrame != 0)
+      {
+         mMaxFrameSize = maxFrameSize;
+      }
+   }
+}
+
+/*===========================================================================
+METHOD:
+   ~cHDLCDecoder (Public Method)
+
+DESCRIPTION:
+   Destructor
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cHDLCDecoder::~cHDLCDecoder()
+{
+   if (mpFrame != 0)
+   {
+      delete [] mpFrame;
+      mpFrame = 0;
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Decode (Public Method)
+
+DESCRIPTION:
+   Decode data until a valid frame is complete or the data is used up,
+   invalid frames are dropped (and accounted for in the statistics)
+
+   A frame is returned as a view into the decode buffer (CRC removed)
+   that is only valid until the next call to Decode() or Reset(), the
+   remainder of the data (bytesUsed onwards) must be passed to Decode()
+   again to continue decoding
+  
+PARAMETERS:
+   pData       [ I ] - Data to decode
+   dataLen     [ I ] - Length of above data
+   bytesUsed   [ O ] - Number of bytes of the above data processed
+   pFrame      [ O ] - The decoded frame (0 if none)
+   frameLen    [ O ] - Length of the decoded frame
+
+RETURN VALUE:
+   bool - Was a valid frame decoded?
+===========================================================================*/
+bool cHDLCDecoder::Decode( 
+   const BYTE *               pData,
+   ULONG                      dataLen,
+   ULONG &                    bytesUsed,
+   const BYTE * &             pFrame,
+   ULONG &                    frameLen )
+{
+   bytesUsed = dataLen;
+   pFrame = 0;
+   frameLen = 0;
+
+   if (pData == 0 || mpFrame == 0)
+   {
+      return false;
+   }
+
+   const BYTE * pIn = pData;
+   const BYTE * pEnd = pData + dataLen;
+   while (pIn < pEnd)
+   {
+      // Skipping data until the next flag?
+      if (mbHunting == true)
+      {
+         const BYTE * pFlag = 0;
+         pFlag = (const BYTE *)memchr( (LPCVOID)pIn, AHDLC_FLAG, pEnd - pIn );
+         if (pFlag == 0)
+         {
+            mStats.mBytesDiscarded += (ULONGLONG)(pEnd - pIn);
+            break;
+         }
+
+         // Resume decoding after the flag
+         mStats.mBytesDiscarded += (ULONGLONG)(pFlag - pIn);
+         pIn = pFlag + 1;
+
+         mbHunting = false;
+         StartFrame();
+         continue;
+      }
+
+      BYTE val = *pIn;
+      if (val == AHDLC_FLAG)
+      {
+         pIn++;
+
+         // An escaped flag aborts the frame
+         if (mbInEscape == true)
+         {
+            mStats.mResyncs++;
+            DropFrame();
+            continue;
+         }
+
+         // Nothing since the last flag?
+         if (mEncodedLen == 0)
+         {
+            continue;
+         }
+
+         // Is this a valid frame?
+         if ( (mFrameLen > (ULONG)CRC_SIZE)
+         &&   ((USHORT)~mCRC == CRC_16_L_OK) )
+         {
+            mStats.mFrames++;
+
+            pFrame = mpFrame;
+            frameLen = mFrameLen - (ULONG)CRC_SIZE;
+            bytesUsed = (ULONG)(pIn - pData);
+
+            StartFrame();
+            return true;
+         }
+
+         mStats.mCRCErrors++;
+         DropFrame();
+         continue;
+      }
+
+      if (mbInEscape == true || val == AHDLC_ESCAPE)
+      {
+         pIn++;
+         mEncodedLen++;
+
+         // Was the previous byte an escape byte?
+         if (mbInEscape == false)
+         {
+            // No, but this one is
+            mbInEscape = true;
+            continue;
+         }
+
+         mbInEscape = false;
+         if (mFrameLen >= mMaxFrameSize)
+         {
+            // Target spewing nonsense, drop the frame and resynchronize
+            mStats.mResyncs++;
+            DropFrame();
+
+            mbHunting = true;
+            continue;
+         }
+
+         val ^= AHDLC_ESC_M;
+         mCRC = UpdateCRC( mCRC, &val, 1 );
+         mpFrame[mFrameLen++] = val;
+         continue;
+      }
+
+      // A run of regular bytes, add them in one go
+      const BYTE * pRun = pIn + 1;
+      while (pRun < pEnd && *pRun != AHDLC_FLAG && *pRun != AHDLC_ESCAPE)
+      {
+         pRun++;
+      }
+
+      ULONG runLen = (ULONG)(pRun - pIn);
+      if (runLen > mMaxFrameSize - mFrameLen)
+      {
+         // Target spewing nonsense, drop the frame and resynchronize (the
+         // run itself is accounted for while hunting for the next flag)
+         mStats.mResyncs++;
+         DropFrame();
+
+         mbHunting = true;
+         continue;
+      }
+
+      memcpy( (LPVOID)(mpFrame + mFrameLen), (LPCVOID)pIn, runLen );
+      mCRC = UpdateCRC( mCRC, pIn, runLen );
+      mFrameLen += runLen;
+      mEncodedLen += runLen;
+
+      pIn = pRun;
+   }
+
+   return false;
+}
+
+/*===========================================================================
+METHOD:
+   Reset (Public Method)
+
+DESCRIPTION:
+   Discard any frame in progress (without affecting the statistics)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cHDLCDecoder::Reset()
+{
+   mbHunting = false;
+   StartFrame();
+}
+
+/*===========================================================================
+METHOD:
+   StartFrame (Internal Method)
+
+DESCRIPTION:
+   Start decoding a new frame
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cHDLCDecoder::StartFrame()
+{
+   mFrameLen = 0;
+   mEncodedLen = 0;
+   mCRC = CRC_16_L_SEED;
+   mbInEscape = false;
+}
+
+/*===========================================================================
+METHOD:
+   DropFrame (Internal Method)
+
+DESCRIPTION:
+   Drop the frame in progress, accounting for the discarded bytes
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cHDLCDecoder::DropFrame()
+{
+   mStats.mBytesDiscarded += mEncodedLen;
+   StartFrame();
+}
+
 /*===========================================================================
 METHOD:
    HDLCUnitTest (Free Method)
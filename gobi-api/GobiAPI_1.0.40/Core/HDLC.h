@@ -10,6 +10,12 @@ PUBLIC CLASSES AND METHODS:
    HDLCDecode()
    HDLCEncode()
 
+   sHDLCDecodeStats
+      Framing statistics of a cHDLCDecoder
+
+   cHDLCDecoder
+      Incremental decoder extracting HDLC frames from a byte stream
+
 Copyright (c) 2011, Code Aurora Forum. All rights reserved.
 
 Redistribution and use in source and binary forms, with or without
@@ -62,6 +68,94 @@ sSharedBuffer * HDLCEncode( sSharedBuffer * pBuf );
 // HDLC decode the given buffer returning the results in an allocated buffer
 sSharedBuffer * HDLCDecode( sSharedBuffer * pBuf );
 
+/*=========================================================================*/
+// Struct sHDLCDecodeStats
+//
+//    Framing statistics of a cHDLCDecoder
+/*=========================================================================*/
+struct sHDLCDecodeStats
+{
+   /* Number of valid frames decoded */
+   ULONG mFrames;
+
+   /* Number of frames dropped for failing the CRC check (or for being
+      too short to contain one) */
+   ULONG mCRCErrors;
+
+   /* Number of times the decoder dropped a frame in progress and resumed 
+      at the next flag (frame too large or aborted by the sender) */
+   ULONG mResyncs;
+
+   /* Number of (encoded) bytes dropped for any of the above reasons */
+   ULONGLONG mBytesDiscarded;
+};
+
+/*=========================================================================*/
+// Class cHDLCDecoder
+//
+//    Incremental decoder extracting HDLC frames from a byte stream that
+//    may deliver frames in arbitrary pieces, the CRC is computed as the
+//    bytes are unescaped and frames are decoded into a single buffer 
+//    that is reused for every frame
+/*=========================================================================*/
+class cHDLCDecoder
+{
+   public:
+      // Constructor
+      cHDLCDecoder( ULONG maxFrameSize );
+
+      // Destructor
+      ~cHDLCDecoder();
+
+      // Decode data until a valid frame is complete or the data is used up
+      bool Decode( 
+         const BYTE *               pData,
+         ULONG                      dataLen,
+         ULONG &                    bytesUsed,
+         const BYTE * &             pFrame,
+         ULONG &                    frameLen );
+
+      // Discard any frame in progress
+      void Reset();
+
+      // (Inline) Return the framing statistics
+      const sHDLCDecodeStats & GetStats() const
+      {
+         return mStats;
+      };
+
+   protected:
+      // Start decoding a new frame
+      void StartFrame();
+
+      // Drop the frame in progress, accounting for the discarded bytes
+      void DropFrame();
+
+      /* Decode buffer (frame contents plus CRC) */
+      BYTE * mpFrame;
+
+      /* Size of above buffer */
+      ULONG mMaxFrameSize;
+
+      /* Number of bytes decoded into the above buffer */
+      ULONG mFrameLen;
+
+      /* Number of (encoded) bytes received for the above frame */
+      ULONG mEncodedLen;
+
+      /* Running CRC value of the above frame */
+      USHORT mCRC;
+
+      /* Was the previous byte an escape byte? */
+      bool mbInEscape;
+
+      /* Are we skipping data until the next flag? */
+      bool mbHunting;
+
+      /* Framing statistics */
+      sHDLCDecodeStats mStats;
+};
+
 #ifdef DEBUG
 
 // Simple in = out testing of HDLCEncode/HDLCDecode
@@ -81,15 +81,9 @@ cHDLCProtocolServer::cHDLCProtocolServer(
    :  cProtocolServer( rxType, txType, bufferSzRx, logSz ),
       mRxType( rxType ),
       mpEncodedBuffer( 0 ),
-      mpRxDecodeBuffer( 0 ),
-      mRxDecodeOffset( 0 ),
-      mbInEscape( false )
+      mRxDecoder( MAX_SHARED_BUFFER_SIZE + (ULONG)CRC_SIZE )
 {
-   // Allocate decode buffer?
-   if (mRxBufferSize > 0)
-   {
-      mpRxDecodeBuffer = new BYTE[mRxBufferSize * 4];
-   }
+   // Nothing to do
 }
 
 /*===========================================================================
@@ -114,12 +108,34 @@ cHDLCProtocolServer::~cHDLCProtocolServer()
       mpEncodedBuffer = 0;
    }
 
-   // Free decode buffer?
-   if (mpRxDecodeBuffer != 0)
+}
+
+/*===========================================================================
+METHOD:
+   GetRxStats (Public Method)
+
+DESCRIPTION:
+   Return a snapshot of the framing statistics for incoming data, the
+   statistics are only updated with the schedule mutex held
+
+SEQUENCING:
+   This function will block until the schedule mutex is aquired
+
+RETURN VALUE:
+   sHDLCDecodeStats - All zero if the schedule mutex can't be aquired
+===========================================================================*/
+sHDLCDecodeStats cHDLCProtocolServer::GetRxStats()
+{
+   sHDLCDecodeStats stats;
+   memset( (LPVOID)&stats, 0, sizeof( stats ) );
+
+   if (GetScheduleMutex() == true)
    {
-      delete [] mpRxDecodeBuffer;
-      mpRxDecodeBuffer = 0;
+      stats = mRxDecoder.GetStats();
+      ReleaseScheduleMutex( false );
    }
+
+   return stats;
 }
 
 /*===========================================================================
@@ -238,84 +254,57 @@ bool cHDLCProtocolServer::DecodeRxData(
    bool bRC = false;
    rspIdx = INVALID_LOG_INDEX;
 
-   // Something to decode from/to?
-   if (bytesReceived == 0 || mpRxDecodeBuffer == 0)
+   // Something to decode?
+   if (bytesReceived == 0)
    {
       return bRC;
    }
 
-   BYTE val;
    ULONG idx = 0;
-   ULONG maxSz = mRxBufferSize * 4;
-   
    while (idx < bytesReceived)
    {
-      val = mpRxBuffer[idx++];
-     
-      // Check for target spewing nonsense
-      if (mRxDecodeOffset >= maxSz)
-      {
-         // Reset to beginning
-         mRxDecodeOffset = 0;
-      }
-      
-      // Was the previous byte an escape byte?
-      if (mbInEscape == true)
+      // Decode up to the end of the next valid frame
+      ULONG bytesUsed = 0;
+      const BYTE * pFrame = 0;
+      ULONG frameLen = 0;
+
+      bool bFrame = mRxDecoder.Decode( mpRxBuffer + idx,
+                                       bytesReceived - idx,
+                                       bytesUsed,
+                                       pFrame,
+                                       frameLen );
+
+      idx += bytesUsed;
+      if (bFrame == false)
       {
-         // Yes, handle it
-         mbInEscape = false;
-            
-         val ^= AHDLC_ESC_M;
-         mpRxDecodeBuffer[mRxDecodeOffset++] = val;
+         break;
       }
-      else if (val == AHDLC_ESCAPE) 
-      {
-         // No, but this one is
-         mbInEscape = true;
-      }
-      else if (val == AHDLC_FLAG)
+
+      // Extract the frame (minus CRC) to a shared buffer
+      sSharedBuffer * pTmp = 0;
+      pTmp = new sSharedBuffer( pFrame, frameLen, (ULONG)mRxType );
+
+      if (pTmp != 0)
       {
-         // Is this a valid frame?
-         if ( (mRxDecodeOffset > 0)
-         &&   (CheckCRC( mpRxDecodeBuffer, mRxDecodeOffset ) == true) )
-         {
-            // Yes, extract it (minus CRC) to a shared buffer
-            sSharedBuffer * pTmp = 0;
-            pTmp = new sSharedBuffer( mpRxDecodeBuffer, 
-                                      mRxDecodeOffset - 2, 
-                                      (ULONG)mRxType );
+         sProtocolBuffer tmpPB( pTmp );
+         ULONG tmpIdx = mLog.AddBuffer( tmpPB );
 
-            if (pTmp != 0)
+         // Abort?
+         bool bTmpAbortTx = IsTxAbortResponse( tmpPB );
+         if (bTmpAbortTx == true)
+         {
+            bAbortTx = true;
+         }
+         else
+         {
+            // Is this the response we are looking for?
+            bool bRsp = IsResponse( tmpPB );
+            if (bRsp == true)
             {
-               sProtocolBuffer tmpPB( pTmp );
-               ULONG tmpIdx = mLog.AddBuffer( tmpPB );
-
-               // Abort?
-               bool bTmpAbortTx = IsTxAbortResponse( tmpPB );
-               if (bTmpAbortTx == true)
-               {
-                  bAbortTx = true;
-               }
-               else
-               {
-                  // Is this the response we are looking for?
-                  bool bRsp = IsResponse( tmpPB );
-                  if (bRsp == true)
-                  {
-                     rspIdx = tmpIdx;
-                     bRC = true;
-                  }
-               }
+               rspIdx = tmpIdx;
+               bRC = true;
             }
          }
-
-         // Reset for next frame
-         mRxDecodeOffset = 0;
-      }  
-      else
-      {
-         // No, just a regular value
-         mpRxDecodeBuffer[mRxDecodeOffset++] = val;
       }
    }
 
@@ -45,6 +45,7 @@ POSSIBILITY OF SUCH DAMAGE.
 // Include Files
 //---------------------------------------------------------------------------
 #include "ProtocolServer.h"
+#include "HDLC.h"
 
 //---------------------------------------------------------------------------
 // Definitions
@@ -66,6 +67,9 @@ class cHDLCProtocolServer : public cProtocolServer
       // Destructor
       virtual ~cHDLCProtocolServer();
 
+      // Return a snapshot of the framing statistics for incoming data
+      sHDLCDecodeStats GetRxStats();
+
    protected:
       // Perform protocol specific communications port initialization
       virtual bool InitializeComm();
@@ -96,12 +100,6 @@ class cHDLCProtocolServer : public cProtocolServer
       /* Encoded data being transmitted */
       sSharedBuffer * mpEncodedBuffer;
 
-      /* Decode buffer for incoming data */
-      BYTE * mpRxDecodeBuffer;
-
-      /* Current index into above buffer */
-      ULONG mRxDecodeOffset;
-
-      /* Are we currently escaping a character? */
-      bool mbInEscape;
+      /* Decoder for incoming data */
+      cHDLCDecoder mRxDecoder;
 };
@@ -460,7 +460,7 @@ bool cProtocolEntityNav::ProcessEntity( const std::vector <ULONG> & key )
    }
 
    // Grab navigation fragments   
-   const std::list <sDB2NavFragment *> & frags = pNavTree->GetFragments();
+   const std::vector <sDB2NavFragment> & frags = pNavTree->GetFragments();
 
    // Nothing to navigate?
    if (frags.size() == 0)
@@ -483,7 +483,7 @@ bool cProtocolEntityNav::ProcessEntity( const std::vector <ULONG> & key )
 
    // Process the initial structure
    EnterStruct( mEntity.mpName, -1 );
-   bRC = ProcessStruct( frags.front(), preamble, -1 );
+   bRC = ProcessStruct( &frags.front(), preamble, -1 );
    ExitStruct( mEntity.mpName, -1 );
    
    return bRC;
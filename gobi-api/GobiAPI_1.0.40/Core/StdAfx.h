@@ -55,6 +55,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <time.h>
 #include <sys/time.h>
 #include <sys/ioctl.h>
+#include <endian.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 
@@ -0,0 +1,443 @@
+/*===========================================================================
+FILE:
+   test-bits.cpp
+
+DESCRIPTION:
+   Differential test of cBitParser/cBitPacker against a bit by bit
+   reference implementation
+
+   Every supported type (8/16/32/64-bit, signed and unsigned, as far as
+   the platform provides them) is checked in both bit orders, for every
+   width of the type and every start offset within the first eight bytes,
+   using buffers that end exactly after the value
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "BitParser.h"
+#include "BitPacker.h"
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Start offsets checked, every position within a 64-bit window
+const ULONG TEST_MAX_START_OFFSET = MAX_TYPE_BITS;
+
+// Random values checked for each type/order/width/offset
+const ULONG TEST_VALUES = 4;
+
+// Number of failures reported before giving up
+const ULONG TEST_MAX_FAILURES = 20;
+
+// Number of cases checked/failed so far
+ULONG gCases = 0;
+ULONG gFailures = 0;
+
+/*=========================================================================*/
+// Free Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   NextRandom (Free Method)
+
+DESCRIPTION:
+   Return the next value of a fixed seed pseudo-random sequence (64-bit
+   xorshift), so every run checks the same cases
+
+RETURN VALUE:
+   ULONGLONG
+===========================================================================*/
+ULONGLONG NextRandom()
+{
+   static ULONGLONG state = 0x9E3779B97F4A7C15ULL;
+
+   state ^= state << 13;
+   state ^= state >> 7;
+   state ^= state << 17;
+   return state;
+}
+
+/*===========================================================================
+METHOD:
+   RefGetBit (Free Method)
+
+DESCRIPTION:
+   Return the bit found at the given bit offset of a buffer
+
+PARAMETERS:
+   pData       [ I ] - Data buffer
+   offset      [ I ] - Bit offset into above buffer
+   bLSB        [ I ] - Bits are numbered LSB -> MSB within a byte?
+
+RETURN VALUE:
+   ULONGLONG
+===========================================================================*/
+ULONGLONG RefGetBit(
+   const BYTE *               pData,
+   ULONG                      offset,
+   bool                       bLSB )
+{
+   ULONG shift = offset % BITS_PER_BYTE;
+   if (bLSB == false)
+   {
+      shift = BITS_PER_BYTE - 1 - shift;
+   }
+
+   return (ULONGLONG)((pData[offset / BITS_PER_BYTE] >> shift) & 1);
+}
+
+/*===========================================================================
+METHOD:
+   RefGet (Free Method)
+
+DESCRIPTION:
+   Reference parser, extract a value one bit at a time (the first bit
+   being the least significant one when parsing LSB -> MSB and the most
+   significant one otherwise)
+
+PARAMETERS:
+   pData       [ I ] - Data buffer
+   offset      [ I ] - Bit offset into above buffer
+   numBits     [ I ] - Number of bits to extract
+   bLSB        [ I ] - Parse LSB -> MSB?
+
+RETURN VALUE:
+   ULONGLONG - The bits extracted (not sign extended)
+===========================================================================*/
+ULONGLONG RefGet(
+   const BYTE *               pData,
+   ULONG                      offset,
+   ULONG                      numBits,
+   bool                       bLSB )
+{
+   ULONGLONG val = 0;
+   for (ULONG b = 0; b < numBits; b++)
+   {
+      ULONGLONG bit = RefGetBit( pData, offset + b, bLSB );
+      if (bLSB == true)
+      {
+         val |= bit << b;
+      }
+      else
+      {
+         val |= bit << (numBits - 1 - b);
+      }
+   }
+
+   return val;
+}
+
+/*===========================================================================
+METHOD:
+   RefSet (Free Method)
+
+DESCRIPTION:
+   Reference packer, OR a value into a buffer one bit at a time (the
+   inverse of RefGet())
+
+PARAMETERS:
+   pData       [ O ] - Data buffer
+   offset      [ I ] - Bit offset into above buffer
+   numBits     [ I ] - Number of bits to write
+   val         [ I ] - Value to write
+   bLSB        [ I ] - Pack LSB -> MSB?
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void RefSet(
+   BYTE *                     pData,
+   ULONG                      offset,
+   ULONG                      numBits,
+   ULONGLONG                  val,
+   bool                       bLSB )
+{
+   for (ULONG b = 0; b < numBits; b++)
+   {
+      ULONGLONG bit = val >> b;
+      if (bLSB == false)
+      {
+         bit = val >> (numBits - 1 - b);
+      }
+
+      if ((bit & 1) == 0)
+      {
+         continue;
+      }
+
+      ULONG pos = offset + b;
+      ULONG shift = pos % BITS_PER_BYTE;
+      if (bLSB == false)
+      {
+         shift = BITS_PER_BYTE - 1 - shift;
+      }
+
+      pData[pos / BITS_PER_BYTE] |= (BYTE)(1 << shift);
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Expected (Free Method)
+
+DESCRIPTION:
+   Convert the bits extracted by RefGet() into the value expected for
+   the given type, i.e. sign extend them for signed types
+
+PARAMETERS:
+   bits        [ I ] - Bits extracted
+   numBits     [ I ] - Number of bits extracted
+
+RETURN VALUE:
+   T
+===========================================================================*/
+template <class T>
+T Expected(
+   ULONGLONG                  bits,
+   ULONG                      numBits )
+{
+   bool bSigned = ((T)-1 < (T)0);
+   if ( (bSigned == true)
+   &&   (numBits < MAX_TYPE_BITS)
+   &&   (((bits >> (numBits - 1)) & 1) == 1) )
+   {
+      bits |= ~(ULONGLONG)0 << numBits;
+   }
+
+   return (T)bits;
+}
+
+/*===========================================================================
+METHOD:
+   Fail (Free Method)
+
+DESCRIPTION:
+   Report a failed case
+
+PARAMETERS:
+   pWhat       [ I ] - What failed
+   pType       [ I ] - Type name
+   numBits     [ I ] - Width
+   offset      [ I ] - Start offset
+   bLSB        [ I ] - Bit order
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void Fail(
+   LPCSTR                     pWhat,
+   LPCSTR                     pType,
+   ULONG                      numBits,
+   ULONG                      offset,
+   bool                       bLSB )
+{
+   gFailures++;
+   if (gFailures <= TEST_MAX_FAILURES)
+   {
+      fprintf( stderr,
+               "FAIL: %s (%s, %lu bits at offset %lu, %s)\n",
+               pWhat,
+               pType,
+               numBits,
+               offset,
+               bLSB ? "LSB" : "MSB" );
+   }
+}
+
+/*===========================================================================
+METHOD:
+   CheckCase (Free Method)
+
+DESCRIPTION:
+   Check parsing and packing of a single value against the reference
+   implementation
+
+PARAMETERS:
+   pType       [ I ] - Type name
+   numBits     [ I ] - Width
+   offset      [ I ] - Start offset
+   bLSB        [ I ] - Bit order
+
+RETURN VALUE:
+   None
+===========================================================================*/
+template <class T>
+void CheckCase(
+   LPCSTR                     pType,
+   ULONG                      numBits,
+   ULONG                      offset,
+   bool                       bLSB )
+{
+   // Buffers end exactly after the value, so any access beyond that
+   // is caught by memory checkers
+   ULONG maxOffset = offset + numBits;
+   ULONG bufSz = (maxOffset + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+
+   BYTE * pData = new BYTE[bufSz];
+   BYTE * pRef = new BYTE[bufSz];
+   for (ULONG b = 0; b < bufSz; b++)
+   {
+      pData[b] = (BYTE)NextRandom();
+   }
+
+   gCases++;
+
+   // Parse
+   cBitParser parser( pData, maxOffset );
+   parser.SetLSBMode( bLSB );
+   parser.SetOffset( offset );
+
+   T val = 0;
+   DWORD rc = parser.Get( numBits, val );
+   T expected = Expected <T>( RefGet( pData, offset, numBits, bLSB ),
+                              numBits );
+
+   if (rc != NO_ERROR || val != expected)
+   {
+      Fail( "parsed value", pType, numBits, offset, bLSB );
+   }
+   else if (parser.GetNumBitsParsed() != maxOffset)
+   {
+      Fail( "parsed offset", pType, numBits, offset, bLSB );
+   }
+
+   // Parse one bit short of the value
+   cBitParser shortParser( pData, maxOffset - 1 );
+   shortParser.SetLSBMode( bLSB );
+   shortParser.SetOffset( offset );
+
+   rc = shortParser.Get( numBits, val );
+   if ( (rc != ERROR_NOT_ENOUGH_MEMORY)
+   ||   (shortParser.GetNumBitsParsed() != offset) )
+   {
+      Fail( "parsed past the end", pType, numBits, offset, bLSB );
+   }
+
+   // Pack over existing contents (bits are ORed in)
+   val = (T)NextRandom();
+   memcpy( (LPVOID)pRef, (LPCVOID)pData, bufSz );
+   RefSet( pRef, offset, numBits, (ULONGLONG)val, bLSB );
+
+   cBitPacker packer( pData, maxOffset );
+   packer.SetLSBMode( bLSB );
+   packer.SetOffset( offset );
+
+   rc = packer.Set( numBits, val );
+   if (rc != NO_ERROR || memcmp( pData, pRef, bufSz ) != 0)
+   {
+      Fail( "packed bytes", pType, numBits, offset, bLSB );
+   }
+   else if (packer.GetNumBitsWritten() != maxOffset)
+   {
+      Fail( "packed offset", pType, numBits, offset, bLSB );
+   }
+
+   // Pack one bit short of the value
+   cBitPacker shortPacker( pData, maxOffset - 1 );
+   shortPacker.SetLSBMode( bLSB );
+   shortPacker.SetOffset( offset );
+
+   if (maxOffset - 1 > offset)
+   {
+      rc = shortPacker.Set( numBits, val );
+      if ( (rc != ERROR_NOT_ENOUGH_MEMORY)
+      ||   (shortPacker.GetNumBitsWritten() != offset)
+      ||   (memcmp( pData, pRef, bufSz ) != 0) )
+      {
+         Fail( "packed past the end", pType, numBits, offset, bLSB );
+      }
+   }
+
+   delete [] pData;
+   delete [] pRef;
+}
+
+/*===========================================================================
+METHOD:
+   CheckType (Free Method)
+
+DESCRIPTION:
+   Check every width, start offset and bit order of a type
+
+PARAMETERS:
+   pType       [ I ] - Type name
+
+RETURN VALUE:
+   None
+===========================================================================*/
+template <class T>
+void CheckType( LPCSTR pType )
+{
+   const ULONG TYPE_BIT_COUNT = (ULONG)(sizeof( T ) * BITS_PER_BYTE);
+
+   for (ULONG o = 0; o < 2; o++)
+   {
+      bool bLSB = (o == 0);
+      for (ULONG numBits = 1; numBits <= TYPE_BIT_COUNT; numBits++)
+      {
+         for (ULONG offset = 0; offset < TEST_MAX_START_OFFSET; offset++)
+         {
+            for (ULONG v = 0; v < TEST_VALUES; v++)
+            {
+               CheckCase <T>( pType, numBits, offset, bLSB );
+            }
+         }
+      }
+   }
+}
+
+/*===========================================================================
+METHOD:
+   main (Public Method)
+
+DESCRIPTION:
+   Run all checks
+
+RETURN VALUE:
+   int - 0 upon success
+===========================================================================*/
+int main()
+{
+   CheckType <CHAR>( "CHAR" );
+   CheckType <UCHAR>( "UCHAR" );
+   CheckType <SHORT>( "SHORT" );
+   CheckType <USHORT>( "USHORT" );
+   CheckType <LONG>( "LONG" );
+   CheckType <ULONG>( "ULONG" );
+   CheckType <LONGLONG>( "LONGLONG" );
+   CheckType <ULONGLONG>( "ULONGLONG" );
+
+   printf( "%lu cases, %lu failures\n", gCases, gFailures );
+   return (gFailures == 0 ? 0 : 1);
+}
@@ -0,0 +1,140 @@
+/*===========================================================================
+FILE:
+   DB2Compile.cpp
+
+DESCRIPTION:
+   Build time compiler turning the database text tables into a compiled
+   (binary) database image that cCoreDatabase can use in place
+
+PUBLIC CLASSES AND FUNCTIONS:
+   cDB2CompileLog
+   main
+
+Copyright (c) 2011, Code Aurora Forum. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of Code Aurora Forum nor
+      the names of its contributors may be used to endorse or promote
+      products derived from this software without specific prior written
+      permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+==========================================================================*/
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "CoreDatabase.h"
+
+#include <unistd.h>
+
+/*=========================================================================*/
+// Class cDB2CompileLog
+//    Status log sending all database load messages to stderr
+/*=========================================================================*/
+class cDB2CompileLog : public cDB2StatusLog
+{
+   public:
+      // (Inline) Log an error string
+      virtual void Log(
+         LPCSTR                    pLog,
+         eDB2StatusLevel           lvl = eDB2_STATUS_ERROR )
+      {
+         if (pLog != 0 && pLog[0] != 0)
+         {
+            fprintf( stderr, "[0x%02X] %s\n", (UINT)lvl, pLog );
+         }
+      };
+
+      // (Inline) Log an error string
+      virtual void Log(
+         const std::string &        log,
+         eDB2StatusLevel            lvl = eDB2_STATUS_ERROR )
+      {
+         Log( log.c_str(), lvl );
+      };
+};
+
+//---------------------------------------------------------------------------
+// Free Methods
+//---------------------------------------------------------------------------
+
+/*===========================================================================
+METHOD:
+   main (Public Method)
+
+DESCRIPTION:
+   Load (and validate) the database text tables found in the given
+   directory and save them as a compiled database image
+
+   Usage: DB2Compile <database directory> <image file>
+
+RETURN VALUE:
+   int - 0 upon success
+===========================================================================*/
+int main( int argc, char ** argv )
+{
+   if (argc != 3)
+   {
+      fprintf( stderr, "Usage: %s <database directory> <image file>\n",
+               argv[0] );
+
+      return 1;
+   }
+
+   cDB2CompileLog log;
+
+   cCoreDatabase db;
+   db.SetLog( &log );
+
+   // Any load or validation error fails the build
+   bool bRC = db.Initialize( argv[1] );
+   if (bRC == false)
+   {
+      fprintf( stderr, "%s: invalid database \'%s\'\n", argv[0], argv[1] );
+      return 1;
+   }
+
+   bRC = db.SaveImage( argv[2] );
+   if (bRC == false)
+   {
+      fprintf( stderr, "%s: unable to save \'%s\'\n", argv[0], argv[2] );
+      return 1;
+   }
+
+   // Check the result can be used as is
+   cCoreDatabase check;
+   check.SetLog( &log );
+
+   bRC = check.InitializeFromImage( argv[2] );
+   if ( (bRC == false)
+   ||   (check.GetProtocolEntities().size() != db.GetProtocolEntities().size())
+   ||   (check.GetProtocolStructs().size() != db.GetProtocolStructs().size())
+   ||   (check.GetProtocolFields().size() != db.GetProtocolFields().size())
+   ||   (check.GetEnums().size() != db.GetEnums().size()) )
+   {
+      fprintf( stderr, "%s: \'%s\' failed verification\n", argv[0], argv[2] );
+      unlink( argv[2] );
+      return 1;
+   }
+
+   return 0;
+}
@@ -146,6 +146,69 @@ cDataParser::tParsedFields ParseTLV(
    return retFields;
 }
 
+/*===========================================================================
+METHOD:
+   DecodeTLV (Free Method)
+
+DESCRIPTION:
+   Decode the leading fields of the given TLV into typed targets (one 
+   target per field, in field order), fixed layout TLVs are decoded
+   directly while anything else is parsed to fields first
+
+   Nothing is stored unless every field is present
+
+PARAMETERS:
+   db             [ I ] - Database to use
+   qmiBuf         [ I ] - Original buffer containing TLV (locks data)
+   tlvs           [ I ] - TLV parsing input vector
+   tlvKey         [ I ] - Key of the TLV that is to be decoded
+   pTargets       [ I ] - Targets
+   targetCount    [ I ] - Number of targets
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool DecodeTLV( 
+   const cCoreDatabase &               db,
+   const sProtocolBuffer &             qmiBuf,
+   const std::vector <sDB2NavInput> &  tlvs, 
+   const sProtocolEntityKey &          tlvKey,
+   const sDataDecoderTarget *          pTargets,
+   ULONG                               targetCount )
+{
+   // Assume failure
+   bool bRC = false;
+
+   // We need some TLVs to decode and a valid QMI DB key
+   ULONG tlvCount = (ULONG)tlvs.size();
+   if (tlvCount == 0 || tlvKey.mKey.size() < 3)
+   {
+      return bRC;
+   }
+   
+   for (ULONG t = 0; t < tlvCount; t++)
+   {
+      const sDB2NavInput & ni = tlvs[t];
+      if (tlvKey.mKey == ni.mKey)
+      {
+         cDataDecoder dd( db, tlvKey.mKey );
+         bRC = dd.Decode( ni.mpPayload, ni.mPayloadLen, pTargets, targetCount );
+         if (bRC == false)
+         {
+            // Not fixed layout (or short), fall back on the parser
+            cDataParser dp( db, qmiBuf, tlvKey, ni.mpPayload, ni.mPayloadLen );
+            dp.Parse( false, false );
+
+            bRC = cDataDecoder::Store( dp.GetFields(), pTargets, targetCount );
+         }
+
+         break;
+      }
+   }
+
+   return bRC;
+}
+
 /*=========================================================================*/
 // cGobiQMICore Methods
 /*=========================================================================*/
@@ -200,6 +263,9 @@ bool cGobiQMICore::Initialize()
 {
    // Initialize database
    mDB.Initialize();
+
+   // Build all navigation trees now, the servers parse concurrently
+   mDB.BuildNavTrees();
    
    // Allocate configured QMI servers
    bool bOK = true;
@@ -48,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "ProtocolBuffer.h"
 #include "QMIProtocolServer.h"
 #include "DataParser.h"
+#include "DataDecoder.h"
 #include "DataPacker.h"
 #include "DB2Utilities.h"
 #include "SyncQueue.h"
@@ -78,6 +79,15 @@ cDataParser::tParsedFields ParseTLV(
    const sProtocolEntityKey &          tlvKey,
    bool                                bFieldStrings = false );
 
+// Decode the leading fields of the given TLV into typed targets
+bool DecodeTLV( 
+   const cCoreDatabase &               db,
+   const sProtocolBuffer &             qmiBuf,
+   const std::vector <sDB2NavInput> &  tlvs, 
+   const sProtocolEntityKey &          tlvKey,
+   const sDataDecoderTarget *          pTargets,
+   ULONG                               targetCount );
+
 /*=========================================================================*/
 // Class cGobiQMICore
 /*=========================================================================*/
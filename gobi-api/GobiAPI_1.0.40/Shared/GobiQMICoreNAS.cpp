@@ -159,16 +159,16 @@ eGobiError cGobiQMICore::GetANAAAAuthenticationStatus( ULONG * pStatus )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the status
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_NAS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pStatus );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the index
-   *pStatus = (ULONG)pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -242,10 +242,18 @@ eGobiError cGobiQMICore::GetSignalStrengths(
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key)
+   INT8 sigVal = 0;
+   ULONG radioVal = 0;
+   sDataDecoderTarget targets[2] =
+   {
+      DATA_DECODER_TARGET( sigVal ),
+      DATA_DECODER_TARGET( radioVal )
+   };
+
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_NAS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 2) 
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &targets[0], 2 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
@@ -253,8 +261,6 @@ eGobiError cGobiQMICore::GetSignalStrengths(
    // Remove any values outside the legal range
    std::map <ULONG, INT8> sigMap;
    
-   INT8 sigVal = pf[0].mValue.mS8;
-   ULONG radioVal = pf[1].mValue.mU32;
    if (sigVal <= -30 && sigVal > -125 && radioVal != 0)
    {
       sigMap[radioVal] = sigVal;
@@ -262,7 +268,7 @@ eGobiError cGobiQMICore::GetSignalStrengths(
 
    // Parse the TLV we want (by DB key)
    tlvKey = sProtocolEntityKey( eDB2_ET_QMI_NAS_RSP, msgID, 16 );
-   pf = ParseTLV( db, rsp, tlvs, tlvKey );
+   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
    if (pf.size() > 2) 
    {
       ULONG fi = 0;
@@ -923,13 +929,10 @@ eGobiError cGobiQMICore::GetServingNetwork(
 
    *pRadioIfacesSize = activeRadioIfaces;
 
-   // Parse the optional TLV we want (by DB key)
+   // Decode the optional TLV we want (by DB key), if present
    sProtocolEntityKey tlvKey2( eDB2_ET_QMI_NAS_RSP, msgID, 16 );
-   cDataParser::tParsedFields pf2 = ParseTLV( db, rsp, tlvs, tlvKey2 );
-   if (pf2.size() >= 1) 
-   {
-      *pRoaming = pf2[0].mValue.mU32;
-   }
+   sDataDecoderTarget roaming = DATA_DECODER_TARGET( *pRoaming );
+   DecodeTLV( db, rsp, tlvs, tlvKey2, &roaming, 1 );
 
    // Parse the optional TLV we want (by DB key)
    sProtocolEntityKey tlvKey3( eDB2_ET_QMI_NAS_RSP, msgID, 18 );
@@ -1111,16 +1114,16 @@ eGobiError cGobiQMICore::GetDataBearerTechnology( ULONG * pDataBearer )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the data bearer
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pDataBearer );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the state
-   *pDataBearer = pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -1230,14 +1233,15 @@ eGobiError cGobiQMICore::GetHomeNetwork(
       }
    }
 
-   // Parse the optional TLV we want (by DB key)
-   sProtocolEntityKey tlvKey2( eDB2_ET_QMI_NAS_RSP, msgID, 16 );
-   cDataParser::tParsedFields pf2 = ParseTLV( db, rsp, tlvs, tlvKey2 );
-   if (pf2.size() >= 2) 
+   // Decode the optional TLV we want (by DB key), if present
+   sDataDecoderTarget targets[2] =
    {
-      *pSID = pf2[0].mValue.mU16;
-      *pNID = pf2[1].mValue.mU16;
-   }
+      DATA_DECODER_TARGET( *pSID ),
+      DATA_DECODER_TARGET( *pNID )
+   };
+
+   sProtocolEntityKey tlvKey2( eDB2_ET_QMI_NAS_RSP, msgID, 16 );
+   DecodeTLV( db, rsp, tlvs, tlvKey2, &targets[0], 2 );
 
    return eGOBI_ERR_NONE;
 }
@@ -1736,16 +1740,16 @@ eGobiError cGobiQMICore::GetACCOLC( BYTE * pACCOLC )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the ACCOLC
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_NAS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pACCOLC );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the ACCOLC
-   *pACCOLC = pf[0].mValue.mU8;
    return eGOBI_ERR_NONE;
 }
 
@@ -1859,16 +1863,16 @@ eGobiError cGobiQMICore::GetPLMNMode( ULONG * pMode )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the PLMN mode
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_NAS_RSP, msgID, 16 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pMode );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the PLMN mode
-   *pMode = (ULONG)pf[0].mValue.mU8;
    return eGOBI_ERR_NONE;
 }
 
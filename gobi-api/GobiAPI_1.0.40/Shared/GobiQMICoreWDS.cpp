@@ -105,16 +105,16 @@ eGobiError cGobiQMICore::GetSessionState( ULONG * pState )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the state
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pState );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the state
-   *pState = pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -171,16 +171,16 @@ eGobiError cGobiQMICore::GetSessionDuration( ULONGLONG * pDuration )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the duration
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pDuration );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the state
-   *pDuration = pf[0].mValue.mU64;
    return eGOBI_ERR_NONE;
 }
 
@@ -241,28 +241,26 @@ eGobiError cGobiQMICore::GetSessionDurations(
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the total duration
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget totalTarget = DATA_DECODER_TARGET( *pTotalDuration );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &totalTarget, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the total duration
-   *pTotalDuration = pf[0].mValue.mU64;
-
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the active duration
    tlvKey = sProtocolEntityKey( eDB2_ET_QMI_WDS_RSP, msgID, 17 );
-   pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget activeTarget = DATA_DECODER_TARGET( *pActiveDuration );
+
+   bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &activeTarget, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the active duration
-   *pActiveDuration = pf[0].mValue.mU64;
-
    return eGOBI_ERR_NONE;
 }
 
@@ -320,16 +318,16 @@ eGobiError cGobiQMICore::GetDormancyState( ULONG * pState )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the state
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pState );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the state
-   *pState = pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -394,21 +392,18 @@ eGobiError cGobiQMICore::GetEnhancedAutoconnect(
    const cCoreDatabase & db = GetDatabase();
 
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget setting = DATA_DECODER_TARGET( *pSetting );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &setting, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   *pSetting = (ULONG)pf[0].mValue.mU32;
-
-   // Parse the TLV we want (by DB key)
+   // Decode the optional TLV we want (by DB key), if present
    tlvKey = sProtocolEntityKey( eDB2_ET_QMI_WDS_RSP, msgID, 16 );
-   pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() > 0) 
-   {
-      *pRoamSetting = (ULONG)pf[0].mValue.mU32;
-   }
+   sDataDecoderTarget roamSetting = DATA_DECODER_TARGET( *pRoamSetting );
+   DecodeTLV( db, rsp, tlvs, tlvKey, &roamSetting, 1 );
 
    return eGOBI_ERR_NONE;
 }
@@ -434,21 +429,18 @@ eGobiError cGobiQMICore::SetEnhancedAutoconnect(
    WORD msgID = (WORD)eQMI_WDS_SET_AUTOCONNECT;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u"
-   std::ostringstream tmp;
-   tmp << setting;
+   sDataPackerValue val( setting );
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, tmp.str().c_str() ); 
+   sDB2PackingInput pi( pek, &val, 1 ); 
    piv.push_back( pi );
 
    if (pRoamSetting != 0)
    {
-      std::ostringstream tmp2;
-      tmp2 << *pRoamSetting;
+      sDataPackerValue val( *pRoamSetting );
 
       sProtocolEntityKey pek1( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      sDB2PackingInput pi1( pek1, tmp2.str().c_str() ); 
+      sDB2PackingInput pi1( pek1, &val, 1 );
       piv.push_back( pi1 );
    }
 
@@ -505,48 +497,36 @@ eGobiError cGobiQMICore::SetDefaultProfile(
    WORD msgID = (WORD)eQMI_WDS_MODIFY_PROFILE;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u 1"
-   std::ostringstream tmp;
-   tmp << (UINT)profileType << " 1";
+   sDataPackerValue vals[2] = { (UINT)profileType, 1 };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &vals[0], 2 );
    piv.push_back( pi );
 
    if (pName != 0)
    {
-      std::ostringstream tmp2;
-      if (pName[0] != 0)
-      {
-         tmp2 << "\"" << pName << "\"";
-      }
+      sDataPackerValue val( pName );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    if (pPDPType != 0)
    {
-      // "%u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)*pPDPType;
+      sDataPackerValue val( (UINT)*pPDPType );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 17 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    if (pAPNName != 0)
    {
-      std::ostringstream tmp2;
-      if (pAPNName[0] != 0)
-      {
-         tmp2 << "\"" << pAPNName << "\"";
-      }
+      sDataPackerValue val( pAPNName );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 20 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -557,13 +537,10 @@ eGobiError cGobiQMICore::SetDefaultProfile(
       ULONG ip2 = (*pPrimaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pPrimaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 21 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -574,39 +551,28 @@ eGobiError cGobiQMICore::SetDefaultProfile(
       ULONG ip2 = (*pSecondaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pSecondaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 22 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
    if (pUsername != 0)
    {
-      std::ostringstream tmp2;
-      if (pUsername[0] != 0)
-      {
-         tmp2 << "\"" << pUsername << "\"";
-      }
+      sDataPackerValue val( pUsername );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 27 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    if (pPassword != 0)
    {
-      std::ostringstream tmp2;
-      if (pPassword[0] != 0)
-      {
-         tmp2 << "\"" << pPassword << "\"";
-      }
+      sDataPackerValue val( pPassword );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 28 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -615,12 +581,10 @@ eGobiError cGobiQMICore::SetDefaultProfile(
       ULONG pap = *pAuthentication & 0x00000001;
       ULONG chap = *pAuthentication & 0x00000002;
       
-      // "%u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)pap << " " << (UINT)chap;
+      sDataPackerValue vals[2] = { (UINT)pap, (UINT)chap };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 29 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &vals[0], 2 );
       piv.push_back( pi );
    }
 
@@ -631,14 +595,10 @@ eGobiError cGobiQMICore::SetDefaultProfile(
       ULONG ip2 = (*pIPAddress & 0x00FF0000) >> 16;
       ULONG ip1 = (*pIPAddress & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
-
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 30 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -731,12 +691,10 @@ eGobiError cGobiQMICore::GetDefaultProfile(
    WORD msgID = (WORD)eQMI_WDS_GET_DEFAULTS;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u 0"
-   std::ostringstream tmp;
-   tmp << (UINT)profileType << " 0";
+   sDataPackerValue vals[2] = { (UINT)profileType, 0 };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &vals[0], 2 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -944,12 +902,10 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG umts = *pTechnology & 0x00000001;
       ULONG cdma = *pTechnology & 0x00000002;
       
-      // "%u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)umts << " " << (UINT)cdma;
+      sDataPackerValue vals[2] = { (UINT)umts, (UINT)cdma };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 48 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &vals[0], 2 );
       piv.push_back( pi );
    }
 
@@ -960,13 +916,10 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG ip2 = (*pPrimaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pPrimaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -977,13 +930,10 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG ip2 = (*pSecondaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pSecondaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 17 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -994,13 +944,10 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG ip2 = (*pPrimaryNBNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pPrimaryNBNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 18 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -1011,26 +958,19 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG ip2 = (*pSecondaryNBNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pSecondaryNBNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 19 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
    if (pAPNName != 0)
    {
-      std::ostringstream tmp;
-      if (pAPNName[0] != 0)
-      {
-         tmp << "\"" << pAPNName << "\"";
-      }
+      sDataPackerValue val( pAPNName );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 20 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -1041,13 +981,10 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG ip2 = (*pIPAddress & 0x00FF0000) >> 16;
       ULONG ip1 = (*pIPAddress & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 21 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -1056,38 +993,28 @@ eGobiError cGobiQMICore::StartDataSession(
       ULONG pap = *pAuthentication & 0x00000001;
       ULONG chap = *pAuthentication & 0x00000002;
       
-      // "%u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)pap << " " << (UINT)chap;
+      sDataPackerValue vals[2] = { (UINT)pap, (UINT)chap };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 22 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &vals[0], 2 );
       piv.push_back( pi );
    }
 
    if (pUsername != 0)
    {
-      std::ostringstream tmp;
-      if (pUsername[0] != 0)
-      {
-         tmp << "\"" << pUsername << "\"";
-      }
+      sDataPackerValue val( pUsername );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 23 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    if (pPassword != 0)
    {
-      std::ostringstream tmp;
-      if (pPassword[0] != 0)
-      {
-         tmp << "\"" << pPassword << "\"";
-      }
+      sDataPackerValue val( pPassword );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 24 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -1138,13 +1065,10 @@ eGobiError cGobiQMICore::StartDataSession(
       std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
       const cCoreDatabase & db = GetDatabase();
 
-      // Parse the TLV we want (by DB key)
+      // Decode the TLV we want (by DB key), if present
       sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 16 );
-      cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-      if (pf.size() >= 1) 
-      {
-         *pFailureReason = pf[0].mValue.mU32;
-      }
+      sDataDecoderTarget reason = DATA_DECODER_TARGET( *pFailureReason );
+      DecodeTLV( db, rsp, tlvs, tlvKey, &reason, 1 );
 
       return GetCorrectedQMIError( ec );
    }
@@ -1153,16 +1077,16 @@ eGobiError cGobiQMICore::StartDataSession(
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the session ID
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pSessionId );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the session ID
-   *pSessionId = pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -1186,12 +1110,10 @@ eGobiError cGobiQMICore::CancelDataSession()
    WORD msgID = (WORD)eQMI_WDS_ABORT;
    std::vector <sDB2PackingInput> piv;
 
-   // %hu
-   std::ostringstream tmp;
-   tmp << mLastNetStartID;
+   sDataPackerValue val( mLastNetStartID );
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &val, 1 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1221,12 +1143,10 @@ eGobiError cGobiQMICore::StopDataSession( ULONG sessionId )
    WORD msgID = (WORD)eQMI_WDS_STOP_NET;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u"
-   std::ostringstream tmp;
-   tmp << (UINT)sessionId;
+   sDataPackerValue val( (UINT)sessionId );
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &val, 1 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1264,10 +1184,10 @@ eGobiError cGobiQMICore::GetIPAddress( ULONG * pIPAddress )
    WORD msgID = (WORD)eQMI_WDS_GET_SETTINGS;
    std::vector <sDB2PackingInput> piv;
 
-   std::string tmp = "0 0 0 0 0 0 0 0 1 0 0 0 0 0 0 0 0 0";
+   sDataPackerValue mask[18] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.c_str() );
+   sDB2PackingInput pi( pek, &mask[0], 18 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1308,18 +1228,27 @@ eGobiError cGobiQMICore::GetIPAddress( ULONG * pIPAddress )
    // Prepare TLVs for parsing
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
 
-   // Parse the TLVs we want (IP address)
+   // Decode the TLVs we want (IP address)
+   BYTE ip[4];
+   sDataDecoderTarget targets[4] =
+   {
+      DATA_DECODER_TARGET( ip[0] ),
+      DATA_DECODER_TARGET( ip[1] ),
+      DATA_DECODER_TARGET( ip[2] ),
+      DATA_DECODER_TARGET( ip[3] )
+   };
+
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 30 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 4) 
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &targets[0], 4 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   ULONG ip4 = (ULONG)pf[0].mValue.mU8;
-   ULONG ip3 = (ULONG)pf[1].mValue.mU8 << 8;
-   ULONG ip2 = (ULONG)pf[2].mValue.mU8 << 16;
-   ULONG ip1 = (ULONG)pf[3].mValue.mU8 << 24;
+   ULONG ip4 = (ULONG)ip[0];
+   ULONG ip3 = (ULONG)ip[1] << 8;
+   ULONG ip2 = (ULONG)ip[2] << 16;
+   ULONG ip1 = (ULONG)ip[3] << 24;
    *pIPAddress = (ip4 | ip3 | ip2 | ip1);
 
    return eGOBI_ERR_NONE;
@@ -1389,19 +1318,22 @@ eGobiError cGobiQMICore::GetConnectionRate(
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the rates
+   sDataDecoderTarget targets[4] =
+   {
+      DATA_DECODER_TARGET( *pCurrentChannelTXRate ),
+      DATA_DECODER_TARGET( *pCurrentChannelRXRate ),
+      DATA_DECODER_TARGET( *pMaxChannelTXRate ),
+      DATA_DECODER_TARGET( *pMaxChannelRXRate )
+   };
+
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 4) 
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &targets[0], 4 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the rates
-   *pCurrentChannelTXRate = pf[0].mValue.mU32;
-   *pCurrentChannelRXRate = pf[1].mValue.mU32;
-   *pMaxChannelTXRate = pf[2].mValue.mU32;
-   *pMaxChannelRXRate = pf[3].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -1446,10 +1378,10 @@ eGobiError cGobiQMICore::GetPacketStatus(
    WORD msgID = (WORD)eQMI_WDS_GET_STATISTICS;
    std::vector <sDB2PackingInput> piv;
 
-   std::string tmp = "1 1 1 1 1 1 0 0";
+   sDataPackerValue mask[8] = { 1, 1, 1, 1, 1, 1, 0, 0 };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.c_str() );
+   sDB2PackingInput pi( pek, &mask[0], 8 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1490,56 +1422,28 @@ eGobiError cGobiQMICore::GetPacketStatus(
    // Prepare TLVs for parsing
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
 
-   // Parse the TLVs we want (by DB key)
-   sProtocolEntityKey tlvKey1( eDB2_ET_QMI_WDS_RSP, msgID, 16 );
-   cDataParser::tParsedFields pf1 = ParseTLV( db, rsp, tlvs, tlvKey1 );
-   if (pf1.size() < 1) 
-   {
-      return eGOBI_ERR_INVALID_RSP;
-   }
-
-   sProtocolEntityKey tlvKey2( eDB2_ET_QMI_WDS_RSP, msgID, 17 );
-   cDataParser::tParsedFields pf2 = ParseTLV( db, rsp, tlvs, tlvKey2 );
-   if (pf2.size() < 1) 
-   {
-      return eGOBI_ERR_INVALID_RSP;
-   }
-
-   sProtocolEntityKey tlvKey3( eDB2_ET_QMI_WDS_RSP, msgID, 18 );
-   cDataParser::tParsedFields pf3 = ParseTLV( db, rsp, tlvs, tlvKey3 );
-   if (pf3.size() < 1) 
+   // Decode the TLVs we want (by DB key), TX/RX successes, errors and
+   // overflows are TLVs 16 through 21
+   ULONG stats[6];
+   for (ULONG t = 0; t < 6; t++)
    {
-      return eGOBI_ERR_INVALID_RSP;
-   }
+      sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 16 + t );
+      sDataDecoderTarget target = DATA_DECODER_TARGET( stats[t] );
 
-   sProtocolEntityKey tlvKey4( eDB2_ET_QMI_WDS_RSP, msgID, 19 );
-   cDataParser::tParsedFields pf4 = ParseTLV( db, rsp, tlvs, tlvKey4 );
-   if (pf4.size() < 1) 
-   {
-      return eGOBI_ERR_INVALID_RSP;
-   }
-
-   sProtocolEntityKey tlvKey5( eDB2_ET_QMI_WDS_RSP, msgID, 20 );
-   cDataParser::tParsedFields pf5 = ParseTLV( db, rsp, tlvs, tlvKey5 );
-   if (pf5.size() < 1) 
-   {
-      return eGOBI_ERR_INVALID_RSP;
-   }
-
-   sProtocolEntityKey tlvKey6( eDB2_ET_QMI_WDS_RSP, msgID, 21 );
-   cDataParser::tParsedFields pf6 = ParseTLV( db, rsp, tlvs, tlvKey5 );
-   if (pf6.size() < 1) 
-   {
-      return eGOBI_ERR_INVALID_RSP;
+      bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+      if (bOK == false) 
+      {
+         return eGOBI_ERR_INVALID_RSP;
+      }
    }
 
    // Populate the statistics
-   *pTXPacketSuccesses = pf1[0].mValue.mU32;
-   *pRXPacketSuccesses = pf2[0].mValue.mU32;
-   *pTXPacketErrors = pf3[0].mValue.mU32;
-   *pRXPacketErrors = pf4[0].mValue.mU32;
-   *pTXPacketOverflows = pf5[0].mValue.mU32;
-   *pRXPacketOverflows = pf6[0].mValue.mU32;
+   *pTXPacketSuccesses = stats[0];
+   *pRXPacketSuccesses = stats[1];
+   *pTXPacketErrors = stats[2];
+   *pRXPacketErrors = stats[3];
+   *pTXPacketOverflows = stats[4];
+   *pRXPacketOverflows = stats[5];
    return eGOBI_ERR_NONE;
 }
 
@@ -1571,10 +1475,10 @@ eGobiError cGobiQMICore::GetByteTotals(
    WORD msgID = (WORD)eQMI_WDS_GET_STATISTICS;
    std::vector <sDB2PackingInput> piv;
 
-   std::string tmp = "0 0 0 0 0 0 1 1";
+   sDataPackerValue mask[8] = { 0, 0, 0, 0, 0, 0, 1, 1 };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.c_str() );
+   sDB2PackingInput pi( pek, &mask[0], 8 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1615,23 +1519,27 @@ eGobiError cGobiQMICore::GetByteTotals(
    // Prepare TLVs for parsing
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
 
+   ULONGLONG txBytes = 0;
+   sDataDecoderTarget target1 = DATA_DECODER_TARGET( txBytes );
    sProtocolEntityKey tlvKey1( eDB2_ET_QMI_WDS_RSP, msgID, 25 );
-   cDataParser::tParsedFields pf1 = ParseTLV( db, rsp, tlvs, tlvKey1 );
-   if (pf1.size() < 1) 
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey1, &target1, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
+   ULONGLONG rxBytes = 0;
+   sDataDecoderTarget target2 = DATA_DECODER_TARGET( rxBytes );
    sProtocolEntityKey tlvKey2( eDB2_ET_QMI_WDS_RSP, msgID, 26 );
-   cDataParser::tParsedFields pf2 = ParseTLV( db, rsp, tlvs, tlvKey2 );
-   if (pf2.size() < 1) 
+   bOK = DecodeTLV( db, rsp, tlvs, tlvKey2, &target2, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
    // Populate the statistics
-   *pTXTotalBytes = pf1[0].mValue.mU64;
-   *pRXTotalBytes = pf2[0].mValue.mU64;
+   *pTXTotalBytes = txBytes;
+   *pRXTotalBytes = rxBytes;
 
    return eGOBI_ERR_NONE;
 }
@@ -1654,12 +1562,10 @@ eGobiError cGobiQMICore::SetMobileIP( ULONG mode )
    WORD msgID = (WORD)eQMI_WDS_SET_MIP;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u"
-   std::ostringstream tmp;
-   tmp << (UINT)mode;
+   sDataPackerValue val( (UINT)mode );
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &val, 1 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1723,16 +1629,16 @@ eGobiError cGobiQMICore::GetMobileIP( ULONG * pMode )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the mode
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pMode );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the mode
-   *pMode = pf[0].mValue.mU32;
    return eGOBI_ERR_NONE;
 }
 
@@ -1776,12 +1682,10 @@ eGobiError cGobiQMICore::SetActiveMobileIPProfile(
    WORD msgID = (WORD)eQMI_WDS_SET_ACTIVE_MIP;
    std::vector <sDB2PackingInput> piv;
 
-   // "%s %u"
-   std::ostringstream tmp;
-   tmp << spc << " " << (UINT)index;
+   sDataPackerValue vals[2] = { spc.c_str(), (UINT)index };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &vals[0], 2 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -1845,16 +1749,16 @@ eGobiError cGobiQMICore::GetActiveMobileIPProfile( BYTE * pIndex )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the index
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pIndex );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the index
-   *pIndex = pf[0].mValue.mU8;
    return eGOBI_ERR_NONE;
 }
 
@@ -1918,23 +1822,19 @@ eGobiError cGobiQMICore::SetMobileIPProfile(
    WORD msgID = (WORD)eQMI_WDS_SET_MIP_PROFILE;
    std::vector <sDB2PackingInput> piv;
 
-   // "%s %u"
-   std::ostringstream tmp;
-   tmp << spc << " " << (UINT)index;
+   sDataPackerValue vals[2] = { spc.c_str(), (UINT)index };
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+   sDB2PackingInput pi( pek, &vals[0], 2 );
    piv.push_back( pi );
 
    // Enabled flag provided?
    if (pEnabled != 0)
    {
-      // "%u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)(*pEnabled == 0 ? 0 : 1);
+      sDataPackerValue val( (UINT)(*pEnabled == 0 ? 0 : 1) );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -1946,13 +1846,10 @@ eGobiError cGobiQMICore::SetMobileIPProfile(
       ULONG ip2 = (*pAddress & 0x00FF0000) >> 16;
       ULONG ip1 = (*pAddress & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 17 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -1964,13 +1861,10 @@ eGobiError cGobiQMICore::SetMobileIPProfile(
       ULONG ip2 = (*pPrimaryHA & 0x00FF0000) >> 16;
       ULONG ip1 = (*pPrimaryHA & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 18 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -1982,91 +1876,70 @@ eGobiError cGobiQMICore::SetMobileIPProfile(
       ULONG ip2 = (*pSecondaryHA & 0x00FF0000) >> 16;
       ULONG ip1 = (*pSecondaryHA & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-           << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 19 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
    // Reverse tunneling flag provided?
    if (pRevTunneling != 0)
    {
-      // "%u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)(*pRevTunneling == 0 ? 0 : 1);
+      sDataPackerValue val( (UINT)(*pRevTunneling == 0 ? 0 : 1) );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 20 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // NAI provided?
    if (pNAI != 0)
    {
-      std::ostringstream tmp2;
-      if (pNAI[0] != 0)
-      {
-         tmp2 << "\"" << pNAI << "\"";
-      }
+      sDataPackerValue val( pNAI );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 21 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // HA SPI provided?
    if (pHASPI != 0)
    {
-      // "%u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)*pHASPI;
+      sDataPackerValue val( (UINT)*pHASPI );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 22 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // AAA SPI provided?
    if (pAAASPI != 0)
    {
-      // "%u"
-      std::ostringstream tmp2;
-      tmp2 << (UINT)*pAAASPI;
+      sDataPackerValue val( (UINT)*pAAASPI );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 23 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp2.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // MN-HA key provided?
    if (pMNHA != 0)
    {
-      std::ostringstream tmp2;
-      if (pMNHA[0] != 0)
-      {
-         tmp2 << "\"" << pMNHA << "\"";
-      }
+      sDataPackerValue val( pMNHA );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 24 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp2.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // MN-AAA key provided?
    if (pMNAAA != 0)
    {
-      std::ostringstream tmp2;
-      if (pMNAAA[0] != 0)
-      {
-         tmp2 << "\"" << pMNAAA << "\"";
-      }
+      sDataPackerValue val( pMNAAA );
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 25 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -2155,12 +2028,10 @@ eGobiError cGobiQMICore::GetMobileIPProfile(
    WORD msgID = (WORD)eQMI_WDS_GET_MIP_PROFILE;
    std::vector <sDB2PackingInput> piv;
 
-   // "%u"
-   std::ostringstream arg;
-   arg << (UINT)index;
+   sDataPackerValue val( (UINT)index );
 
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)arg.str().c_str() );
+   sDB2PackingInput pi( pek, &val, 1 );
    piv.push_back( pi );
 
    // Pack up the QMI request
@@ -2351,85 +2222,79 @@ eGobiError cGobiQMICore::SetMobileIPParameters(
    WORD msgID = (WORD)eQMI_WDS_SET_MIP_PARAMS;
    std::vector <sDB2PackingInput> piv;
 
+   sDataPackerValue val( spc.c_str() );
+
    sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 1 );
-   sDB2PackingInput pi( pek, (LPCSTR)spc.c_str() );
+   sDB2PackingInput pi( pek, &val, 1 );
    piv.push_back( pi );
 
    // Mode provided?
    if (pMode != 0)
    {
-      // "%u"
-      std::ostringstream tmp;
-      tmp << (UINT)*pMode;
+      sDataPackerValue val( (UINT)*pMode );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // Retry limit provided?
    if (pRetryLimit != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)*pRetryLimit;
+      sDataPackerValue val( (UINT)*pRetryLimit );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 17 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // Retry interval provided?
    if (pRetryInterval != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)*pRetryInterval;
+      sDataPackerValue val( (UINT)*pRetryInterval );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 18 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // Re-registration period provided?
    if (pReRegPeriod != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)*pReRegPeriod;
+      sDataPackerValue val( (UINT)*pReRegPeriod );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 19 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // Re-registration on traffic flag provided?
    if (pReRegTraffic != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)(*pReRegTraffic == 0 ? 0 : 1);
+      sDataPackerValue val( (UINT)(*pReRegTraffic == 0 ? 0 : 1) );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 20 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // HA authenticator flag provided?
    if (pHAAuthenticator != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)(*pHAAuthenticator == 0 ? 0 : 1);
+      sDataPackerValue val( (UINT)(*pHAAuthenticator == 0 ? 0 : 1) );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 21 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
    // HA RFC2002bis authentication flag provided?
    if (pHA2002bis != 0)
    {
-      std::ostringstream tmp;
-      tmp << (UINT)(*pHA2002bis == 0 ? 0 : 1);
+      sDataPackerValue val( (UINT)(*pHA2002bis == 0 ? 0 : 1) );
 
       pek = sProtocolEntityKey( eDB2_ET_QMI_WDS_REQ, msgID, 22 );
-      pi = sDB2PackingInput( pek, (LPCSTR)tmp.str().c_str() );
+      pi = sDB2PackingInput( pek, &val, 1 );
       piv.push_back( pi );
    }
 
@@ -2635,16 +2500,16 @@ eGobiError cGobiQMICore::GetLastMobileIPError( ULONG * pError )
    std::vector <sDB2NavInput> tlvs = DB2ReduceQMIBuffer( qmiRsp );
    const cCoreDatabase & db = GetDatabase();
 
-   // Parse the TLV we want (by DB key)
+   // Decode the TLV we want (by DB key) into the error
    sProtocolEntityKey tlvKey( eDB2_ET_QMI_WDS_RSP, msgID, 1 );
-   cDataParser::tParsedFields pf = ParseTLV( db, rsp, tlvs, tlvKey );
-   if (pf.size() < 1) 
+   sDataDecoderTarget target = DATA_DECODER_TARGET( *pError );
+
+   bool bOK = DecodeTLV( db, rsp, tlvs, tlvKey, &target, 1 );
+   if (bOK == false) 
    {
       return eGOBI_ERR_INVALID_RSP;
    }
 
-   // Populate the index
-   *pError = (ULONG)pf[0].mValue.mU8;
    return eGOBI_ERR_NONE;
 }
 
@@ -2683,13 +2548,10 @@ eGobiError cGobiQMICore::SetDNSSettings(
       ULONG ip2 = (*pPrimaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pPrimaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 16 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -2700,13 +2562,10 @@ eGobiError cGobiQMICore::SetDNSSettings(
       ULONG ip2 = (*pSecondaryDNS & 0x00FF0000) >> 16;
       ULONG ip1 = (*pSecondaryDNS & 0xFF000000) >> 24;
 
-      // "%u %u %u %u"
-      std::ostringstream tmp;
-      tmp << (UINT)ip4 << " " << (UINT)ip3 << " " << (UINT)ip2 
-          << " " << (UINT)ip1;
+      sDataPackerValue ip[4] = { ip4, ip3, ip2, ip1 };
 
       sProtocolEntityKey pek( eDB2_ET_QMI_WDS_REQ, msgID, 17 );
-      sDB2PackingInput pi( pek, (LPCSTR)tmp.str().c_str() );
+      sDB2PackingInput pi( pek, &ip[0], 4 );
       piv.push_back( pi );
    }
 
@@ -130,25 +130,7 @@ void * RxThread( void * pData )
          largestFD = pComm->mCommandPipe[READING];
 
          // Perform a read
-         status = read( pComm->mPort,
-                        pComm->mpBuffer,
-                        pComm->mBuffSz );
-
-         cIOCallback * pCallback = pComm->mpRxCallback;
-         pComm->mpRxCallback = 0;
-
-         if (pCallback == (cIOCallback *)1)
-         {
-            // We wanted to read, but not to be notified
-         }   
-         else if (status >= 0)
-         {
-            pCallback->IOComplete( 0, status );
-         }
-         else
-         {
-            pCallback->IOComplete( status, 0 );
-         }
+         pComm->ReadReady();
       }
    }
 
@@ -241,25 +223,29 @@ bool cComm::Connect( LPCSTR pPort )
       Disconnect();
    }
 
-   // Initialize command pipe for read thread
-   int nRet = pipe( mCommandPipe );
-   if (nRet != 0)
+   // Reads are served by the shared I/O thread when multiplexed
+   if (mpMultiplexer == 0)
    {
-      TRACE( "cComm:Connect() pipe creation failed %d\n", nRet );
-      return false;
-   }
+      // Initialize command pipe for read thread
+      int nRet = pipe( mCommandPipe );
+      if (nRet != 0)
+      {
+         TRACE( "cComm:Connect() pipe creation failed %d\n", nRet );
+         return false;
+      }
 
-   // Start the read thread
-   nRet = pthread_create( &mRxThreadID,
-                          0,
-                          RxThread,
-                          this );
-   if (nRet != 0)
-   {
-      TRACE( "cComm::Connect() pthread_create = %d\n",  nRet );
+      // Start the read thread
+      nRet = pthread_create( &mRxThreadID,
+                             0,
+                             RxThread,
+                             this );
+      if (nRet != 0)
+      {
+         TRACE( "cComm::Connect() pthread_create = %d\n",  nRet );
 
-      Disconnect();
-      return false;
+         Disconnect();
+         return false;
+      }
    }
 
    // Opening the com port
@@ -347,6 +333,11 @@ bool cComm::Disconnect()
 
    if (mPort != INVALID_HANDLE_VALUE)
    {
+      if (mpMultiplexer != 0)
+      {
+         mpMultiplexer->UnwatchRead( mPort, this );
+      }
+
       close( mPort );
       mPort = INVALID_HANDLE_VALUE;
    }
@@ -457,6 +448,22 @@ RETURN VALUE:
 ===========================================================================*/
 bool cComm::CancelRx()
 {
+   if (mpMultiplexer != 0)
+   {
+      if (mPort == INVALID_HANDLE_VALUE || mpRxCallback == 0)
+      {
+         TRACE( "cannot cancel, no read active\n" );
+         mpRxCallback = 0;
+         return false;
+      }
+
+      // Once unwatched the callback can no longer be exercised
+      mpMultiplexer->UnwatchRead( mPort, this );
+      mpRxCallback = 0;
+
+      return true;
+   }
+
    if (mPort == INVALID_HANDLE_VALUE
    ||  mCommandPipe[WRITING] == INVALID_HANDLE_VALUE
    ||  mpRxCallback == 0
@@ -545,6 +552,12 @@ bool cComm::RxData(
    mpBuffer = pBuf;
    mBuffSz = bufSz;
 
+   if (mpMultiplexer != 0)
+   {
+      // Have the shared I/O thread watch for the data
+      return mpMultiplexer->WatchRead( mPort, this );
+   }
+
    // Notify the thread to stop reading
    BYTE byte = START_READ_CMD;
    int nRC = write( mCommandPipe[WRITING], &byte, 1 );
@@ -557,6 +570,41 @@ bool cComm::RxData(
    return true;
 }
 
+/*===========================================================================
+METHOD:
+   ReadReady (Public Method)
+
+DESCRIPTION:
+   Data is available to be read, perform the pending receive operation
+   and exercise its callback
+
+SEQUENCING:
+   Called from the Rx thread (or the shared I/O thread)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cComm::ReadReady()
+{
+   int status = read( mPort, mpBuffer, mBuffSz );
+
+   cIOCallback * pCallback = mpRxCallback;
+   mpRxCallback = 0;
+
+   if (pCallback == 0 || pCallback == (cIOCallback *)1)
+   {
+      // We wanted to read, but not to be notified
+   }   
+   else if (status >= 0)
+   {
+      pCallback->IOComplete( 0, status );
+   }
+   else
+   {
+      pCallback->IOComplete( status, 0 );
+   }
+}
+
 /*===========================================================================
 METHOD:
    TxData (Public Method)
@@ -99,6 +99,9 @@ class cComm : public cConnection
          const BYTE *               pBuf, 
          ULONG                      bufSz );
 
+      // Data is available, perform the pending receive operation
+      void ReadReady();
+
       // (Inline) Return current port name
       std::string GetPortName() const 
       { 
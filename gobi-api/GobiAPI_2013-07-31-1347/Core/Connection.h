@@ -40,6 +40,7 @@ POSSIBILITY OF SUCH DAMAGE.
 // Include Files
 //---------------------------------------------------------------------------
 #include "Event.h"
+#include "IOMultiplexer.h"
 
 //---------------------------------------------------------------------------
 // Pragmas
@@ -67,12 +68,13 @@ class cIOCallback
 /*=========================================================================*/
 // Class cConnection
 /*=========================================================================*/
-class cConnection
+class cConnection : public cIOMultiplexerClient
 {
    public:
       // Constructor
       cConnection()
-         : mpRxCallback( 0 )
+         :  mpRxCallback( 0 ),
+            mpMultiplexer( 0 )
       { };
 
       // Is this object valid?
@@ -142,7 +144,17 @@ class cConnection
          return false;
       };
 
+      // (Inline) Serve receive operations from a shared I/O thread instead
+      // of a dedicated one (must be set before connecting)
+      void SetMultiplexer( cIOMultiplexer * pMultiplexer )
+      {
+         mpMultiplexer = pMultiplexer;
+      };
+
    protected:
       /* Read callbacks */
       cIOCallback * mpRxCallback;
+
+      /* Shared I/O thread (0 when using a dedicated Rx thread) */
+      cIOMultiplexer * mpMultiplexer;
 };
@@ -8,9 +8,11 @@ DESCRIPTION:
 PUBLIC CLASSES AND METHODS:
    WaitOnMultipleEvents
    cEvent
-      Functionality to mimic Windows events using UNIX pipes (enhanced
+      Functionality to mimic Windows events using an eventfd (enhanced
       somewhat to allow one to specify a DWORD value to pass through
       when signalling the event)
+   cEventSet
+      Persistent set of events to wait on repeatedly
 
    WARNING:
       This class is not designed to be thread safe
@@ -48,6 +50,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "StdAfx.h"
 #include "Event.h"
 
+#include <poll.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
 /*===========================================================================
 METHOD:
    WaitOnMultipleEvents (Free Method)
@@ -57,7 +64,8 @@ DESCRIPTION:
 
    Note: If multiple events are set, only the event specified by
       eventIndex will be read from.  Run this function again
-      to get the next event.
+      to get the next event.  When waiting on the same events
+      repeatedly a cEventSet is cheaper.
 
 PARAMETERS:
    events      [ I ] - Vector of events which may be signaled
@@ -77,7 +85,7 @@ int WaitOnMultipleEvents(
    DWORD &                       val,
    DWORD &                       eventIndex )
 {
-   // Check internal pipes' status
+   // Check internal eventfds' status
    for (ULONG index = 0; index < events.size(); index++)
    {
       int error = events[index]->mError;
@@ -88,29 +96,17 @@ int WaitOnMultipleEvents(
       }
    }
 
-   // Initialize the FD set
-   fd_set fds;
-   FD_ZERO( &fds );
-
-   // Add each item to the FD set, keeping track of the largest,
-   // which is used for select()
-   int largestFD = 0;
+   // Build the poll set
+   std::vector <pollfd> fds( events.size() );
    for (ULONG index = 0; index < events.size(); index++)
    {
-      int pipe = events[index]->mPipes[READING];
-      FD_SET( pipe, &fds );
-
-      largestFD = std::max( pipe, largestFD );
+      fds[index].fd = events[index]->mEventFD;
+      fds[index].events = POLLIN;
+      fds[index].revents = 0;
    }
-   
-   struct timeval timeOut;
-
-   // Add avoiding an overflow on (long)usec
-   timeOut.tv_sec = timeoutMS / 1000l;
-   timeOut.tv_usec = ( timeoutMS % 1000l ) * 1000l;
 
-   // Wait for activity on the pipes for the specified amount of time
-   int rc = select( largestFD + 1, &fds, 0, 0, &timeOut );
+   // Wait for activity on the eventfds for the specified amount of time
+   int rc = poll( fds.size() > 0 ? &fds[0] : 0, fds.size(), (int)timeoutMS );
    if (rc == -1)
    {
       TRACE( "WaitOnMultipleEvents error %d\n", errno );
@@ -118,18 +114,17 @@ int WaitOnMultipleEvents(
    }
    else if (rc == 0)
    {
-      // No activity on the pipes
+      // No activity on the eventfds
       return -ETIME;
    }
 
    int numSignaled = rc;
 
-   // Only read from first pipe which was signaled
+   // Only read from first event which was signaled
    int signaled = -1;
    for (ULONG index = 0; index < events.size(); index++)
    {
-      int pipe = events[index]->mPipes[READING];
-      if (FD_ISSET( pipe, &fds ) != 0)
+      if ((fds[index].revents & POLLIN) != 0)
       {
          signaled = index;
          break;
@@ -151,10 +146,15 @@ int WaitOnMultipleEvents(
       eventIndex = signaled;
       return numSignaled;
    }
+   else if (rc == EAGAIN)
+   {
+      // Someone else consumed the value first
+      return -ETIME;
+   }
    else
    {
       // failure
-      return rc;
+      return -rc;
    }
 }
 
@@ -173,13 +173,18 @@ RETURN VALUE:
    None
 ===========================================================================*/
 cEvent::cEvent()
-   :   mError( 0 )
+   :   mError( 0 ),
+       mEventFD( -1 )
 {
-   int rc = pipe( mPipes );
-   if (rc != 0)
+   pthread_mutex_init( &mValuesMutex, NULL );
+
+   // Each value set increments the counter by one and each read
+   // decrements it by one, so it always matches the queued values
+   mEventFD = eventfd( 0, EFD_SEMAPHORE | EFD_NONBLOCK );
+   if (mEventFD == -1)
    {
       mError = errno;
-      TRACE( "cEvent - Error %d creating pipe, %s\n", 
+      TRACE( "cEvent - Error %d creating eventfd, %s\n", 
              mError, 
              strerror( mError ) );
    }
@@ -197,12 +202,14 @@ RETURN VALUE:
 ===========================================================================*/
 cEvent::~cEvent()
 {
-   // Check internal pipe status
+   // Check internal eventfd status
    if (mError == 0)
    {
       Close();
       mError = EBADF;
    }
+
+   pthread_mutex_destroy( &mValuesMutex );
 }
 
 /*===========================================================================
@@ -210,7 +217,7 @@ METHOD:
    Close (Internal Method)
    
 DESCRIPTION:
-   Close pipe
+   Close eventfd
 
 RETURN VALUE:
    Return code
@@ -221,24 +228,18 @@ int cEvent::Close()
 {
    int retCode = 0;
 
-   int rc = close( mPipes[READING] );
-   mPipes[READING] = -1;
-
-   if (rc != 0)
+   if (mEventFD == -1)
    {
-      retCode = errno;
-      TRACE( "cEvent - Error %d deleting pipe[READING], %s\n", 
-             retCode, 
-             strerror( retCode ) );
+      return retCode;
    }
 
-   rc = close( mPipes[WRITING] );
-   mPipes[WRITING] = -1;
+   int rc = close( mEventFD );
+   mEventFD = -1;
 
    if (rc != 0)
    {
       retCode = errno;
-      TRACE( "cEvent - Error %d deleting pipe[WRITING], %s\n", 
+      TRACE( "cEvent - Error %d deleting eventfd, %s\n", 
              retCode, 
              strerror( retCode ) );
    }
@@ -263,38 +264,35 @@ RETURN VALUE:
 ===========================================================================*/
 int cEvent::Set( DWORD val )
 {
-   // Check internal pipe status
+   // Check internal eventfd status
    if (mError != 0)
    {
       return mError;
    }
 
-   PBYTE pWrite = (PBYTE)&val;
+   // Queue the value before signalling, so it is there to be read
+   pthread_mutex_lock( &mValuesMutex );
+   mValues.push_back( val );
+   pthread_mutex_unlock( &mValuesMutex );
 
-   int writeSize = sizeof( DWORD );
-   while (writeSize > 0)
+   uint64_t count = 1;
+   int bytesWritten = write( mEventFD, &count, sizeof( count ) );
+   if (bytesWritten != (int)sizeof( count ))
    {
-      int bytesWritten = write( mPipes[WRITING], pWrite, writeSize );
-      if (bytesWritten == -1)
+      // Store error from write
+      int writeErr = (bytesWritten == -1 ? errno : EIO);
+
+      // First error?
+      if (mError == 0)
       {
-         // Store error from write
-         int writeErr = errno;
-
-         // First error?
-         if (mError == 0)
-         {
-            // Yes, save the error
-            mError = writeErr;
-         }
-
-         // We cannot recover from this error
-         Close();
-         return writeErr;
+         // Yes, save the error
+         mError = writeErr;
       }
-      
-      pWrite += bytesWritten;
-      writeSize -= bytesWritten;
-   }      
+
+      // We cannot recover from this error
+      Close();
+      return writeErr;
+   }
 
    // Success
    return 0;
@@ -321,47 +319,60 @@ int cEvent::Wait(
    DWORD                      timeoutMS, 
    DWORD &                    val )
 {
-   // Check internal pipe status
+   // Check internal eventfd status
    if (mError != 0)
    {
       return mError;
    }
 
-   fd_set fds;
-   FD_ZERO( &fds );
-   FD_SET( mPipes[READING], &fds );
-   
-   struct timeval timeOut;
+   // Fast path, the event is already set
+   int rc = Read( val );
+   if (rc != EAGAIN)
+   {
+      return rc;
+   }
+   else if (timeoutMS == 0)
+   {
+      return ETIME;
+   }
 
-   // Add avoiding an overflow on (long)usec
-   timeOut.tv_sec = timeoutMS / 1000l;
-   timeOut.tv_usec = ( timeoutMS % 1000l ) * 1000l;
+   pollfd fd;
+   fd.fd = mEventFD;
+   fd.events = POLLIN;
+   fd.revents = 0;
 
-   // Wait for activity on the pipe for the specified amount of time
-   int rc = select( mPipes[READING] + 1, &fds, 0, 0, &timeOut );
+   // Wait for activity on the eventfd for the specified amount of time
+   rc = poll( &fd, 1, (int)timeoutMS );
    if (rc == -1)
    {
-      // Store error from select
-      int selectErr = errno;
+      // Store error from poll
+      int pollErr = errno;
 
       // First error?
       if (mError == 0)
       {
          // Yes, save the error
-         mError = selectErr;
+         mError = pollErr;
       }
 
       // We cannot recover from this error
       Close();
-      return selectErr;
+      return pollErr;
    }
    else if (rc == 0)
    {
-      // No activity on the pipe
+      // No activity on the eventfd
       return ETIME;
    }
 
-   return Read( val );
+   rc = Read( val );
+   if (rc == EAGAIN)
+   {
+      // Someone else consumed the value first
+      return ETIME;
+   }
+
+   return rc;
 }
 
 /*===========================================================================
@@ -369,7 +380,7 @@ METHOD:
    Clear (Free Method)
    
 DESCRIPTION:
-   Read and discard all values currently in the pipe
+   Read and discard all values currently queued
 ===========================================================================*/
 void cEvent::Clear()
 {
@@ -387,50 +398,230 @@ METHOD:
    Read (Internal Method)
    
 DESCRIPTION:
-   Read a DWORD from the pipe
+   Read the next value, without blocking
 
 RETURN VALUE:
    Return code
       0 on success
+      EAGAIN if the event is not set
       errno value on failure
 ===========================================================================*/
 int cEvent::Read( DWORD & val )
 {
-   DWORD tempVal;
-   PBYTE pRead = (PBYTE)&tempVal;
-
-   int readSize = sizeof( DWORD );
-   while (readSize > 0)
+   uint64_t count = 0;
+   int bytesRead = read( mEventFD, &count, sizeof( count ) );
+   if (bytesRead != (int)sizeof( count ))
    {
-      int bytesRead = read( mPipes[READING], pRead, readSize );
-      if (bytesRead <= 0)
+      // Store error from read
+      int readErr = (bytesRead == -1 ? errno : EIO);
+      if (readErr == EAGAIN)
       {
-         // Store error from read
-         int readErr = errno;
-         if (readErr == 0)
-         {
-            // Hard error! This should NEVER happen for a pipe
-            ASSERT( 0 );
-            readErr = EBADF;
-         }
-
-         // First error?
-         if (mError == 0)
-         {
-            // Yes, store the error
-            mError = readErr;
-         }
-
-         // We cannot recover from this error
-         Close();
+         // Not set, that's not an error
          return readErr;
       }
-      
-      pRead += bytesRead;
-      readSize -= bytesRead;
+
+      // First error?
+      if (mError == 0)
+      {
+         // Yes, store the error
+         mError = readErr;
+      }
+
+      // We cannot recover from this error
+      Close();
+      return readErr;
    }
 
-   val = tempVal;
+   int rc = 0;
+
+   pthread_mutex_lock( &mValuesMutex );
+   if (mValues.size() > 0)
+   {
+      val = mValues.front();
+      mValues.pop_front();
+   }
+   else
+   {
+      // Hard error! The counter always matches the queue
+      ASSERT( 0 );
+      rc = ENODATA;
+   }
+   pthread_mutex_unlock( &mValuesMutex );
    
-   return 0;
+   return rc;
+}
+
+/*=========================================================================*/
+// cEventSet Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cEventSet (Public Method)
+   
+DESCRIPTION:
+   Constructor, register the events once so every following wait does
+   not need to rebuild the set
+
+PARAMETERS:
+   events      [ I ] - Vector of events which may be signaled
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cEventSet::cEventSet( const std::vector <cEvent *> & events )
+   :   mEvents( events ),
+       mEpoll( -1 ),
+       mError( 0 )
+{
+   mEpoll = epoll_create( (int)std::max( (size_t)1, mEvents.size() ) );
+   if (mEpoll == -1)
+   {
+      mError = errno;
+      TRACE( "cEventSet - Error %d creating epoll, %s\n", 
+             mError, 
+             strerror( mError ) );
+      return;
+   }
+
+   for (ULONG index = 0; index < mEvents.size(); index++)
+   {
+      mError = mEvents[index]->mError;
+      if (mError != 0)
+      {
+         TRACE( "cEvent %lu has error %d\n", index, mError );
+         return;
+      }
+
+      epoll_event event;
+      memset( &event, 0, sizeof( event ) );
+      event.events = EPOLLIN;
+      event.data.u32 = (uint32_t)index;
+
+      int rc = epoll_ctl( mEpoll, 
+                          EPOLL_CTL_ADD, 
+                          mEvents[index]->mEventFD, 
+                          &event );
+      if (rc != 0)
+      {
+         mError = errno;
+         TRACE( "cEventSet - Error %d adding event %lu, %s\n", 
+                mError, 
+                index,
+                strerror( mError ) );
+         return;
+      }
+   }
+}
+
+/*===========================================================================
+METHOD:
+   ~cEventSet (Public Method)
+   
+DESCRIPTION:
+   Destructor
+
+RETURN VALUE:
+   None
+===========================================================================*/
+cEventSet::~cEventSet()
+{
+   if (mEpoll != -1)
+   {
+      close( mEpoll );
+      mEpoll = -1;
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Wait (Public Method)
+   
+DESCRIPTION:
+   Wait for any of the events to be set and return the value
+
+   Note: If multiple events are set, only the one with the lowest index
+      will be read from.  Run this function again to get the next event.
+
+PARAMETERS:
+   timeoutMS   [ I ] - Relative timeout length (in milliseconds)
+   val         [ O ] - Associated value upon success
+   eventIndex  [ O ] - Index of event which was signaled
+   
+RETURN VALUE:
+   Return code
+      positive for number of events set
+      -ETIME on timeout
+      negative errno value on failure
+===========================================================================*/
+int cEventSet::Wait(
+   DWORD                      timeoutMS, 
+   DWORD &                    val,
+   DWORD &                    eventIndex )
+{
+   if (mError != 0)
+   {
+      return -mError;
+   }
+
+   // Check internal eventfds' status
+   for (ULONG index = 0; index < mEvents.size(); index++)
+   {
+      int error = mEvents[index]->mError;
+      if (error != 0)
+      {
+         TRACE( "cEvent %lu has error %d\n", index, error );
+         return -error;
+      }
+   }
+
+   std::vector <epoll_event> ready( std::max( (size_t)1, mEvents.size() ) );
+
+   // Wait for activity on the eventfds for the specified amount of time
+   int rc = epoll_wait( mEpoll, &ready[0], (int)ready.size(), (int)timeoutMS );
+   if (rc == -1)
+   {
+      TRACE( "cEventSet::Wait() error %d\n", errno );
+      return -errno;
+   }
+   else if (rc == 0)
+   {
+      // No activity on the eventfds
+      return -ETIME;
+   }
+
+   int numSignaled = rc;
+
+   // Only read from the first event which was signaled
+   ULONG signaled = mEvents.size();
+   for (int index = 0; index < numSignaled; index++)
+   {
+      signaled = std::min( signaled, (ULONG)ready[index].data.u32 );
+   }
+
+   if (signaled >= mEvents.size())
+   {
+      // Odd, no one was signaled
+      return -ENODATA;
+   }
+
+   DWORD tempVal = 0;
+   rc = mEvents[signaled]->Read( tempVal );
+   if (rc == 0)
+   {
+      // Success
+      val = tempVal;
+      eventIndex = signaled;
+      return numSignaled;
+   }
+   else if (rc == EAGAIN)
+   {
+      // Someone else consumed the value first
+      return -ETIME;
+   }
+   else
+   {
+      // failure
+      return -rc;
+   }
 }
@@ -8,9 +8,11 @@ DESCRIPTION:
 PUBLIC CLASSES AND METHODS:
    WaitOnMultipleEvents
    cEvent
-      Functionality to mimic Windows events using UNIX pipes (enhanced
+      Functionality to mimic Windows events using an eventfd (enhanced
       somewhat to allow one to specify a DWORD value to pass through
       when signalling the event)
+   cEventSet
+      Persistent set of events to wait on repeatedly
 
    WARNING:
       This class is not designed to be thread safe
@@ -52,6 +54,8 @@ POSSIBILITY OF SUCH DAMAGE.
 //---------------------------------------------------------------------------
 #include "StdAfx.h"
 #include <vector>
+#include <deque>
+#include <pthread.h>
 
 //---------------------------------------------------------------------------
 // Prototype
@@ -90,21 +94,27 @@ class cEvent
          DWORD                      timeoutMS, 
          DWORD &                    val );
 
-      // Read and discard all values currently in the pipe
+      // Read and discard all values currently queued
       void Clear();
 
    protected:
-      // Close pipe (used in errors or normal exit)
+      // Close eventfd (used in errors or normal exit)
       int Close();
 
-      // Read from the pipe
+      // Read the next value, without blocking
       int Read( DWORD & val );
 
       /* Internal error status */
       int mError;
       
-      /*  Internal pipes */
-      int mPipes[2];
+      /* Internal eventfd (semaphore mode, counts the queued values) */
+      int mEventFD;
+
+      /* Values passed through, in the order they were set */
+      std::deque <DWORD> mValues;
+
+      /* Mutex protecting the above queue */
+      pthread_mutex_t mValuesMutex;
 
       // WaitOnMultipleEvents gets full access
       friend int WaitOnMultipleEvents(
@@ -112,5 +122,36 @@ class cEvent
          DWORD                         timeoutMS, 
          DWORD &                       val,
          DWORD &                       eventIndex );
+
+      // Event sets get full access
+      friend class cEventSet;
 };
 
+/*=========================================================================*/
+// Class cEventSet
+/*=========================================================================*/
+class cEventSet
+{
+   public:
+      // Constructor
+      cEventSet( const std::vector <cEvent *> & events );
+
+      // Destructor
+      ~cEventSet();
+
+      // Wait for any of the events to be set and return the value
+      int Wait(
+         DWORD                      timeoutMS, 
+         DWORD &                    val,
+         DWORD &                    eventIndex );
+
+   protected:
+      /* Events in the set */
+      std::vector <cEvent *> mEvents;
+
+      /* epoll handle watching all of the events */
+      int mEpoll;
+
+      /* Internal error status */
+      int mError;
+};
@@ -0,0 +1,742 @@
+/*===========================================================================
+FILE:
+   IOMultiplexer.cpp
+
+DESCRIPTION:
+   Implementation of cIOMultiplexer class
+   
+PUBLIC CLASSES AND METHODS:
+   cIOMultiplexer
+      Single epoll driven thread serving the receive operations and the
+      request schedules of several connections/protocol servers, so that
+      a device does not need a thread pair per service
+
+Copyright (c) 2013, The Linux Foundation. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of The Linux Foundation nor the names of its
+      contributors may be used to endorse or promote products derived from 
+      this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "StdAfx.h"
+#include "IOMultiplexer.h"
+#include "ProtocolServer.h"
+
+#include <sys/epoll.h>
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Maximum number of events handled per epoll_wait() call
+const int MAX_EVENTS = 16;
+
+// epoll key used for the wake up pipe
+const ULONGLONG WAKE_KEY = ~0ULL;
+
+// Build the epoll key of a watched handle
+inline ULONGLONG ReaderKey( int handle, ULONG generation )
+{
+   return ((ULONGLONG)(generation & 0xFFFFFFFF) << 32) | (unsigned int)handle;
+}
+
+/*=========================================================================*/
+// Free Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   IOMultiplexerThread (Free Method)
+
+DESCRIPTION:
+   Thread serving all the handles and schedules of a multiplexer
+
+PARAMETERS:
+   pData      [ I ]   Multiplexer object
+
+RETURN VALUE:
+   void * - thread exit value (always 0)
+===========================================================================*/
+void * IOMultiplexerThread( void * pData )
+{
+   cIOMultiplexer * pMux = (cIOMultiplexer *)pData;
+   if (pMux == 0)
+   {
+      return 0;
+   }
+
+   TRACE( "I/O multiplexer thread [%lu] started\n", pthread_self() );
+
+   epoll_event events[MAX_EVENTS];
+   while (true)
+   {
+      pthread_mutex_lock( &pMux->mMutex );
+      bool bExiting = pMux->mbExiting;
+      int waitTime = pMux->GetWaitTime();
+      pthread_mutex_unlock( &pMux->mMutex );
+
+      if (bExiting == true)
+      {
+         break;
+      }
+
+      int count = epoll_wait( pMux->mEpoll, &events[0], MAX_EVENTS, waitTime );
+      if (count < 0)
+      {
+         if (errno == EINTR)
+         {
+            continue;
+         }
+
+         TRACE( "error %d in epoll_wait, errno %d\n", count, errno );
+         break;
+      }
+
+      for (int e = 0; e < count; e++)
+      {
+         if (events[e].data.u64 == WAKE_KEY)
+         {
+            // Drain the wake up pipe
+            BYTE cmd[MAX_EVENTS];
+            read( pMux->mWakePipe[READING], &cmd[0], sizeof( cmd ) );
+
+            pthread_mutex_lock( &pMux->mMutex );
+            pMux->mbWakePending = false;
+            pthread_mutex_unlock( &pMux->mMutex );
+         }
+         else
+         {
+            pMux->DispatchRead( events[e].data.u64 );
+         }
+      }
+
+      // Schedules go after the reads, so that responses are matched
+      // before their requests are considered timed out
+      pMux->DispatchSchedules();
+   }
+
+   TRACE( "I/O multiplexer thread [%lu] exited\n", pthread_self() );
+   return 0;
+}
+
+/*=========================================================================*/
+// cIOMultiplexer Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cIOMultiplexer (Public Method)
+
+DESCRIPTION:
+   Constructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cIOMultiplexer::cIOMultiplexer()
+   :  mEpoll( INVALID_HANDLE_VALUE ),
+      mbWakePending( false ),
+      mbExiting( false ),
+      mThreadID( 0 ),
+      mpDispatching( 0 ),
+      mLastGeneration( 0 )
+{
+   mWakePipe[READING] = INVALID_HANDLE_VALUE;
+   mWakePipe[WRITING] = INVALID_HANDLE_VALUE;
+
+   pthread_mutex_init( &mMutex, NULL );
+   pthread_cond_init( &mDispatchDone, NULL );
+}
+
+/*===========================================================================
+METHOD:
+   ~cIOMultiplexer (Public Method)
+
+DESCRIPTION:
+   Destructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cIOMultiplexer::~cIOMultiplexer()
+{
+   Stop();
+
+   pthread_cond_destroy( &mDispatchDone );
+   pthread_mutex_destroy( &mMutex );
+}
+
+/*===========================================================================
+METHOD:
+   Start (Public Method)
+
+DESCRIPTION:
+   Start the I/O thread
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::Start()
+{
+   if (mThreadID != 0)
+   {
+      // Already running
+      return true;
+   }
+
+   mEpoll = epoll_create( MAX_EVENTS );
+   if (mEpoll == INVALID_HANDLE_VALUE)
+   {
+      TRACE( "cIOMultiplexer::Start() epoll creation failed %d\n", errno );
+      return false;
+   }
+
+   int nRet = pipe( mWakePipe );
+   if (nRet != 0)
+   {
+      TRACE( "cIOMultiplexer::Start() pipe creation failed %d\n", nRet );
+
+      Stop();
+      return false;
+   }
+
+   epoll_event event;
+   memset( &event, 0, sizeof( event ) );
+   event.events = EPOLLIN;
+   event.data.u64 = WAKE_KEY;
+
+   nRet = epoll_ctl( mEpoll, EPOLL_CTL_ADD, mWakePipe[READING], &event );
+   if (nRet != 0)
+   {
+      TRACE( "cIOMultiplexer::Start() epoll_ctl = %d\n", errno );
+
+      Stop();
+      return false;
+   }
+
+   mbExiting = false;
+   mbWakePending = false;
+
+   nRet = pthread_create( &mThreadID, 0, IOMultiplexerThread, this );
+   if (nRet != 0)
+   {
+      TRACE( "cIOMultiplexer::Start() pthread_create = %d\n", nRet );
+
+      mThreadID = 0;
+      Stop();
+      return false;
+   }
+
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   Stop (Public Method)
+
+DESCRIPTION:
+   Stop the I/O thread, every client should have already been removed
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::Stop()
+{
+   // Assume success
+   bool bRC = true;
+
+   if (mThreadID != 0)
+   {
+      pthread_mutex_lock( &mMutex );
+      mbExiting = true;
+      Wake();
+      pthread_mutex_unlock( &mMutex );
+
+      TRACE( "cIOMultiplexer::Stop() joining thread %lu\n", mThreadID );
+      int nRC = pthread_join( mThreadID, 0 );
+      if (nRC != 0)
+      {
+         TRACE( "failed to join thread %d\n", nRC );
+         bRC = false;
+      }
+
+      mThreadID = 0;
+   }
+
+   if (mWakePipe[WRITING] != INVALID_HANDLE_VALUE)
+   {
+      close( mWakePipe[WRITING] );
+      close( mWakePipe[READING] );
+      mWakePipe[READING] = INVALID_HANDLE_VALUE;
+      mWakePipe[WRITING] = INVALID_HANDLE_VALUE;
+   }
+
+   if (mEpoll != INVALID_HANDLE_VALUE)
+   {
+      close( mEpoll );
+      mEpoll = INVALID_HANDLE_VALUE;
+   }
+
+   mReaders.clear();
+   mSchedules.clear();
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   WatchRead (Public Method)
+
+DESCRIPTION:
+   Watch a handle for a single read operation; once the handle is ready
+   the client is notified through ReadReady() and needs to call this
+   again for the next read
+
+PARAMETERS:
+   handle      [ I ] - Handle to watch
+   pClient     [ I ] - Client to notify
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::WatchRead(
+   int                        handle,
+   cIOMultiplexerClient *     pClient )
+{
+   if (handle == INVALID_HANDLE_VALUE || pClient == 0)
+   {
+      return false;
+   }
+
+   pthread_mutex_lock( &mMutex );
+
+   if (mEpoll == INVALID_HANDLE_VALUE)
+   {
+      pthread_mutex_unlock( &mMutex );
+      return false;
+   }
+
+   int op = EPOLL_CTL_MOD;
+
+   std::map <int, sReader>::iterator pIter = mReaders.find( handle );
+   if (pIter == mReaders.end() || pIter->second.mpClient != pClient)
+   {
+      if (pIter != mReaders.end())
+      {
+         // Handle was reused by another client
+         epoll_ctl( mEpoll, EPOLL_CTL_DEL, handle, 0 );
+      }
+
+      sReader reader;
+      reader.mpClient = pClient;
+      reader.mGeneration = ++mLastGeneration;
+      reader.mbArmed = false;
+
+      mReaders[handle] = reader;
+      pIter = mReaders.find( handle );
+      op = EPOLL_CTL_ADD;
+   }
+
+   epoll_event event;
+   memset( &event, 0, sizeof( event ) );
+   event.events = EPOLLIN | EPOLLONESHOT;
+   event.data.u64 = ReaderKey( handle, pIter->second.mGeneration );
+
+   int nRet = epoll_ctl( mEpoll, op, handle, &event );
+   if (nRet != 0 && op == EPOLL_CTL_MOD && errno == ENOENT)
+   {
+      // Handle was closed (and reopened) without being unwatched
+      nRet = epoll_ctl( mEpoll, EPOLL_CTL_ADD, handle, &event );
+   }
+
+   if (nRet != 0)
+   {
+      TRACE( "cIOMultiplexer::WatchRead() epoll_ctl = %d\n", errno );
+
+      mReaders.erase( pIter );
+      pthread_mutex_unlock( &mMutex );
+      return false;
+   }
+
+   pIter->second.mbArmed = true;
+
+   pthread_mutex_unlock( &mMutex );
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   UnwatchRead (Public Method)
+
+DESCRIPTION:
+   Stop watching a handle, once this returns the client is guaranteed
+   not to be notified anymore (for the handle)
+
+PARAMETERS:
+   handle      [ I ] - Handle to stop watching
+   pClient     [ I ] - Client that was being notified
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::UnwatchRead(
+   int                        handle,
+   cIOMultiplexerClient *     pClient )
+{
+   pthread_mutex_lock( &mMutex );
+
+   std::map <int, sReader>::iterator pIter = mReaders.find( handle );
+   if (pIter == mReaders.end() || pIter->second.mpClient != pClient)
+   {
+      pthread_mutex_unlock( &mMutex );
+      return false;
+   }
+
+   mReaders.erase( pIter );
+   epoll_ctl( mEpoll, EPOLL_CTL_DEL, handle, 0 );
+
+   WaitForDispatch( pClient );
+
+   pthread_mutex_unlock( &mMutex );
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   AddSchedule (Public Method)
+
+DESCRIPTION:
+   Add a schedule to be processed by the I/O thread, the client is
+   notified through ScheduleDue() right away and then whenever the
+   schedule is signalled or the time it returned is reached
+
+PARAMETERS:
+   pClient     [ I ] - Client owning the schedule
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::AddSchedule( cIOMultiplexerClient * pClient )
+{
+   if (pClient == 0)
+   {
+      return false;
+   }
+
+   pthread_mutex_lock( &mMutex );
+
+   if (mThreadID == 0 || mbExiting == true)
+   {
+      pthread_mutex_unlock( &mMutex );
+      return false;
+   }
+
+   sSchedule schedule;
+   schedule.mNextTime = TimeIn( 0 );
+   schedule.mbSignalled = true;
+   mSchedules[pClient] = schedule;
+
+   Wake();
+
+   pthread_mutex_unlock( &mMutex );
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   RemoveSchedule (Public Method)
+
+DESCRIPTION:
+   Remove a previously added schedule, once this returns the client is
+   guaranteed not to be notified anymore (for the schedule)
+
+PARAMETERS:
+   pClient     [ I ] - Client owning the schedule
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::RemoveSchedule( cIOMultiplexerClient * pClient )
+{
+   pthread_mutex_lock( &mMutex );
+
+   bool bRC = (mSchedules.erase( pClient ) > 0);
+   WaitForDispatch( pClient );
+
+   pthread_mutex_unlock( &mMutex );
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   SignalSchedule (Public Method)
+
+DESCRIPTION:
+   Signal a schedule to be processed as soon as possible
+
+PARAMETERS:
+   pClient     [ I ] - Client owning the schedule
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cIOMultiplexer::SignalSchedule( cIOMultiplexerClient * pClient )
+{
+   pthread_mutex_lock( &mMutex );
+
+   std::map <cIOMultiplexerClient *, sSchedule>::iterator pIter;
+   pIter = mSchedules.find( pClient );
+   if (pIter == mSchedules.end())
+   {
+      pthread_mutex_unlock( &mMutex );
+      return false;
+   }
+
+   pIter->second.mbSignalled = true;
+   Wake();
+
+   pthread_mutex_unlock( &mMutex );
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   Wake (Internal Method)
+
+DESCRIPTION:
+   Wake the I/O thread up
+
+SEQUENCING:
+   Calling process must have lock
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cIOMultiplexer::Wake()
+{
+   if (mbWakePending == true || mWakePipe[WRITING] == INVALID_HANDLE_VALUE)
+   {
+      return;
+   }
+
+   BYTE byte = 0;
+   int nRC = write( mWakePipe[WRITING], &byte, 1 );
+   if (nRC != 1)
+   {
+      TRACE( "error %d waking I/O thread\n", nRC );
+      return;
+   }
+
+   mbWakePending = true;
+}
+
+/*===========================================================================
+METHOD:
+   WaitForDispatch (Internal Method)
+
+DESCRIPTION:
+   Wait for the I/O thread to finish with the given client (unless we are
+   the I/O thread, i.e. the client is removing itself from a notification)
+
+SEQUENCING:
+   Calling process must have lock
+
+PARAMETERS:
+   pClient     [ I ] - Client to wait for
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cIOMultiplexer::WaitForDispatch( cIOMultiplexerClient * pClient )
+{
+   if (mThreadID != 0 && pthread_equal( mThreadID, pthread_self() ) != 0)
+   {
+      return;
+   }
+
+   while (mpDispatching == pClient)
+   {
+      pthread_cond_wait( &mDispatchDone, &mMutex );
+   }
+}
+
+/*===========================================================================
+METHOD:
+   DispatchRead (Internal Method)
+
+DESCRIPTION:
+   Dispatch a ready handle to its client
+
+SEQUENCING:
+   Only called by the I/O thread
+
+PARAMETERS:
+   key         [ I ] - epoll key of the ready handle
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cIOMultiplexer::DispatchRead( ULONGLONG key )
+{
+   int handle = (int)(unsigned int)(key & 0xFFFFFFFF);
+   ULONG generation = (ULONG)(key >> 32);
+
+   pthread_mutex_lock( &mMutex );
+
+   // Stale event for a handle that was unwatched (or reused)?
+   std::map <int, sReader>::iterator pIter = mReaders.find( handle );
+   if (pIter == mReaders.end()
+   ||  (pIter->second.mGeneration & 0xFFFFFFFF) != generation
+   ||  pIter->second.mbArmed == false)
+   {
+      pthread_mutex_unlock( &mMutex );
+      return;
+   }
+
+   cIOMultiplexerClient * pClient = pIter->second.mpClient;
+   pIter->second.mbArmed = false;
+   mpDispatching = pClient;
+
+   pthread_mutex_unlock( &mMutex );
+
+   pClient->ReadReady();
+
+   pthread_mutex_lock( &mMutex );
+   mpDispatching = 0;
+   pthread_cond_broadcast( &mDispatchDone );
+   pthread_mutex_unlock( &mMutex );
+}
+
+/*===========================================================================
+METHOD:
+   DispatchSchedules (Internal Method)
+
+DESCRIPTION:
+   Dispatch all the schedules that are due to their clients
+
+SEQUENCING:
+   Only called by the I/O thread
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cIOMultiplexer::DispatchSchedules()
+{
+   timespec curTime = TimeIn( 0 );
+
+   pthread_mutex_lock( &mMutex );
+
+   // Clients may add/remove schedules while we are dispatching, so walk
+   // the map by key instead of holding on to an iterator
+   std::map <cIOMultiplexerClient *, sSchedule>::iterator pIter;
+   pIter = mSchedules.begin();
+
+   while (pIter != mSchedules.end() && mbExiting == false)
+   {
+      cIOMultiplexerClient * pClient = pIter->first;
+      sSchedule & schedule = pIter->second;
+
+      if (schedule.mbSignalled == true || schedule.mNextTime <= curTime)
+      {
+         schedule.mbSignalled = false;
+         mpDispatching = pClient;
+
+         pthread_mutex_unlock( &mMutex );
+
+         timespec nextTime = curTime;
+         bool bKeep = pClient->ScheduleDue( nextTime );
+
+         pthread_mutex_lock( &mMutex );
+
+         pIter = mSchedules.find( pClient );
+         if (pIter != mSchedules.end())
+         {
+            if (bKeep == true)
+            {
+               pIter->second.mNextTime = nextTime;
+            }
+            else
+            {
+               mSchedules.erase( pIter );
+            }
+         }
+
+         mpDispatching = 0;
+         pthread_cond_broadcast( &mDispatchDone );
+      }
+
+      pIter = mSchedules.upper_bound( pClient );
+   }
+
+   pthread_mutex_unlock( &mMutex );
+}
+
+/*===========================================================================
+METHOD:
+   GetWaitTime (Internal Method)
+
+DESCRIPTION:
+   Return the time to wait until the next schedule is due
+
+SEQUENCING:
+   Calling process must have lock
+
+RETURN VALUE:
+   int - Milliseconds to wait (-1 to wait forever)
+===========================================================================*/
+int cIOMultiplexer::GetWaitTime()
+{
+   if (mSchedules.size() == 0)
+   {
+      return -1;
+   }
+
+   std::map <cIOMultiplexerClient *, sSchedule>::const_iterator pIter;
+   pIter = mSchedules.begin();
+
+   timespec nextTime = pIter->second.mNextTime;
+   while (pIter != mSchedules.end())
+   {
+      if (pIter->second.mbSignalled == true)
+      {
+         return 0;
+      }
+
+      if (pIter->second.mNextTime < nextTime)
+      {
+         nextTime = pIter->second.mNextTime;
+      }
+
+      pIter++;
+   }
+
+   ULONG waitTime = TimeFromNow( nextTime );
+   if (waitTime > (ULONG)INT_MAX)
+   {
+      waitTime = (ULONG)INT_MAX;
+   }
+
+   return (int)waitTime;
+}
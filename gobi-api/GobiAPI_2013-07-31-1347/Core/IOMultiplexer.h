@@ -0,0 +1,195 @@
+/*===========================================================================
+FILE:
+   IOMultiplexer.h
+
+DESCRIPTION:
+   Declaration of cIOMultiplexer class
+   
+PUBLIC CLASSES AND METHODS:
+   cIOMultiplexerClient
+      Interface for objects served by a cIOMultiplexer
+   cIOMultiplexer
+      Single epoll driven thread serving the receive operations and the
+      request schedules of several connections/protocol servers, so that
+      a device does not need a thread pair per service
+
+Copyright (c) 2013, The Linux Foundation. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of The Linux Foundation nor the names of its
+      contributors may be used to endorse or promote products derived from 
+      this software without specific prior written permission.
+
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+POSSIBILITY OF SUCH DAMAGE.
+===========================================================================*/
+
+//---------------------------------------------------------------------------
+// Pragmas
+//---------------------------------------------------------------------------
+#pragma once
+
+//---------------------------------------------------------------------------
+// Include Files
+//---------------------------------------------------------------------------
+#include "StdAfx.h"
+
+#include <map>
+
+/*=========================================================================*/
+// Class cIOMultiplexerClient
+/*=========================================================================*/
+class cIOMultiplexerClient
+{
+   public:
+      // (Inline) Constructor
+      cIOMultiplexerClient() { };
+
+      // (Inline) Destructor
+      virtual ~cIOMultiplexerClient() { };
+
+      // (Inline) The watched handle has data available to be read
+      virtual void ReadReady() { };
+
+      // (Inline) The schedule was signalled or its wakeup time was reached,
+      // process it and return whether the client should remain scheduled
+      virtual bool ScheduleDue( timespec & /* nextTime */ )
+      {
+         return false;
+      };
+};
+
+/*=========================================================================*/
+// Class cIOMultiplexer
+/*=========================================================================*/
+class cIOMultiplexer
+{
+   public:
+      // Constructor
+      cIOMultiplexer();
+
+      // Destructor
+      ~cIOMultiplexer();
+
+      // Start the I/O thread
+      bool Start();
+
+      // Stop the I/O thread
+      bool Stop();
+
+      // (Inline) Is the I/O thread running?
+      bool IsRunning()
+      {
+         return (mThreadID != 0);
+      };
+
+      // Watch a handle for a single read operation
+      bool WatchRead(
+         int                        handle,
+         cIOMultiplexerClient *     pClient );
+
+      // Stop watching a handle
+      bool UnwatchRead(
+         int                        handle,
+         cIOMultiplexerClient *     pClient );
+
+      // Add a schedule to be processed by the I/O thread
+      bool AddSchedule( cIOMultiplexerClient * pClient );
+
+      // Remove a previously added schedule
+      bool RemoveSchedule( cIOMultiplexerClient * pClient );
+
+      // Signal a schedule to be processed as soon as possible
+      bool SignalSchedule( cIOMultiplexerClient * pClient );
+
+   protected:
+      // Wake the I/O thread up
+      void Wake();
+
+      // Wait for the I/O thread to finish with the given client
+      void WaitForDispatch( cIOMultiplexerClient * pClient );
+
+      // Dispatch a ready handle to its client
+      void DispatchRead( ULONGLONG key );
+
+      // Dispatch all the schedules that are due
+      void DispatchSchedules();
+
+      // Return the time to wait until the next schedule is due
+      int GetWaitTime();
+
+      /* Watched handle information */
+      struct sReader
+      {
+         /* Client to notify */
+         cIOMultiplexerClient * mpClient;
+
+         /* Registration generation (discards stale events) */
+         ULONG mGeneration;
+
+         /* Is a read operation pending? */
+         bool mbArmed;
+      };
+
+      /* Schedule information */
+      struct sSchedule
+      {
+         /* Absolute time the schedule needs to be processed */
+         timespec mNextTime;
+
+         /* Has the schedule been signalled? */
+         bool mbSignalled;
+      };
+
+      /* epoll handle */
+      int mEpoll;
+
+      /* Pipe used to wake the I/O thread up */
+      int mWakePipe[2];
+
+      /* Is there already a pending wake up in the pipe? */
+      bool mbWakePending;
+
+      /* Is the thread in the process of exiting? */
+      bool mbExiting;
+
+      /* Thread ID of the I/O thread */
+      pthread_t mThreadID;
+
+      /* Mutex protecting all of the below */
+      pthread_mutex_t mMutex;
+
+      /* Signalled when the I/O thread finishes with a client */
+      pthread_cond_t mDispatchDone;
+
+      /* Client currently being served by the I/O thread */
+      cIOMultiplexerClient * mpDispatching;
+
+      /* Last assigned handle registration generation */
+      ULONG mLastGeneration;
+
+      /* Watched handles (handle mapped to reader information) */
+      std::map <int, sReader> mReaders;
+
+      /* Schedules (client mapped to schedule information) */
+      std::map <cIOMultiplexerClient *, sSchedule> mSchedules;
+
+      // I/O thread gets full access
+      friend void * IOMultiplexerThread( void * pData );
+};
@@ -7,10 +7,10 @@ DESCRIPTION:
    
 PUBLIC CLASSES AND METHODS:
    cProtocolLog
-      This class stores protocol buffers in to a flat array (actually a
-      double-ended queue) so that they can be accessed by other objects 
-      during the flow of normal processing.  Note that the storage is
-      in-memory and therefore finite
+      This class stores protocol buffers in to a fixed size ring so that
+      they can be accessed by other objects during the flow of normal
+      processing.  Note that the storage is in-memory and therefore
+      finite, once the ring is full the oldest buffer is overwritten
 
 Copyright (c) 2013, The Linux Foundation. All rights reserved.
 
@@ -45,6 +45,8 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "StdAfx.h"
 #include "ProtocolLog.h"
 
+#include <sched.h>
+
 //---------------------------------------------------------------------------
 // Definitions
 //---------------------------------------------------------------------------
@@ -52,6 +54,9 @@ POSSIBILITY OF SUCH DAMAGE.
 // The maximum number of in-memory buffers we allow
 const ULONG MAX_PROTOCOL_BUFFERS = 1024 * 16;
 
+// The minimum number of in-memory buffers we allow
+const ULONG MIN_PROTOCOL_BUFFERS = 16;
+
 /*=========================================================================*/
 // cProtocolLog Methods
 /*=========================================================================*/
@@ -65,15 +70,44 @@ DESCRIPTION:
 
 PARAMETERS:
    maxBuffers  [ I ] - Maximum number of buffers to store in the log
+                       (rounded up to a power of two)
   
 RETURN VALUE:
    None
 ===========================================================================*/
 cProtocolLog::cProtocolLog( ULONG maxBuffers )
-   :  mLog( maxBuffers > MAX_PROTOCOL_BUFFERS ? MAX_PROTOCOL_BUFFERS : maxBuffers,
-            true )
+   :  mSlots(),
+      mMask( 0 ),
+      mCount( 0 ),
+      mSignalEvent()
 {
-   // Nothing to do
+   int nRet = pthread_mutex_init( &mWriteMutex, NULL );
+   if (nRet != 0)
+   {
+      TRACE( "ProtocolLog: Unable to init write mutex. Error %d: %s\n",
+             nRet,
+             strerror( nRet ) );
+   }
+
+   if (maxBuffers > MAX_PROTOCOL_BUFFERS)
+   {
+      maxBuffers = MAX_PROTOCOL_BUFFERS;
+   }
+   else if (maxBuffers < MIN_PROTOCOL_BUFFERS)
+   {
+      maxBuffers = MIN_PROTOCOL_BUFFERS;
+   }
+
+   // All storage is allocated up front (rounded up to a power of two so
+   // a log index maps to its slot with a mask), the ring never grows
+   ULONG slots = MIN_PROTOCOL_BUFFERS;
+   while (slots < maxBuffers)
+   {
+      slots <<= 1;
+   }
+
+   mSlots.resize( slots );
+   mMask = slots - 1;
 }
 
 /*===========================================================================
@@ -90,6 +124,8 @@ cProtocolLog::~cProtocolLog()
 {
    // Empty out the log
    Clear();
+
+   pthread_mutex_destroy( &mWriteMutex );
 }
 
 /*===========================================================================
@@ -97,7 +133,8 @@ METHOD:
    AddBuffer (Public Method)
 
 DESCRIPTION:
-   Add an protocol buffer to the end of the log
+   Add an protocol buffer to the end of the log, overwriting the oldest
+   buffer once the log is full
 
 PARAMETERS:
    buff        [ I ] - Protocol buffer to add
@@ -113,12 +150,40 @@ ULONG cProtocolLog::AddBuffer( sProtocolBuffer & buf )
       return idx;
    }
 
-   bool bRC = mLog.AddElement( buf, idx );
-   if (bRC == false)
+   int nRet = pthread_mutex_lock( &mWriteMutex );
+   if (nRet != 0)
    {
-      idx = INVALID_LOG_INDEX;
+      TRACE( "ProtocolLog: Unable to lock write mutex. Error %d: %s\n",
+             nRet,
+             strerror( nRet ) );
+      return idx;
    }
-    
+
+   idx = mCount;
+
+   // The index that marks a slot as being written is never stored
+   if (idx != INVALID_LOG_INDEX)
+   {
+      sSlot & slot = mSlots[idx & mMask];
+      AcquireSlot( slot );
+
+      slot.mBuffer = buf;
+      __atomic_store_n( &slot.mIndex, idx, __ATOMIC_RELEASE );
+   }
+
+   __atomic_store_n( &mCount, idx + 1, __ATOMIC_RELEASE );
+
+   // Signal index of buffer (the buffer has been published already, so
+   // its index is returned even if signalling fails)
+   nRet = mSignalEvent.Set( (DWORD)idx );
+   if (nRet != 0)
+   {
+      TRACE( "ProtocolLog: Unable to signal. Error %d: %s\n",
+             nRet,
+             strerror( nRet ) );
+   }
+
+   pthread_mutex_unlock( &mWriteMutex );
    return idx;
 }
 
@@ -129,16 +194,47 @@ METHOD:
 DESCRIPTION:
    Return the protocol buffer at the given index from the log
 
+   Readers never block, each slot records the log index of the buffer it
+   holds so a buffer that has been overwritten (or not yet written) is
+   detected and returned as an invalid buffer rather than returning the
+   buffer that has taken its place
+
 PARAMETERS:
    idx         [ I ] - Index of protocol buffer to obtain
 
 RETURN VALUE:
-   sProtocolBuffer - Protocol buffer
+   sProtocolBuffer - Protocol buffer (invalid if no longer in the log)
 ===========================================================================*/
 sProtocolBuffer cProtocolLog::GetBuffer( ULONG idx ) const
 {
    sProtocolBuffer buf;
-   mLog.GetElement( idx, buf );
+   if (idx == INVALID_LOG_INDEX)
+   {
+      return buf;
+   }
+
+   sSlot & slot = mSlots[idx & mMask];
+
+   // Not (or no longer) in the log? Checking before registering as a
+   // reader means that a writer never waits on readers that arrive after
+   // it has marked the slot
+   if (__atomic_load_n( &slot.mIndex, __ATOMIC_RELAXED ) != idx)
+   {
+      return buf;
+   }
+
+   // Register as a reader before checking the index again, a writer marks
+   // the slot before checking for readers, so either we see the mark or
+   // the writer waits for us to finish copying
+   __atomic_add_fetch( &slot.mReaders, 1, __ATOMIC_SEQ_CST );
+
+   if (__atomic_load_n( &slot.mIndex, __ATOMIC_SEQ_CST ) == idx)
+   {
+      buf = slot.mBuffer;
+   }
+
+   __atomic_sub_fetch( &slot.mReaders, 1, __ATOMIC_RELEASE );
+
    return buf;
 }
 
@@ -155,7 +251,7 @@ RETURN VALUE:
 ===========================================================================*/
 cEvent & cProtocolLog::GetSignalEvent() const
 {
-   return mLog.GetSignalEvent();
+   return mSignalEvent;
 }
 
 /*===========================================================================
@@ -170,7 +266,7 @@ RETURN VALUE:
 ===========================================================================*/
 ULONG cProtocolLog::GetCount() const
 {
-   return mLog.GetTotalCount();
+   return __atomic_load_n( &mCount, __ATOMIC_ACQUIRE );
 }
 
 /*===========================================================================
@@ -185,5 +281,48 @@ RETURN VALUE:
 ===========================================================================*/
 void cProtocolLog::Clear()
 {
-   mLog.EmptyQueue();
+   pthread_mutex_lock( &mWriteMutex );
+
+   for (ULONG s = 0; s < (ULONG)mSlots.size(); s++)
+   {
+      sSlot & slot = mSlots[s];
+      AcquireSlot( slot );
+
+      slot.mBuffer = sProtocolBuffer();
+      __atomic_store_n( &slot.mIndex, 0, __ATOMIC_RELEASE );
+   }
+
+   __atomic_store_n( &mCount, 0, __ATOMIC_RELEASE );
+
+   pthread_mutex_unlock( &mWriteMutex );
+}
+
+/*===========================================================================
+METHOD:
+   AcquireSlot (Internal Method)
+
+DESCRIPTION:
+   Take ownership of a slot for writing, i.e. mark the slot as being
+   written and wait for readers still copying the old buffer to finish
+
+PARAMETERS:
+   slot        [ I ] - Slot to acquire
+
+SEQUENCING:
+   Calling process must have lock on mWriteMutex
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cProtocolLog::AcquireSlot( sSlot & slot )
+{
+   __atomic_store_n( &slot.mIndex, INVALID_LOG_INDEX, __ATOMIC_SEQ_CST );
+
+   // Readers register before checking the index again, any reader that
+   // has not registered by now will see the slot is being written (and
+   // readers only copy the buffer, so this wait is short)
+   while (__atomic_load_n( &slot.mReaders, __ATOMIC_SEQ_CST ) != 0)
+   {
+      sched_yield();
+   }
 }
@@ -7,10 +7,10 @@ DESCRIPTION:
    
 PUBLIC CLASSES AND METHODS:
    cProtocolLog
-      This class stores protocol buffers in to a flat array (actually a
-      double-ended queue) so that they can be accessed by other objects 
-      during the flow of normal processing.  Note that the storage is
-      in-memory and therefore finite
+      This class stores protocol buffers in to a fixed size ring so that
+      they can be accessed by other objects during the flow of normal
+      processing.  Note that the storage is in-memory and therefore
+      finite, once the ring is full the oldest buffer is overwritten
 
 Copyright (c) 2013, The Linux Foundation. All rights reserved.
 
@@ -48,9 +48,10 @@ POSSIBILITY OF SUCH DAMAGE.
 // Include Files
 //---------------------------------------------------------------------------
 #include "ProtocolBuffer.h"
-#include "SyncQueue.h"
+#include "Event.h"
 
 #include <climits>
+#include <vector>
 
 //---------------------------------------------------------------------------
 // Definitions
@@ -81,10 +82,53 @@ class cProtocolLog
       // Return the total number of buffers added to the log
       virtual ULONG GetCount() const;
 
+      // (Inline) Return the number of buffers the log holds at once
+      ULONG GetCapacity() const
+      {
+         return (ULONG)mSlots.size();
+      };
+
       // Clear the log
       virtual void Clear();
 
    protected:
-      /* The underlying 'log' */
-      cSyncQueue <sProtocolBuffer> mLog;
+      /* A ring slot */
+      struct sSlot
+      {
+         sSlot()
+            :  mIndex( 0 ),
+               mReaders( 0 ),
+               mBuffer()
+         { };
+
+         /* Log index of the buffer held (INVALID_LOG_INDEX while the
+            slot is being written) */
+         ULONG mIndex;
+
+         /* Number of readers currently copying the buffer */
+         ULONG mReaders;
+
+         /* The buffer */
+         sProtocolBuffer mBuffer;
+      };
+
+      // Take ownership of a slot for writing
+      void AcquireSlot( sSlot & slot );
+
+      /* The underlying 'log', log index N is held in slot N & mMask */
+      mutable std::vector <sSlot> mSlots;
+
+      /* Number of slots - 1 (the number of slots is a power of two) */
+      ULONG mMask;
+
+      /* Writer mutex, buffers are added by one thread at a time (readers
+         never take it) */
+      pthread_mutex_t mWriteMutex;
+
+      /* Total number of buffers added to the log */
+      ULONG mCount;
+
+      /* Signal event, set (with the log index) every time a buffer
+         is added */
+      mutable cEvent mSignalEvent;
 };
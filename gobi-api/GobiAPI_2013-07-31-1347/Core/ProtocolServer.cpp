@@ -73,6 +73,9 @@ const ULONG MAX_PACKET_SIZE = 512;
 // Maximum amount of time to wait for the protocol server to process a command
 const ULONG COMMAND_TIME = DEADLOCK_TIME;
 
+// Default number of requests waiting for a response at once (stop-and-wait)
+const ULONG DEFAULT_PIPELINE_WINDOW = 1;
+
 /*=========================================================================*/
 // Free Methods
 /*=========================================================================*/
@@ -132,113 +135,21 @@ void * ScheduleThread( PVOID pArg )
          break;
       }
 
-      // Get Schedule Mutex (non-blocking)
-      nRet = pthread_mutex_trylock( &pServer->mScheduleMutex );
+      // Process the schedule
+      nRet = pServer->RunSchedule( toTime );
       if (nRet == EBUSY)
       {
          // Not an error, we're just too slow
          // Someone else got to the ScheduleMutex before us
          // We'll wait for the signal again
-         toTime = TimeIn( DEFAULT_WAIT );
          TRACE( "ScheduleThread [%lu] unable to lock ScheduleMutex\n", 
                 pthread_self() );
          continue;
       }
       else if (nRet != 0)
       {
-         // Error condition
-         TRACE( "ScheduleThread [%lu] mScheduleMutex error %d, %s\n",
-                pthread_self(),
-                nRet,
-                strerror( nRet ) );
          break;
       }
-
-      // Verify time.  In the rare event it does move backward
-      // it would simply place all our schedule items as due now
-      pServer->CheckSystemTime();
-      
-      // Default next wait period
-      toTime = TimeIn( DEFAULT_WAIT );
-
-      timespec curTime = TimeIn( 0 );
-
-      if (pServer->mpActiveRequest != 0)
-      {
-         if (pServer->mpActiveRequest->mbWaitingForResponse == true)
-         {
-            // Waiting on a response, this takes priority over the next
-            //    scheduled event
-            
-            // Has timeout expired?
-            if (pServer->mActiveRequestTimeout <= curTime)
-            {
-               // Response timeout
-   
-               // Note: This may clear mpActiveRequest
-               pServer->RxTimeout();
-            }
-            else
-            {
-               // Active response timer is not yet due to expire
-               // Default timeout again, or this response's timeout?
-               if (pServer->mActiveRequestTimeout <= toTime)
-               {
-                  toTime = pServer->mActiveRequestTimeout;
-               }
-            }
-         }
-         else
-         {
-            // This should never happen
-
-            TRACE( "ScheduleThread() Sequencing error: "
-                   "Active request %lu is not waiting for response ???\n",
-                   pServer->mpActiveRequest->mID );
-
-            break;
-         }
-      }
-
-      if (pServer->mpActiveRequest == 0 
-          && pServer->mRequestSchedule.size() > 0)
-      {
-         // No response timer active, ready to start the next 
-         //    scheduled item if due
-         
-         timespec scheduledItem = pServer->GetNextRequestTime();
-         
-         // Is item due to be scheduled?
-         if (scheduledItem <= curTime)
-         {
-            // Process scheduled item
-            pServer->ProcessRequest();
-         }
-         else
-         {
-            // Scheduled item is not yet due to be processed
-            // Default timeout again, or this item's start time?
-            if (scheduledItem <= toTime)
-            {
-               toTime = scheduledItem;
-            }
-         }
-      }
-      
-      /*TRACE( "Updated timer at %llu waiting %lu\n", 
-             GetTickCount(), 
-             TimeFromNow( toTime ) );  */
-      
-      // Unlock schedule mutex        
-      nRet = pthread_mutex_unlock( &pServer->mScheduleMutex );
-      if (nRet != 0)
-      {
-         TRACE( "ScheduleThread Unable to unlock schedule mutex."
-                " Error %d: %s\n",
-                nRet,
-                strerror( nRet ) );
-         return false;
-      }
    }
 
    TRACE( "Schedule thread [%lu] exited\n", 
@@ -255,18 +166,21 @@ DESCRIPTION:
    Fill timespec with the time it will be in specified milliseconds
    Relative time to Absolute time
 
+   NOTE: The monotonic clock is used so that the schedule (and response
+   timeouts) are not disturbed when the system time is changed
+
 PARAMETERS:
    millis   [ I ] - Milliseconds from current time
 
 RETURN VALUE:
-   timespec - resulting time (from epoc)
+   timespec - resulting time (CLOCK_MONOTONIC)
      NOTE: tv_sec of 0 is an error
 ===========================================================================*/
 timespec TimeIn( ULONG millis )
 {
    timespec outTime;
 
-   int nRC = clock_gettime( CLOCK_REALTIME, &outTime );
+   int nRC = clock_gettime( CLOCK_MONOTONIC, &outTime );
    if (nRC == 0)
    {
       // Add avoiding an overflow on (long)nsec
@@ -298,7 +212,7 @@ DESCRIPTION:
    Absolute time to Relative time
 
 PARAMETERS:
-   time   [ I ] - Absolute time
+   time   [ I ] - Absolute time (CLOCK_MONOTONIC, as returned by TimeIn())
 
 RETURN VALUE:
    Milliseconds in which absolute time will occur
@@ -310,7 +224,7 @@ ULONG TimeFromNow( timespec time )
    ULONG nOutTime = 0;
 
    timespec now;
-   int nRC = clock_gettime( CLOCK_REALTIME, &now );
+   int nRC = clock_gettime( CLOCK_MONOTONIC, &now );
    if (nRC == -1)
    {
       TRACE( "Error %d with gettime, %s\n", errno, strerror( errno ) );
@@ -336,8 +250,8 @@ DESCRIPTION:
    Provide a number for sequencing reference, similar to the windows
    ::GetTickCount().  
    
-   NOTE: This number is based on the time since epoc, not 
-   uptime.
+   NOTE: This number is based on the monotonic clock, it is not
+   affected by changes to the system time
 
 PARAMETERS:
 
@@ -413,6 +327,9 @@ cProtocolServer::sProtocolReqRsp::sProtocolReqRsp(
       mCurrentAuxTx( 0 ),
       mbWaitingForResponse( false )
 {
+   mTimeout.tv_sec = 0;
+   mTimeout.tv_nsec = 0;
+
    ULONG auxDataSz = 0;
    const BYTE * pAuxData = requestInfo.GetAuxiliaryData( auxDataSz );
 
@@ -452,7 +369,8 @@ cProtocolServer::sProtocolReqRsp::sProtocolReqRsp(
       mEncodedSize( reqRsp.mEncodedSize ),
       mRequiredAuxTxs( reqRsp.mRequiredAuxTxs ),
       mCurrentAuxTx( reqRsp.mCurrentAuxTx ),
-      mbWaitingForResponse( reqRsp.mbWaitingForResponse )
+      mbWaitingForResponse( reqRsp.mbWaitingForResponse ),
+      mTimeout( reqRsp.mTimeout )
 {
    // Nothing to do
 };
@@ -486,6 +404,7 @@ cProtocolServer::cProtocolServer(
    ULONG                      bufferSzRx,
    ULONG                      logSz )
    :  mpConnection( 0 ),
+      mpMultiplexer( 0 ),
       mConnectionType( eConnectionType_Begin ),
       mRxCallback(),
       mScheduleThreadID( 0 ),
@@ -494,14 +413,13 @@ cProtocolServer::cProtocolServer(
       mpServerControl( 0 ),
       mLastRequestID( 1 ),
       mpActiveRequest( 0 ),
+      mPipelineWindow( DEFAULT_PIPELINE_WINDOW ),
       mpRxBuffer( 0 ),
       mRxBufferSize( bufferSzRx ),
       mRxType( rxType ),
       mTxType( txType ),
       mLog( logSz )
 {
-   mLastTime = TimeIn( 0 );
-
    // Allocate receive buffer?
    if (mRxBufferSize > 0)
    {
@@ -598,68 +516,75 @@ bool cProtocolServer::HandleRemoveRequest( ULONG reqID )
       // Success!
       bRC = true;
 
-      // Find and erase request from schedule
-      bool bFound = false;
-      int entryIndex = -1;
-
-      std::set <tSchedule>::iterator pScheduleIter;
+      // Find and erase request from schedule (restoring the heap)
+      std::vector <tSchedule>::iterator pScheduleIter;
       pScheduleIter = mRequestSchedule.begin();
       
       while (pScheduleIter != mRequestSchedule.end())
       {
-         entryIndex++;
-
-         tSchedule entry = *pScheduleIter;
-         if (entry.second == reqID)
+         if (pScheduleIter->second == reqID)
          {
-            bFound = true;
             mRequestSchedule.erase( pScheduleIter );
+            std::make_heap( mRequestSchedule.begin(),
+                            mRequestSchedule.end(),
+                            std::greater <tSchedule>() );
             break;
          }
-         else
-         {
-            pScheduleIter++;
-         }
+
+         pScheduleIter++;
       }
 
       // Note: schedule will be updated when mutex is unlocked/signaled
    }
+   else if (mOutstandingRequests.find( reqID ) != mOutstandingRequests.end())
+   {
+      // Cancel the response timer
+      pReqIter = mOutstandingRequests.find( reqID );
+      sProtocolReqRsp * pReqRsp = pReqIter->second;
+      mOutstandingRequests.erase( pReqIter );
+
+      // Schedule will be updated when mutex is unlocked
+
+      // Failure to receive response, notify client
+      const cProtocolNotification * pNotifier = 0;
+      if (pReqRsp != 0)
+      {
+         pNotifier = pReqRsp->mRequest.GetNotifier();
+      }
+
+      if (pNotifier != 0)
+      {
+         pNotifier->Notify( ePROTOCOL_EVT_RSP_ERR, 
+                            (DWORD)reqID, 
+                            ECANCELED );
+      }
+
+      // Now delete the request
+      delete pReqRsp;
+
+      // Success!
+      bRC = true;
+   }
    else if (mpActiveRequest != 0 && mpActiveRequest->mID == reqID)
    {
       const sProtocolRequest & req = mpActiveRequest->mRequest;
       const cProtocolNotification * pNotifier = req.GetNotifier();
 
-      // Cancel the response timer (when active)
-      if (mpActiveRequest->mbWaitingForResponse == true)
+      // This is the active request, cancel the underlying transmit
+      // Note: Because ProcessRequest and RemoveRequest are both muxed
+      //    with ScheduleMutex, it is impossible to for the write
+      //    to actually be in progress when this code is reached.
+      if (mpConnection != 0)
       {
-         // Schedule will be updated when mutex is unlocked
-
-         // Failure to receive response, notify client
-         if (pNotifier != 0)
-         {
-            pNotifier->Notify( ePROTOCOL_EVT_RSP_ERR, 
-                               (DWORD)reqID, 
-                               ECANCELED );
-         }
+         mpConnection->CancelTx();
       }
-      else
-      {
-         // This is the active request, cancel the underlying transmit
-         // Note: Because ProcessRequest and RemoveRequest are both muxed
-         //    with ScheduleMutex, it is impossible to for the write
-         //    to actually be in progress when this code is reached.
-         if (mpConnection != 0)
-         {
-            mpConnection->CancelTx();
-         }
 
-         // Failure to send request, notify client
-         if (pNotifier != 0)
-         {
-            pNotifier->Notify( ePROTOCOL_EVT_REQ_ERR, 
-                               (DWORD)reqID, 
-                               ECANCELED );
-         }
+      // Failure to send request, notify client
+      if (pNotifier != 0)
+      {
+         pNotifier->Notify( ePROTOCOL_EVT_REQ_ERR, 
+                            (DWORD)reqID, 
+                            ECANCELED );
       }
 
       // Now delete the request
@@ -716,8 +641,13 @@ bool cProtocolServer::ScheduleRequest(
    // Create the schedule entry
    tSchedule newEntry( schTimer, reqID );
 
-   // Fit this request into the schedule (ordered by scheduled time)
-   mRequestSchedule.insert( newEntry );
+   // Fit this request into the schedule (a min-heap ordered by scheduled
+   // time, then by request ID so that requests due at the same time are
+   // sent in the order they were added)
+   mRequestSchedule.push_back( newEntry );
+   std::push_heap( mRequestSchedule.begin(),
+                   mRequestSchedule.end(),
+                   std::greater <tSchedule>() );
 
    // Note: timer will be updated when mScheduleMutex is unlocked
    
@@ -726,10 +656,14 @@ bool cProtocolServer::ScheduleRequest(
 
 /*===========================================================================
 METHOD:
-   RescheduleActiveRequest (Internal Method)
+   RescheduleRequest (Internal Method)
 
 DESCRIPTION:
-   Reschedule (or cleanup) the active request
+   Reschedule (or cleanup) a request that is either being transmitted or
+   waiting for a response
+
+PARAMETERS:
+   pReqRsp     [ I ] - Request to reschedule
 
 SEQUENCING:
    Calling process must have lock on mScheduleMutex
@@ -737,35 +671,60 @@ SEQUENCING:
 RETURN VALUE:
    None
 ===========================================================================*/
-void cProtocolServer::RescheduleActiveRequest()
+void cProtocolServer::RescheduleRequest( sProtocolReqRsp * pReqRsp )
 {
+   // No longer waiting for a response
+   std::map <ULONG, sProtocolReqRsp *>::iterator pOutIter;
+   pOutIter = mOutstandingRequests.find( pReqRsp->mID );
+   if (pOutIter != mOutstandingRequests.end() && pOutIter->second == pReqRsp)
+   {
+      mOutstandingRequests.erase( pOutIter );
+   }
+
    // Are there more attempts to be made?
-   if (mpActiveRequest->mAttempts < mpActiveRequest->mRequest.GetRequests())
+   if (pReqRsp->mAttempts < pReqRsp->mRequest.GetRequests())
    {
       // Yes, first reset the request 
-      mpActiveRequest->Reset();
+      pReqRsp->Reset();
 
       // Now add it back to the request map
-      mRequestMap[mpActiveRequest->mID] = mpActiveRequest;
+      mRequestMap[pReqRsp->mID] = pReqRsp;
 
-      TRACE( "RescheduleActiveRequest(): req %lu rescheduled\n", mpActiveRequest->mID );                       
+      TRACE( "RescheduleRequest(): req %lu rescheduled\n", pReqRsp->mID );                       
       
       // Lastly reschedule the request
-      ScheduleRequest( mpActiveRequest->mID, 
-                       mpActiveRequest->mRequest.GetFrequency() );
+      ScheduleRequest( pReqRsp->mID, 
+                       pReqRsp->mRequest.GetFrequency() );
 
    }
    else
    {
-      TRACE( "RescheduleActiveRequest(): req %lu removed\n", mpActiveRequest->mID );
+      TRACE( "RescheduleRequest(): req %lu removed\n", pReqRsp->mID );
 
       // No, we are through with this request
-      delete mpActiveRequest;
+      delete pReqRsp;
    }
+}
+
+/*===========================================================================
+METHOD:
+   RescheduleActiveRequest (Internal Method)
+
+DESCRIPTION:
+   Reschedule (or cleanup) the active request
+
+SEQUENCING:
+   Calling process must have lock on mScheduleMutex
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cProtocolServer::RescheduleActiveRequest()
+{
+   RescheduleRequest( mpActiveRequest );
 
    // There is no longer an active request
    mpActiveRequest = 0;
-  
 }
 
 /*===========================================================================
@@ -778,6 +737,9 @@ DESCRIPTION:
    request object in the request map, sending out the request, and setting
    up the response timer (if a response is required)
 
+   Up to mPipelineWindow requests may be waiting for a response at once,
+   responses are then matched to their request by DecodeRxData()
+
 SEQUENCING:
    Calling process must have lock on mScheduleMutex
 
@@ -785,28 +747,28 @@ RETURN VALUE:
 ===========================================================================*/
 void cProtocolServer::ProcessRequest()
 {
-   // Is there already an active request?
-   if (mpActiveRequest != 0 || mpConnection == 0)
+   // Is there already an active request, or is the window full?
+   if (mpActiveRequest != 0 
+   ||  mpConnection == 0
+   ||  mOutstandingRequests.size() >= mPipelineWindow)
    {
       return;
    }
    
-   // Grab request ID from the schedule
-   std::set <tSchedule>::iterator pScheduleIter;
-   pScheduleIter = mRequestSchedule.begin();
-
-   // Did we find the request?
-   if (pScheduleIter == mRequestSchedule.end())
+   // Is there a request in the schedule?
+   if (mRequestSchedule.size() == 0)
    {
       // No
       return;
    }
 
-   // Yes, grab the request ID
-   ULONG reqID = pScheduleIter->second;
+   // Yes, move the head of the schedule to the back and remove it
+   std::pop_heap( mRequestSchedule.begin(),
+                  mRequestSchedule.end(),
+                  std::greater <tSchedule>() );
 
-   // Remove from schedule
-   mRequestSchedule.erase( pScheduleIter );
+   ULONG reqID = mRequestSchedule.back().second;
+   mRequestSchedule.pop_back();
 
    // Look up the internal request object
    std::map <ULONG, sProtocolReqRsp *>::iterator pReqIter;
@@ -878,76 +840,156 @@ void cProtocolServer::ProcessRequest()
 
 /*===========================================================================
 METHOD:
-   CheckSystemTime (Internal Method)
+   RunSchedule (Internal Method)
 
 DESCRIPTION:
-   Check that system time hasn't moved backwards.  Since we use the system
-   time for scheduling requests we need to periodically check that the
-   user (or system itself) hasn't reset system time backwards, if it has
-   then we reschedule everything to the current system time.  This disrupts
-   the schedule but avoids stranding requests
+   Process the schedule once: expire the timers of the requests waiting
+   for a response and start the scheduled requests that are due, as long
+   as the pipelining window allows it
 
-   Updates mLastTime
+PARAMETERS:
+   toTime      [ O ] - Absolute time the schedule next needs processing
 
 SEQUENCING:
-   Calling process must have lock on mScheduleMutex
+   This method is sequenced according to the schedule mutex, which is
+   only tried (EBUSY is returned if someone else holds it)
 
 RETURN VALUE:
-   bool: System time moved backwards?
+   int - 0 on success, EBUSY if the schedule mutex is busy, or the error
+         that prevents the schedule from being processed
 ===========================================================================*/
-bool cProtocolServer::CheckSystemTime()
+int cProtocolServer::RunSchedule( timespec & toTime )
 {
-   // Assume that time is still marching forward
-   bool bAdjust = false;   
+   // Get Schedule Mutex (non-blocking)
+   int nRet = pthread_mutex_trylock( &mScheduleMutex );
+   if (nRet == EBUSY)
+   {
+      // We'll wait for the signal again
+      toTime = TimeIn( DEFAULT_WAIT );
+      return nRet;
+   }
+   else if (nRet != 0)
+   {
+      // Error condition
+      TRACE( "RunSchedule() mScheduleMutex error %d, %s\n",
+             nRet,
+             strerror( nRet ) );
+      return nRet;
+   }
+
+   // Default next wait period
+   toTime = TimeIn( DEFAULT_WAIT );
 
    timespec curTime = TimeIn( 0 );
 
-   if (curTime < mLastTime)
+   if (mpActiveRequest != 0)
    {
-      // Looks like the system clock has been adjusted to an earlier
-      // value, go through the current schedule and adjust each timer
-      // to reflect the adjustment.  This isn't an exact approach but
-      // it prevents requests from being stranded which is our goal
+      // This should never happen, transmission is synchronous
 
-      // Note: set iterators are constant.  This means we need to
-      //  create a set with the new data, we can't modify this one
-      
-      std::set < tSchedule, std::less <tSchedule> > tempSchedule;
-      
-      std::set <tSchedule>::iterator pScheduleIter;
-      pScheduleIter = mRequestSchedule.begin();
+      TRACE( "RunSchedule() Sequencing error: "
+             "Active request %lu is still being transmitted ???\n",
+             mpActiveRequest->mID );
 
-      while (pScheduleIter != mRequestSchedule.end())
-      {
-         tSchedule entry = *pScheduleIter;
-         entry.first.tv_sec = curTime.tv_sec;
-         entry.first.tv_nsec = curTime.tv_nsec;
-         tempSchedule.insert( entry );
+      pthread_mutex_unlock( &mScheduleMutex );
+      return EINVAL;
+   }
 
-         pScheduleIter++;
+   // Waiting on responses, these take priority over the next
+   //    scheduled event
+   std::map <ULONG, sProtocolReqRsp *>::iterator pOutIter;
+   pOutIter = mOutstandingRequests.begin();
+
+   while (pOutIter != mOutstandingRequests.end())
+   {
+      sProtocolReqRsp * pReqRsp = pOutIter->second;
+
+      // Note: RxTimeout() removes the entry, so advance first
+      pOutIter++;
+
+      // Has timeout expired?
+      if (pReqRsp->mTimeout <= curTime)
+      {
+         // Response timeout
+         RxTimeout( pReqRsp );
       }
-      
-      mRequestSchedule = tempSchedule;
-      
-      // Update mActiveRequestTimeout
-      if ( (mpActiveRequest != 0)
-      && (mpActiveRequest->mbWaitingForResponse == true) )
+      else
       {
-         // Restart active request's timeout
-         ULONG mTimeout = mpActiveRequest->mRequest.GetTimeout();
-         mActiveRequestTimeout = TimeIn( mTimeout );
-      }         
+         // Response timer is not yet due to expire
+         // Default timeout again, or this response's timeout?
+         if (pReqRsp->mTimeout <= toTime)
+         {
+            toTime = pReqRsp->mTimeout;
+         }
+      }
+   }
 
-      TRACE( "Time has moved backwards, schedule updated\n" );
+   // Ready to start the next scheduled items if due, as long as the
+   //    pipelining window allows it
+   ULONG started = 0;
+   while (started < mPipelineWindow
+      &&  mOutstandingRequests.size() < mPipelineWindow
+      &&  mRequestSchedule.size() > 0)
+   {
+      timespec scheduledItem = GetNextRequestTime();
+      
+      // Is item due to be scheduled?
+      if (scheduledItem <= curTime)
+      {
+         // Process scheduled item
+         ProcessRequest();
+         started++;
+      }
+      else
+      {
+         // Scheduled item is not yet due to be processed
+         // Default timeout again, or this item's start time?
+         if (scheduledItem <= toTime)
+         {
+            toTime = scheduledItem;
+         }
 
-      // Indicate the change
-      bAdjust = true;
+         break;
+      }
+   }
+   
+   // Unlock schedule mutex        
+   nRet = pthread_mutex_unlock( &mScheduleMutex );
+   if (nRet != 0)
+   {
+      TRACE( "RunSchedule() Unable to unlock schedule mutex."
+             " Error %d: %s\n",
+             nRet,
+             strerror( nRet ) );
    }
 
-   mLastTime.tv_sec = curTime.tv_sec;
-   mLastTime.tv_nsec = curTime.tv_nsec;
+   return nRet;
+}
 
-   return bAdjust;
+/*===========================================================================
+METHOD:
+   ScheduleDue (Internal Method)
+
+DESCRIPTION:
+   The shared I/O thread signals the schedule is to be processed
+
+PARAMETERS:
+   nextTime    [ O ] - Absolute time the schedule next needs processing
+
+SEQUENCING:
+   Called from the shared I/O thread
+
+RETURN VALUE:
+   bool - Should the schedule still be processed by the I/O thread?
+===========================================================================*/
+bool cProtocolServer::ScheduleDue( timespec & nextTime )
+{
+   if (mbExiting == true)
+   {
+      return false;
+   }
+
+   int nRet = RunSchedule( nextTime );
+   return (nRet == 0 || nRet == EBUSY);
 }
 
 /*===========================================================================
@@ -1007,31 +1049,55 @@ void cProtocolServer::RxComplete(
    // Decode data
    bool bAbortTx = false;
    ULONG rspIdx = INVALID_LOG_INDEX;
-   bool bRsp = DecodeRxData( bytesReceived, rspIdx, bAbortTx );
+   ULONG rspReqID = INVALID_REQUEST_ID;
+   bool bRsp = DecodeRxData( bytesReceived, rspIdx, rspReqID, bAbortTx );
+
+   // Find the request waiting for this data
+   sProtocolReqRsp * pReqRsp = 0;
+
+   std::map <ULONG, sProtocolReqRsp *>::iterator pOutIter;
+   pOutIter = mOutstandingRequests.find( rspReqID );
+   if (pOutIter != mOutstandingRequests.end())
+   {
+      pReqRsp = pOutIter->second;
+   }
 
-   // Is there an active request that needs to be aborted
-   if (mpActiveRequest != 0 && bAbortTx == true)
+   // Is there a request that needs to be aborted
+   if (pReqRsp != 0 && bAbortTx == true)
    {
+      const sProtocolRequest & req = pReqRsp->mRequest;
+      const cProtocolNotification * pNotifier = req.GetNotifier();
+
       // Yes, terminate the transmission and handle the error
       mpConnection->CancelTx();
-      TxError();
+
+      // Failure to send request, notify client
+      if (pNotifier != 0)
+      {
+         pNotifier->Notify( ePROTOCOL_EVT_REQ_ERR, 
+                            (DWORD)pReqRsp->mID, 
+                            (DWORD)0 );
+      }
+
+      // Reschedule request as needed
+      RescheduleRequest( pReqRsp );
    }
-   // Is there an active request and a valid response?
-   else if (mpActiveRequest != 0 && bRsp == true)
+   // Is there a request and a valid response?
+   else if (pReqRsp != 0 && bRsp == true)
    {
-      const sProtocolRequest & req = mpActiveRequest->mRequest;
+      const sProtocolRequest & req = pReqRsp->mRequest;
       const cProtocolNotification * pNotifier = req.GetNotifier();
 
       // Notify client that response was received
       if (pNotifier != 0)
       {
          pNotifier->Notify( ePROTOCOL_EVT_RSP_RECV, 
-                            (DWORD)mpActiveRequest->mID, 
+                            (DWORD)pReqRsp->mID, 
                             (DWORD)rspIdx );
       }
 
       // Reschedule request as needed
-      RescheduleActiveRequest();
+      RescheduleRequest( pReqRsp );
    }
    
    // Setup the next read
@@ -1056,7 +1122,10 @@ METHOD:
    RxTimeout (Internal Method)
 
 DESCRIPTION:
-   Handle the response timer expiring
+   Handle the response timer of a request in flight expiring
+
+PARAMETERS:
+   pReqRsp     [ I ] - Request waiting for a response
 
 SEQUENCING:
    Calling process must have lock on mScheduleMutex
@@ -1064,30 +1133,31 @@ SEQUENCING:
 RETURN VALUE:
    None
 ===========================================================================*/
-void cProtocolServer::RxTimeout()
+void cProtocolServer::RxTimeout( sProtocolReqRsp * pReqRsp )
 {
-   // No active request?
-   if (mpActiveRequest == 0)
+   // No request?
+   if (pReqRsp == 0)
    {
-      TRACE( "RxTimeout() with no active request\n" );
+      TRACE( "RxTimeout() with no request\n" );
       ASSERT( 0 );
+      return;
    }
    
-   TRACE( "RxTimeout() for req %lu\n", mpActiveRequest->mID );
+   TRACE( "RxTimeout() for req %lu\n", pReqRsp->mID );
 
-   const sProtocolRequest & req = mpActiveRequest->mRequest;
+   const sProtocolRequest & req = pReqRsp->mRequest;
    const cProtocolNotification * pNotifier = req.GetNotifier();
 
    // Failure to receive response, notify client
    if (pNotifier != 0)
    {
       pNotifier->Notify( ePROTOCOL_EVT_RSP_ERR, 
-                         (DWORD)mpActiveRequest->mID, 
+                         (DWORD)pReqRsp->mID, 
                          (DWORD)0 );
    }
 
    // Reschedule request as needed
-   RescheduleActiveRequest();
+   RescheduleRequest( pReqRsp );
 }
 
 /*===========================================================================
@@ -1212,9 +1282,13 @@ void cProtocolServer::TxComplete()
    // Wait for a response?
    if (mpActiveRequest->mRequest.IsTXOnly() == false)
    {
-      // We now await the response
+      // We now await the response, meanwhile other requests may be
+      // transmitted as long as the pipelining window allows it
       mpActiveRequest->mbWaitingForResponse = true;
-      mActiveRequestTimeout = TimeIn( mpActiveRequest->mRequest.GetTimeout() );
+      mpActiveRequest->mTimeout = TimeIn( mpActiveRequest->mRequest.GetTimeout() );
+
+      mOutstandingRequests[reqID] = mpActiveRequest;
+      mpActiveRequest = 0;
    }
    else
    {
@@ -1284,7 +1358,12 @@ bool cProtocolServer::Initialize()
    // Get mScheduleMutex
    if (GetScheduleMutex() == true)
    {
-      if (mScheduleThreadID == 0)
+      if (mpMultiplexer != 0)
+      {
+         // The shared I/O thread processes the schedule
+         bRC = mpMultiplexer->AddSchedule( this );
+      }
+      else if (mScheduleThreadID == 0)
       {
          // Yes, start thread
          int nRet = pthread_create( &mScheduleThreadID,
@@ -1391,6 +1470,15 @@ bool cProtocolServer::Exit()
          return false;
       }   
    }
+   else if (mpMultiplexer != 0)
+   {
+      // Set exit event
+      mbExiting = true;
+
+      // Once removed the shared I/O thread no longer touches the schedule
+      mpMultiplexer->RemoveSchedule( this );
+      bRC = true;
+   }
    else
    {
       // No ScheduleThread
@@ -1414,6 +1502,22 @@ bool cProtocolServer::Exit()
 
    mRequestMap.clear();
 
+   // ... including those waiting for a response
+   pReqIter = mOutstandingRequests.begin();
+
+   while (pReqIter != mOutstandingRequests.end())
+   {
+      sProtocolReqRsp * pReqRsp = pReqIter->second;
+      if (pReqRsp != 0)
+      {
+         delete pReqRsp;
+      }
+
+      pReqIter++;
+   }
+
+   mOutstandingRequests.clear();
+
    // Free log
    mLog.Clear();
 
@@ -1451,6 +1555,9 @@ bool cProtocolServer::Connect( LPCSTR pPort )
    // Set callback
    mRxCallback.SetServer( this );
 
+   // Reads are served by the same thread as the schedule, if shared
+   mpConnection->SetMultiplexer( mpMultiplexer );
+
    // Override to initialize port with protocol specific options
    bRC = mpConnection->Connect( pPort );
    if (bRC == true)
@@ -1616,6 +1723,73 @@ ULONG cProtocolServer::AddRequest( const sProtocolRequest & req )
    return reqID;
 }
 
+/*===========================================================================
+METHOD:
+   SetMultiplexer (Public Method)
+
+DESCRIPTION:
+   Have a shared I/O thread serve both the schedule and the receive
+   operations of this server, instead of dedicated schedule and Rx threads
+
+PARAMETERS:
+   pMultiplexer   [ I ] - Shared I/O thread (0 for dedicated threads)
+
+SEQUENCING:
+   Must be called before Initialize() and Connect()
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cProtocolServer::SetMultiplexer( cIOMultiplexer * pMultiplexer )
+{
+   if (mScheduleThreadID != 0 || IsConnected() == true)
+   {
+      return false;
+   }
+
+   mpMultiplexer = pMultiplexer;
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   SetPipelineWindow (Public Method)
+
+DESCRIPTION:
+   Set the maximum number of requests waiting for a response at once, by
+   default only one request is handled at a time (stop-and-wait)
+
+PARAMETERS:
+   window   [ I ] - Maximum number of requests in flight (at least 1)
+
+SEQUENCING:
+   This method is sequenced according to the schedule mutex, i.e. any
+   other thread that needs to modify the schedule will block until 
+   this method completes
+
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cProtocolServer::SetPipelineWindow( ULONG window )
+{
+   if (window == 0)
+   {
+      return false;
+   }
+
+   // Get Schedule Mutex
+   if (GetScheduleMutex() == false)
+   {
+      TRACE( "cProtocolServer::SetPipelineWindow(), unable to get mScheduleMutex\n" );
+      return false;
+   }
+
+   mPipelineWindow = window;
+
+   // Unlock schedule mutex, the schedule thread may now start more requests
+   return ReleaseScheduleMutex();
+}
+
 /*===========================================================================
 METHOD:
    RemoveRequest (Public Method)
@@ -1717,6 +1891,10 @@ METHOD:
 DESCRIPTION:
    Release lock on the schedule mutex
 
+   NOTE: The schedule thread is only signalled once the lock is released,
+   otherwise RunSchedule() may find it still held and wait DEFAULT_WAIT
+   for another signal
+
 SEQUENCING:
    Calling process must have lock
 
@@ -1728,14 +1906,6 @@ RETURN VALUE:
 ===========================================================================*/
 bool cProtocolServer::ReleaseScheduleMutex( bool bSignalThread )
 {
-   if (bSignalThread == true)
-   {
-      if (mThreadScheduleEvent.Set( 1 ) != 0)
-      {
-         return false;
-      }
-   }
-   
    int nRet = pthread_mutex_unlock( &mScheduleMutex );
    if (nRet != 0)
    {
@@ -1745,5 +1915,18 @@ bool cProtocolServer::ReleaseScheduleMutex( bool bSignalThread )
       return false;
    }
 
+   if (bSignalThread == true)
+   {
+      if (mpMultiplexer != 0)
+      {
+         // Nothing to signal until Initialize() adds the schedule
+         mpMultiplexer->SignalSchedule( this );
+      }
+      else if (mThreadScheduleEvent.Set( 1 ) != 0)
+      {
+         return false;
+      }
+   }
+
    return true;
 }
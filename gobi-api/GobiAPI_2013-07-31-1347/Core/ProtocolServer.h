@@ -50,7 +50,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "Event.h"
 
 #include <map>
-#include <set>
+#include <vector>
 
 //---------------------------------------------------------------------------
 // Forward Declarations
@@ -125,7 +125,7 @@ class cProtocolServerRxCallback
 /*=========================================================================*/
 // Class cProtocolServer
 /*=========================================================================*/
-class cProtocolServer
+class cProtocolServer : public cIOMultiplexerClient
 {
    public:
       // Constructor
@@ -165,6 +165,18 @@ class cProtocolServer
          return mLog;
       };
 
+      // Set the maximum number of requests in flight
+      bool SetPipelineWindow( ULONG window );
+
+      // (Inline) Return the maximum number of requests in flight
+      ULONG GetPipelineWindow()
+      {
+         return mPipelineWindow;
+      };
+
+      // Serve schedule and receive operations from a shared I/O thread
+      bool SetMultiplexer( cIOMultiplexer * pMultiplexer );
+
    protected:
       // Internal protocol server request/response structure, used to track
       // info related to sending out a request
@@ -209,6 +221,10 @@ class cProtocolServer
 
             /* Are we currently waiting for a response? */
             bool mbWaitingForResponse;
+
+            /* Absolute timeout for the response
+               based on when write was completed */
+            timespec mTimeout;
       };
 
       // Handle the remove request
@@ -222,14 +238,8 @@ class cProtocolServer
       // (Inline) Get next request's time from mRequestSchedule
       timespec GetNextRequestTime()
       {
-         timespec outTime;
-      
-         std::set <tSchedule>::iterator pScheduleIter;
-         pScheduleIter = mRequestSchedule.begin();
-         tSchedule entry = *pScheduleIter;
-
-         outTime = entry.first;
-         return outTime;
+         // The head of the heap is the earliest scheduled request
+         return mRequestSchedule.front().first;
       }
    
       // (Inline) Validate a request that is about to be scheduled
@@ -238,14 +248,20 @@ class cProtocolServer
          return req.IsValid();
       };
 
+      // Reschedule (or cleanup) a request
+      void RescheduleRequest( sProtocolReqRsp * pReqRsp );
+
       // Reschedule (or cleanup) the active request
       void RescheduleActiveRequest();
 
       // Process a single outgoing protocol request
       void ProcessRequest();
 
-      // Check that system time hasn't moved backwards
-      bool CheckSystemTime();
+      // Process the schedule once, returning when it is next due
+      int RunSchedule( timespec & toTime );
+
+      // The shared I/O thread signals the schedule is to be processed
+      bool ScheduleDue( timespec & nextTime );
 
       // Perform protocol specific communications port initialization
       virtual bool InitializeComm() = 0;
@@ -262,6 +278,7 @@ class cProtocolServer
       virtual bool DecodeRxData( 
          ULONG                      bytesReceived,
          ULONG &                    rspIdx,
+         ULONG &                    rspReqID,
          bool &                     bAbortTx ) = 0;
 
       // Handle completion of receive data operation
@@ -269,8 +286,8 @@ class cProtocolServer
          DWORD                      status,
          DWORD                      bytesReceived );
 
-      // Handle the response timer expiring
-      void RxTimeout();
+      // Handle the response timer of a request in flight expiring
+      void RxTimeout( sProtocolReqRsp * pReqRsp );
       
       // Handle completion of transmit data operation
       virtual void TxComplete();
@@ -281,6 +298,9 @@ class cProtocolServer
       /* Underlying communications object */
       cConnection * mpConnection;
 
+      /* Shared I/O thread (0 when using dedicated threads) */
+      cIOMultiplexer * mpMultiplexer;
+
       /* Underlying connection type */
       enum eConnectionType
       {
@@ -313,12 +333,10 @@ class cProtocolServer
       /* Client/server thread control object */
       sSharedBuffer * mpServerControl;
 
-      /* Protocol request schedule (scheduled time/request ID) */
+      /* Protocol request schedule (scheduled time/request ID), a binary
+         min-heap maintained with std::push_heap()/std::pop_heap() */
       typedef std::pair <timespec, ULONG> tSchedule;
-      std::set < tSchedule, std::less <tSchedule> > mRequestSchedule;
-
-      /* Last system time value (used to check for time changes) */
-      timespec mLastTime;
+      std::vector <tSchedule> mRequestSchedule;
 
       /* Protocol request map (request ID mapped to internal req/rsp struct) */
       std::map <ULONG, sProtocolReqRsp *> mRequestMap;
@@ -326,12 +344,15 @@ class cProtocolServer
       /* Last assigned request ID */
       ULONG mLastRequestID;
 
-      /* Current request being processed */
+      /* Current request being transmitted */
       sProtocolReqRsp * mpActiveRequest;
-      
-      /* Absolute timeout for mpActiveRequest
-         based on when write was completed */
-      timespec mActiveRequestTimeout;
+
+      /* Requests transmitted and waiting for a response (request ID
+         mapped to internal req/rsp struct) */
+      std::map <ULONG, sProtocolReqRsp *> mOutstandingRequests;
+
+      /* Maximum number of requests waiting for a response at once */
+      ULONG mPipelineWindow;
 
       /* Data buffer for incoming data */
       BYTE * mpRxBuffer;
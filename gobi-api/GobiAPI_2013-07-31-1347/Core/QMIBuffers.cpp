@@ -68,7 +68,8 @@ RETURN VALUE:
    None
 ===========================================================================*/
 sQMIServiceBuffer::sQMIServiceBuffer( sSharedBuffer * pBuffer )
-   :  sProtocolBuffer( pBuffer )
+   :  sProtocolBuffer( pBuffer ),
+      mpContents( 0 )
 {
    sQMIServiceBuffer::Validate();
 }
@@ -111,17 +112,9 @@ bool sQMIServiceBuffer::GetResult(
       return false;
    }
 
-   std::map <ULONG, const sQMIRawContentHeader *>::const_iterator pIter;
-   pIter = mContents.find( QMI_TLV_ID_RESULT );
-   if (pIter == mContents.end())
-   {
-      return false;
-   }
-
-   const sQMIRawContentHeader * pContent = pIter->second;
+   const sQMIRawContentHeader * pContent = GetContent( QMI_TLV_ID_RESULT );
    if (pContent == 0)
    {
-      ASSERT( 0 );
       return false;
    }
 
@@ -138,6 +131,103 @@ bool sQMIServiceBuffer::GetResult(
    return true;
 }
 
+/*===========================================================================
+METHOD:
+   GetContent (Public Method)
+
+DESCRIPTION:
+   Return the content structure with the given type ID (should the type
+   ID be repeated, the last one wins)
+  
+PARAMETERS:
+   typeID      [ I ] - The content type ID
+
+RETURN VALUE:
+   const sQMIRawContentHeader * - The content (0 if not present)
+===========================================================================*/
+const sQMIRawContentHeader * sQMIServiceBuffer::GetContent( 
+   ULONG                      typeID ) const
+{
+   if (IsValid() == false)
+   {
+      return 0;
+   }
+
+   // Indexed?
+   if (mpContents != 0 && mpContents->mbComplete == true)
+   {
+      for (ULONG i = mpContents->mCount; i > 0; i--)
+      {
+         if ((ULONG)mpContents->mTypes[i - 1] == typeID)
+         {
+            const BYTE * pContent = GetBuffer() + mpContents->mOffsets[i - 1];
+            return (const sQMIRawContentHeader *)pContent;
+         }
+      }
+
+      return 0;
+   }
+
+   // No, walk the contents (which we know to be well formed)
+   const sQMIRawContentHeader * pFound = 0;
+
+   ULONG contentSz = 0;
+   const BYTE * pRaw = (const BYTE *)GetRawContents( contentSz );
+
+   ULONG contentProcessed = 0;
+   while (pRaw != 0 && contentProcessed < contentSz)
+   {
+      const sQMIRawContentHeader * pContent = 0;
+      pContent = (const sQMIRawContentHeader *)&pRaw[contentProcessed];
+      if ((ULONG)pContent->mTypeID == typeID)
+      {
+         pFound = pContent;
+      }
+
+      contentProcessed += (ULONG)sizeof( sQMIRawContentHeader ) 
+                       +  (ULONG)pContent->mLength;
+   }
+
+   return pFound;
+}
+
+/*===========================================================================
+METHOD:
+   GetContents (Public Method)
+
+DESCRIPTION:
+   Return content structures (indexed by type ID), prefer GetContent()
+   which does not need to build a map
+  
+RETURN VALUE:
+   std::map <ULONG, const sQMIRawContentHeader *>
+===========================================================================*/
+std::map <ULONG, const sQMIRawContentHeader *> 
+sQMIServiceBuffer::GetContents() const
+{
+   std::map <ULONG, const sQMIRawContentHeader *> contents;
+   if (IsValid() == false)
+   {
+      return contents;
+   }
+
+   ULONG contentSz = 0;
+   const BYTE * pRaw = (const BYTE *)GetRawContents( contentSz );
+
+   ULONG contentProcessed = 0;
+   while (pRaw != 0 && contentProcessed < contentSz)
+   {
+      const sQMIRawContentHeader * pContent = 0;
+      pContent = (const sQMIRawContentHeader *)&pRaw[contentProcessed];
+      contents[(ULONG)pContent->mTypeID] = pContent;
+
+      contentProcessed += (ULONG)sizeof( sQMIRawContentHeader ) 
+                       +  (ULONG)pContent->mLength;
+   }
+
+   return contents;
+}
+
 /*===========================================================================
 METHOD:
    BuildBuffer (Static Public Method)
@@ -180,8 +270,8 @@ sSharedBuffer * sQMIServiceBuffer::BuildBuffer(
       payloadLen = 0;
    }
 
-   // Allocate buffer
-   PBYTE pBuffer = new BYTE[payloadLen + totalHdrSz];
+   // Allocate buffer (from the shared buffer pool)
+   PBYTE pBuffer = sSharedBuffer::AllocateData( payloadLen + totalHdrSz );
    if (pBuffer == 0)
    {
       return 0;
@@ -229,7 +319,7 @@ sSharedBuffer * sQMIServiceBuffer::BuildBuffer(
 
    // Build and return the shared buffer
    eProtocolType pt = MapQMIServiceToProtocol( serviceType, bTX );
-   sSharedBuffer * pBuf = new sSharedBuffer( sz, pBuffer, pt );
+   sSharedBuffer * pBuf = new sSharedBuffer( sz, pBuffer, pt, true );
    return pBuf;
 }
 
@@ -239,11 +329,64 @@ METHOD:
 
 DESCRIPTION:
    Is this open unframed request/response packet valid?
+
+   NOTE: The result (and the content index) is cached by the shared
+   buffer, so the packet is only parsed once no matter how many service
+   buffers are built from it
   
 RETURN VALUE:
    bool
 ===========================================================================*/ 
 bool sQMIServiceBuffer::Validate()
+{
+   mpContents = 0;
+
+   if (mpData == 0)
+   {
+      mbValid = false;
+      return mbValid;
+   }
+
+   // Already validated?
+   bool bValid = false;
+   const sSharedBufferIndex * pIndex = 0;
+   if (mpData->GetValidation( bValid, pIndex ) == true)
+   {
+      mpContents = pIndex;
+      mbValid = bValid;
+      return mbValid;
+   }
+
+   // No, are we the ones to cache the result?
+   sSharedBufferIndex * pNewIndex = mpData->ClaimValidation();
+
+   bValid = Parse( pNewIndex );
+   if (pNewIndex != 0)
+   {
+      mpData->SetValidation( bValid );
+      if (bValid == true)
+      {
+         mpContents = pNewIndex;
+      }
+   }
+
+   return bValid;
+}
+
+/*===========================================================================
+METHOD:
+   Parse (Internal Method)
+
+DESCRIPTION:
+   Parse the packet, checking whether it is valid
+
+PARAMETERS:
+   pIndex      [ O ] - Content index to fill in (may be 0)
+  
+RETURN VALUE:
+   bool
+===========================================================================*/ 
+bool sQMIServiceBuffer::Parse( sSharedBufferIndex * pIndex )
 {
    // Assume failure
    bool bRC = false;
@@ -334,16 +477,27 @@ bool sQMIServiceBuffer::Validate()
       ULONG tlvLen = szContentHdr + pContent->mLength; 
       
       contentProcessed += tlvLen;
-      if (contentProcessed <= contentSz)
+      if (contentProcessed > contentSz)
+      {
+         mbValid = bRC;
+         return bRC;
+      }
+
+      // Index the content
+      if (pIndex == 0)
       {
-         mContents[(ULONG)pContent->mTypeID] = pContent;
+         // Not indexing
+      }
+      else if (pIndex->mCount < MAX_SHARED_BUFFER_RECORDS)
+      {
+         pIndex->mTypes[pIndex->mCount] = (WORD)pContent->mTypeID;
+         pIndex->mOffsets[pIndex->mCount] = (WORD)(pBuffer - GetBuffer());
+         pIndex->mCount++;
       }
       else
       {
-         mContents.clear();
-
-         mbValid = bRC;
-         return bRC;
+         // Too many to index, lookups will walk the contents instead
+         pIndex->mbComplete = false;
       }
 
       pBuffer += tlvLen;
@@ -336,11 +336,11 @@ struct sQMIServiceBuffer : public sProtocolBuffer
          return pRaw;
       };
 
-      // (Inline) Return content structures
-      std::map <ULONG, const sQMIRawContentHeader *> GetContents() const
-      {
-         return mContents;
-      };
+      // Return the content structure with the given type ID
+      const sQMIRawContentHeader * GetContent( ULONG typeID ) const;
+
+      // Return content structures
+      std::map <ULONG, const sQMIRawContentHeader *> GetContents() const;
 
       // Return contents of mandatory result content
       bool GetResult( 
@@ -379,8 +379,12 @@ struct sQMIServiceBuffer : public sProtocolBuffer
       // Is this QMI request/response/indication packet valid?
       virtual bool Validate();
 
-      /* Content TLV structures (indexed by type ID) */
-      std::map <ULONG, const sQMIRawContentHeader *> mContents;
+      // Parse the packet, filling in the content index (if given)
+      bool Parse( sSharedBufferIndex * pIndex );
+
+      /* Content TLV index (kept by the shared buffer, 0 if the packet
+         was validated by a different buffer at the same time) */
+      const sSharedBufferIndex * mpContents;
 
    private:
       // Prevent 'upcopying'
@@ -277,7 +277,8 @@ DESCRIPTION:
 
 PARAMETERS:
    bytesReceived  [ I ] - Number of bytes to decoded
-   rspIdx         [ O ] - Log index of last valid response (not used)
+   rspIdx         [ O ] - Log index of last valid response
+   rspReqID       [ O ] - ID of the request the response belongs to
    bAbortTx       [ O ] - Response aborts current transmission? (not used)
 
 SEQUENCING:
@@ -289,12 +290,14 @@ RETURN VALUE:
 bool cQMIProtocolServer::DecodeRxData( 
    ULONG                      bytesReceived,
    ULONG &                    rspIdx,
+   ULONG &                    rspReqID,
    bool &                     bAbortTx )
 {
    // Assume failure
    bool bRC = false;
 
    rspIdx = INVALID_LOG_INDEX;
+   rspReqID = INVALID_REQUEST_ID;
    bAbortTx = false;
 
    // Something to decode from?
@@ -318,7 +321,7 @@ bool cQMIProtocolServer::DecodeRxData(
       if (tmpBuf.IsValid() == true)
       {
          rspIdx = mLog.AddBuffer( tmpBuf );
-         if (IsResponse( tmpBuf ) == true)
+         if (IsResponse( tmpBuf, rspReqID ) == true)
          {
             bRC = true;
          }
@@ -372,10 +375,12 @@ METHOD:
    IsResponse (Internal Method)
 
 DESCRIPTION:
-   Is the passed in data a response to the current request?
+   Is the passed in data a response to one of the requests waiting for a
+   response?  Requests are matched by transaction ID
 
 PARAMETERS:
    rsp         [ I ] - Candidate response
+   rspReqID    [ O ] - ID of the request the response belongs to
 
 SEQUENCING:
    None (must be called from protocol server thread)
@@ -383,52 +388,73 @@ SEQUENCING:
 RETURN VALUE:
    bool
 ===========================================================================*/
-bool cQMIProtocolServer::IsResponse( const sProtocolBuffer & rsp )
+bool cQMIProtocolServer::IsResponse( 
+   const sProtocolBuffer &    rsp,
+   ULONG &                    rspReqID )
 {
    // Assume not
    bool bRC = false;
-   if ( (mpActiveRequest == 0) 
-   ||   (mpActiveRequest->mRequest.IsValid() == false)
-   ||   (mpActiveRequest->mbWaitingForResponse == false)
-   ||   (rsp.IsValid() == false) )
+   rspReqID = INVALID_REQUEST_ID;
+
+   if (mOutstandingRequests.size() == 0 || rsp.IsValid() == false)
    {
       return bRC;
    }
 
-   sQMIServiceBuffer qmiReq( mpActiveRequest->mRequest.GetSharedBuffer() );
    sQMIServiceBuffer qmiRsp( rsp.GetSharedBuffer() );
-
-   if (qmiReq.IsValid() == false || qmiRsp.IsValid() == false)
+   if (qmiRsp.IsValid() == false || qmiRsp.IsResponse() == false)
    {
       return bRC;
    }
 
-   if (qmiRsp.IsResponse() == false)
+   WORD rspID = qmiRsp.GetTransactionID();
+   if (rspID == (WORD)INVALID_QMI_TRANSACTION_ID)
    {
       return bRC;
    }
 
-   WORD reqID = qmiReq.GetTransactionID();
-   WORD rspID = qmiRsp.GetTransactionID();
+   std::map <ULONG, sProtocolReqRsp *>::iterator pOutIter;
+   pOutIter = mOutstandingRequests.begin();
 
-   if ( (reqID == (WORD)INVALID_QMI_TRANSACTION_ID)
-   ||   (rspID == (WORD)INVALID_QMI_TRANSACTION_ID)
-   ||   (reqID != rspID) )
+   while (pOutIter != mOutstandingRequests.end())
    {
-      return bRC;
-   }
+      sProtocolReqRsp * pReqRsp = pOutIter->second;
+      pOutIter++;
 
-   // Sadly there are documentated cases of firmware returning responses
-   // with a matching transaction ID but a mismatching message ID.  There 
-   // is no reason for this to be considered valid behavior as of yet
-   ULONG reqMsgID = qmiReq.GetMessageID();
-   ULONG rspMsgID = qmiRsp.GetMessageID();
+      if ( (pReqRsp == 0)
+      ||   (pReqRsp->mRequest.IsValid() == false)
+      ||   (pReqRsp->mbWaitingForResponse == false) )
+      {
+         continue;
+      }
 
-   if (reqMsgID != rspMsgID)
-   {
-      return bRC;
+      sQMIServiceBuffer qmiReq( pReqRsp->mRequest.GetSharedBuffer() );
+      if (qmiReq.IsValid() == false)
+      {
+         continue;
+      }
+
+      WORD reqID = qmiReq.GetTransactionID();
+      if (reqID == (WORD)INVALID_QMI_TRANSACTION_ID || reqID != rspID)
+      {
+         continue;
+      }
+
+      // Sadly there are documentated cases of firmware returning responses
+      // with a matching transaction ID but a mismatching message ID.  There 
+      // is no reason for this to be considered valid behavior as of yet
+      ULONG reqMsgID = qmiReq.GetMessageID();
+      ULONG rspMsgID = qmiRsp.GetMessageID();
+
+      if (reqMsgID != rspMsgID)
+      {
+         return bRC;
+      }
+
+      rspReqID = pReqRsp->mID;
+      bRC = true;
+      break;
    }
 
-   bRC = true;
    return bRC; 
 }
@@ -89,6 +89,7 @@ class cQMIProtocolServer : public cProtocolServer
       virtual bool DecodeRxData( 
          ULONG                      bytesReceived,
          ULONG &                    rspIdx,
+         ULONG &                    rspReqID,
          bool &                     bAbortTx );
 
       // Encode data for transmission
@@ -96,8 +97,10 @@ class cQMIProtocolServer : public cProtocolServer
          sSharedBuffer *            pBuffer,
          bool &                     bEncoded );
 
-      // Is the passed in data a response to the current request?
-      virtual bool IsResponse( const sProtocolBuffer & rsp );
+      // Is the passed in data a response to a request in flight?
+      virtual bool IsResponse( 
+         const sProtocolBuffer &    rsp,
+         ULONG &                    rspReqID );
 
       // (Inline) Is the passed in data a response that aborts the 
       // current request?
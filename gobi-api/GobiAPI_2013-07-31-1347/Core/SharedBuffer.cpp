@@ -44,92 +44,221 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "StdAfx.h"
 #include "SharedBuffer.h"
 
+#include <vector>
+
 //---------------------------------------------------------------------------
 // Definitions
 //---------------------------------------------------------------------------
 
-// Synchronization object
-struct sSharedBufferSync
+// Data buffer size classes (the last one fits any valid shared buffer)
+const ULONG POOL_CLASS_SIZES[] = 
+{
+   128,
+   512,
+   2048,
+   MAX_SHARED_BUFFER_SIZE
+};
+
+// Maximum number of free data buffers kept per size class
+const ULONG POOL_CLASS_DEPTHS[] = 
+{
+   64,
+   64,
+   32,
+   8
+};
+
+// Validation states
+const BYTE VALIDATION_NONE    = 0;
+const BYTE VALIDATION_BUSY    = 1;
+const BYTE VALIDATION_VALID   = 2;
+const BYTE VALIDATION_INVALID = 3;
+
+// Number of data buffer size classes
+const ULONG POOL_CLASSES = 
+   sizeof( POOL_CLASS_SIZES ) / sizeof( POOL_CLASS_SIZES[0] );
+
+// Maximum number of free shared buffer objects kept
+const ULONG POOL_OBJECT_DEPTH = 128;
+
+// Pool of free blocks of a single size
+struct sSharedBufferFreeList
 {
    public:
       // Constructor
-      sSharedBufferSync()
-         :  mbInitialized( false )
+      sSharedBufferFreeList()
+         :  mBlockSize( 0 ),
+            mDepth( 0 )
+      {
+         pthread_mutex_init( &mSyncSection, NULL );
+      };
+
+      // Set the size of the blocks and the number of them to keep
+      void Configure(
+         size_t                     blockSize,
+         ULONG                      depth )
       {
-         int nRet = pthread_mutex_init( &mSyncSection, NULL );
-         if (nRet != 0)
+         mBlockSize = blockSize;
+         mDepth = depth;
+
+         // Never grow (allocate) when returning a block
+         mBlocks.reserve( depth );
+      };
+
+      // Get a free block, 0 if there are none
+      void * Pop()
+      {
+         void * pBlock = 0;
+
+         pthread_mutex_lock( &mSyncSection );
+         if (mBlocks.size() > 0)
          {
-            TRACE( "SharedBuffer: Unable to init sync mutex."
-                   " Error %d: %s\n",
-                   nRet,
-                   strerror( nRet ) );
-            return;
-         }         
-
-         mbInitialized = true;
+            pBlock = mBlocks.back();
+            mBlocks.pop_back();
+         }
+         pthread_mutex_unlock( &mSyncSection );
+
+         return pBlock;
       };
 
-      // Destructor
-      ~sSharedBufferSync()
+      // Keep a free block, false if there is no room for it
+      bool Push( void * pBlock )
       {
-         mbInitialized = false;
-         int nRet = pthread_mutex_destroy( &mSyncSection );
-         if (nRet != 0)
+         bool bKept = false;
+
+         pthread_mutex_lock( &mSyncSection );
+         if (mBlocks.size() < mDepth)
          {
-            TRACE( "SharedBuffer: Unable to destroy sync mutex."
-                   " Error %d: %s\n",
-                   nRet,
-                   strerror( nRet ) );
-         }         
+            mBlocks.push_back( pBlock );
+            bKept = true;
+         }
+         pthread_mutex_unlock( &mSyncSection );
 
+         return bKept;
       };
 
-      // Lock sync object
-      void Lock()
+      /* Size of the blocks */
+      size_t mBlockSize;
+
+   protected:
+      /* Maximum number of free blocks */
+      ULONG mDepth;
+
+      /* Free blocks */
+      std::vector <void *> mBlocks;
+
+      /* Free blocks critical section */
+      pthread_mutex_t mSyncSection;
+};
+
+// Size classed pool of shared buffer objects and data buffers
+struct sSharedBufferPool
+{
+   public:
+      // Constructor
+      sSharedBufferPool()
+         :  mHits( 0 ),
+            mMisses( 0 )
       {
-         if (mbInitialized == true)
+         for (ULONG c = 0; c < POOL_CLASSES; c++)
          {
-            int nRet = pthread_mutex_lock( &mSyncSection );
-            if (nRet != 0)
-            {
-               TRACE( "SharedBuffer: Unable to lock sync mutex."
-                      " Error %d: %s\n",
-                      nRet,
-                      strerror( nRet ) );
-               return;
-            }            
+            mData[c].Configure( POOL_CLASS_SIZES[c], POOL_CLASS_DEPTHS[c] );
+         }
 
+         mObjects.Configure( sizeof( sSharedBuffer ), POOL_OBJECT_DEPTH );
+      };
+
+      // Return the size class for the given size
+      static ULONG GetClass( ULONG sz )
+      {
+         ULONG c = 0;
+         while (c < POOL_CLASSES - 1 && sz > POOL_CLASS_SIZES[c])
+         {
+            c++;
          }
+
+         return c;
       };
 
-      // Unlock sync object
-      void Unlock()
+      // Get a block from the given free list (or the heap)
+      void * Allocate( sSharedBufferFreeList & freeList )
       {
-         if (mbInitialized == true)
+         void * pBlock = freeList.Pop();
+         if (pBlock != 0)
          {
-            int nRet = pthread_mutex_unlock( &mSyncSection );
-            if (nRet != 0)
-            {
-               TRACE( "SharedBuffer: Unable to unlock sync mutex."
-                      " Error %d: %s\n",
-                      nRet,
-                      strerror( nRet ) );
-               return;
-            }            
+            __atomic_add_fetch( &mHits, 1, __ATOMIC_RELAXED );
+            return pBlock;
+         }
+
+         __atomic_add_fetch( &mMisses, 1, __ATOMIC_RELAXED );
+         return ::operator new( freeList.mBlockSize );
+      };
 
+      // Return a block to the given free list (or the heap)
+      void Free( 
+         sSharedBufferFreeList &    freeList,
+         void *                     pBlock )
+      {
+         if (freeList.Push( pBlock ) == false)
+         {
+            ::operator delete( pBlock );
          }
       };
-   
-   protected:
-      /* DIAG buffer critical section */
-      pthread_mutex_t mSyncSection;
 
-      /* Has this object been initialized? */
-      bool mbInitialized;
+      /* Data buffers, per size class */
+      sSharedBufferFreeList mData[POOL_CLASSES];
+
+      /* Shared buffer objects */
+      sSharedBufferFreeList mObjects;
+
+      /* Allocations served from (and missing) the free lists */
+      ULONG mHits;
+      ULONG mMisses;
 };
 
-// Global (across all shared buffers) reference count guard
-sSharedBufferSync gRefCount;
+/*=========================================================================*/
+// Free Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   GetSharedBufferPool (Free Method)
+
+DESCRIPTION:
+   Return the buffer pool, which is created on first use and never
+   destroyed (buffers may still be released during static destruction)
+
+RETURN VALUE:
+   sSharedBufferPool &
+===========================================================================*/
+static sSharedBufferPool & GetSharedBufferPool()
+{
+   static sSharedBufferPool * pPool = new sSharedBufferPool();
+   return *pPool;
+}
+
+/*===========================================================================
+METHOD:
+   FreeSharedBufferData (Free Method)
+
+DESCRIPTION:
+   Return a data buffer allocated by sSharedBuffer::AllocateData() to
+   the buffer pool
+
+PARAMETERS:
+   pData       [ I ] - Data buffer
+   dataLen     [ I ] - Size the data buffer was allocated with
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+static void FreeSharedBufferData( 
+   PBYTE                      pData,
+   ULONG                      dataLen )
+{
+   sSharedBufferPool & pool = GetSharedBufferPool();
+   pool.Free( pool.mData[sSharedBufferPool::GetClass( dataLen )], pData );
+}
 
 /*=========================================================================*/
 // sSharedBuffer Methods
@@ -157,7 +286,9 @@ sSharedBuffer::sSharedBuffer(
    :  mpData( 0 ),
       mSize( 0 ),
       mType( dataType ),
-      mRefCount( 0 )
+      mRefCount( 0 ),
+      mbPooled( true ),
+      mValidation( VALIDATION_NONE )
 {
    // Length not too small/not too big?
    if (IsValidSize( dataLen ) == true)
@@ -166,7 +297,7 @@ sSharedBuffer::sSharedBuffer(
       if (pDataToCopy != 0)
       {
          // Yes, try to allocate memory
-         mpData = new BYTE[dataLen];
+         mpData = AllocateData( dataLen );
          if (mpData != 0)
          {
             // Now copy into our allocation
@@ -196,6 +327,8 @@ PARAMETERS:
                        be non-zero)
 
    dataType    [ I ] - Type of data (not used internal to class)
+   bPooled     [ I ] - Was the data buffer allocated by AllocateData()?
+                       (otherwise it must have been allocated by new [])
 
    NOTE: The order is intentionally reversed from the previous constructor
    to avoid any cases of mistaken identity (copy versus assume ownership)
@@ -206,11 +339,14 @@ RETURN VALUE:
 sSharedBuffer::sSharedBuffer( 
    ULONG                      dataLen,
    PBYTE                      pDataToOwn,
-   ULONG                      dataType )
+   ULONG                      dataType,
+   bool                       bPooled )
    :  mpData( 0 ),
       mSize( 0 ),
       mType( dataType ),
-      mRefCount( 0 )
+      mRefCount( 0 ),
+      mbPooled( bPooled ),
+      mValidation( VALIDATION_NONE )
 {
    // Data actually exists?
    if (pDataToOwn != 0)
@@ -226,7 +362,15 @@ sSharedBuffer::sSharedBuffer(
       {
          // This data buffer is not acceptable to us, but we have assumed
          // ownership of the memory which we will now free
-         delete [] pDataToOwn;
+         if (bPooled == true)
+         {
+            // The size class is unknown, bypass the pool
+            ::operator delete( pDataToOwn );
+         }
+         else
+         {
+            delete [] pDataToOwn;
+         }
       }
    }
 }
@@ -250,7 +394,14 @@ sSharedBuffer::~sSharedBuffer()
    {
       // Yes, zero first byte for caution and then delete it
       mpData[0] = 0;
-      delete [] mpData;
+      if (mbPooled == true)
+      {
+         FreeSharedBufferData( mpData, mSize );
+      }
+      else
+      {
+         delete [] mpData;
+      }
 
       // Even more caution, zero out pointer
       mpData = 0;
@@ -331,15 +482,16 @@ METHOD:
 
 DESCRIPTION:
    Increment reference count
+
+   NOTE: A new reference is always taken from an existing one, so no
+   ordering is needed here
   
 RETURN VALUE:
    None
 ===========================================================================*/
 void sSharedBuffer::AddRef()
 {
-   gRefCount.Lock();
-   mRefCount++;     
-   gRefCount.Unlock();
+   __atomic_add_fetch( &mRefCount, 1, __ATOMIC_RELAXED );
 }
 
 /*===========================================================================
@@ -348,27 +500,220 @@ METHOD:
 
 DESCRIPTION:
    Release reference, delete if reference count zero
+
+   NOTE: The decrement releases our accesses to the buffer, and the one
+   reaching zero acquires everybody else's before deleting it
   
 RETURN VALUE:
    None
 ===========================================================================*/
 void sSharedBuffer::Release()
 {
-   gRefCount.Lock();
+   ASSERT( GetRefCount() != 0 );
 
-   ASSERT( mRefCount != 0 );
+   // Decrement reference count ...
+   ULONG refCount = __atomic_sub_fetch( &mRefCount, 1, __ATOMIC_ACQ_REL );
 
-   // Decrement reference count
-   if (mRefCount > 0)
+   // ... and delete if reference count now 0
+   if (refCount == 0)
    {
-      mRefCount--;
+      delete this;
    }
+}
 
-   // ... and delete if reference count now 0
-   if (mRefCount == 0)
+/*===========================================================================
+METHOD:
+   GetValidation (Public Method)
+
+DESCRIPTION:
+   Get the cached result of validating the buffer
+
+PARAMETERS:
+   bValid      [ O ] - Was the buffer found to be valid?
+   pIndex      [ O ] - The record index (0 if not valid)
+  
+RETURN VALUE:
+   bool - false if the buffer has not been validated (yet)
+===========================================================================*/
+bool sSharedBuffer::GetValidation(
+   bool &                     bValid,
+   const sSharedBufferIndex *&   pIndex ) const
+{
+   // Acquire the index filled in before the result was cached
+   BYTE state = __atomic_load_n( &mValidation, __ATOMIC_ACQUIRE );
+   if (state == VALIDATION_VALID)
    {
-      delete this;
+      bValid = true;
+      pIndex = &mIndex;
+      return true;
+   }
+   else if (state == VALIDATION_INVALID)
+   {
+      bValid = false;
+      pIndex = 0;
+      return true;
+   }
+
+   return false;
+}
+
+/*===========================================================================
+METHOD:
+   ClaimValidation (Public Method)
+
+DESCRIPTION:
+   Claim the validation of the buffer, only the first protocol buffer to
+   validate the shared buffer gets to cache the result (others validate
+   it on their own in the meantime)
+  
+RETURN VALUE:
+   sSharedBufferIndex * - The (emptied) index to fill in, 0 if the claim
+                          failed
+===========================================================================*/
+sSharedBufferIndex * sSharedBuffer::ClaimValidation() const
+{
+   BYTE expected = VALIDATION_NONE;
+   bool bClaimed = __atomic_compare_exchange_n( &mValidation,
+                                                &expected,
+                                                VALIDATION_BUSY,
+                                                false,
+                                                __ATOMIC_ACQUIRE,
+                                                __ATOMIC_RELAXED );
+   if (bClaimed == false)
+   {
+      return 0;
+   }
+
+   mIndex.mCount = 0;
+   mIndex.mbComplete = true;
+   return &mIndex;
+}
+
+/*===========================================================================
+METHOD:
+   SetValidation (Public Method)
+
+DESCRIPTION:
+   Cache the result of a claimed validation
+
+PARAMETERS:
+   bValid      [ I ] - Was the buffer found to be valid?
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sSharedBuffer::SetValidation( bool bValid ) const
+{
+   ASSERT( mValidation == VALIDATION_BUSY );
+
+   // Release the index filled in by the claimer
+   BYTE state = (bValid == true ? VALIDATION_VALID : VALIDATION_INVALID);
+   __atomic_store_n( &mValidation, state, __ATOMIC_RELEASE );
+}
+
+/*===========================================================================
+METHOD:
+   AllocateData (Static Public Method)
+
+DESCRIPTION:
+   Allocate a data buffer from the buffer pool, to be passed to the
+   ownership constructor (with bPooled set)
+
+PARAMETERS:
+   dataLen     [ I ] - The length of the buffer (should be > 1)
+  
+RETURN VALUE:
+   PBYTE - The data buffer (0 on error)
+===========================================================================*/
+PBYTE sSharedBuffer::AllocateData( ULONG dataLen )
+{
+   if (IsValidSize( dataLen ) == false)
+   {
+      return 0;
+   }
+
+   sSharedBufferPool & pool = GetSharedBufferPool();
+   ULONG c = sSharedBufferPool::GetClass( dataLen );
+   return (PBYTE)pool.Allocate( pool.mData[c] );
+}
+
+/*===========================================================================
+METHOD:
+   GetPoolCounters (Static Public Method)
+
+DESCRIPTION:
+   Get the buffer pool counters, allocations of both shared buffer objects
+   and data buffers count
+
+PARAMETERS:
+   hits        [ O ] - Allocations served from the pool
+   misses      [ O ] - Allocations that had to go to the heap
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sSharedBuffer::GetPoolCounters( 
+   ULONG &                    hits,
+   ULONG &                    misses )
+{
+   sSharedBufferPool & pool = GetSharedBufferPool();
+   hits = __atomic_load_n( &pool.mHits, __ATOMIC_RELAXED );
+   misses = __atomic_load_n( &pool.mMisses, __ATOMIC_RELAXED );
+}
+
+/*===========================================================================
+METHOD:
+   operator new (Static Public Method)
+
+DESCRIPTION:
+   Allocate a shared buffer object from the buffer pool
+
+PARAMETERS:
+   sz          [ I ] - Size of the object
+  
+RETURN VALUE:
+   void * - The object memory
+===========================================================================*/
+void * sSharedBuffer::operator new( size_t sz )
+{
+   sSharedBufferPool & pool = GetSharedBufferPool();
+   if (sz != pool.mObjects.mBlockSize)
+   {
+      return ::operator new( sz );
+   }
+
+   return pool.Allocate( pool.mObjects );
+}
+
+/*===========================================================================
+METHOD:
+   operator delete (Static Public Method)
+
+DESCRIPTION:
+   Return a shared buffer object to the buffer pool
+
+PARAMETERS:
+   pObj        [ I ] - The object memory
+   sz          [ I ] - Size of the object
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void sSharedBuffer::operator delete( 
+   void *                     pObj,
+   size_t                     sz )
+{
+   if (pObj == 0)
+   {
+      return;
+   }
+
+   sSharedBufferPool & pool = GetSharedBufferPool();
+   if (sz != pool.mObjects.mBlockSize)
+   {
+      ::operator delete( pObj );
+      return;
    }
 
-   gRefCount.Unlock();
+   pool.Free( pool.mObjects, pObj );
 }
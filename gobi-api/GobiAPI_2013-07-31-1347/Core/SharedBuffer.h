@@ -54,11 +54,36 @@ struct sProtocolBuffer;
 // Maximum size of a shared buffer
 const ULONG MAX_SHARED_BUFFER_SIZE = 1024 * 16 + 256;
 
+// Maximum number of records in a shared buffer index
+const ULONG MAX_SHARED_BUFFER_RECORDS = 32;
+
 //---------------------------------------------------------------------------
 // Pragmas (pack structs)
 //---------------------------------------------------------------------------
 #pragma pack( push, 1 )
 
+/*=========================================================================*/
+// Struct sSharedBufferIndex
+//
+//    Index of the records (i.e. TLVs) found when validating a shared
+//    buffer, so that the data is only parsed once
+/*=========================================================================*/
+struct sSharedBufferIndex
+{
+   public:
+      /* Number of records indexed */
+      WORD mCount;
+
+      /* Were all the records indexed? (false if there were too many) */
+      bool mbComplete;
+
+      /* Record type IDs, in the order found */
+      WORD mTypes[MAX_SHARED_BUFFER_RECORDS];
+
+      /* Record offsets into the buffer, in the order found */
+      WORD mOffsets[MAX_SHARED_BUFFER_RECORDS];
+};
+
 /*=========================================================================*/
 // Struct sSharedBuffer
 //
@@ -81,7 +106,8 @@ struct sSharedBuffer
       sSharedBuffer( 
          ULONG                      dataLen,
          PBYTE                      pDataToOwn,
-         ULONG                      dataType );
+         ULONG                      dataType,
+         bool                       bPooled = false );
 
       // Destructor
       virtual ~sSharedBuffer();
@@ -119,7 +145,7 @@ struct sSharedBuffer
       // (Inline) Get reference count
       ULONG GetRefCount() const
       {
-         return mRefCount;
+         return __atomic_load_n( &mRefCount, __ATOMIC_RELAXED );
       };
 
       // (Static Inline) Is the passed in size within the allowable range
@@ -129,6 +155,35 @@ struct sSharedBuffer
          return (sz > 0 && sz <= MAX_SHARED_BUFFER_SIZE);
       };      
 
+      // Get the cached validation result, false if not validated yet
+      bool GetValidation(
+         bool &                     bValid,
+         const sSharedBufferIndex *&   pIndex ) const;
+
+      // Claim the validation of the buffer, returning the index to fill
+      // in (0 if it is already validated or being validated)
+      sSharedBufferIndex * ClaimValidation() const;
+
+      // Cache the result of a claimed validation
+      void SetValidation( bool bValid ) const;
+
+      // (Static) Allocate a data buffer from the buffer pool, to be
+      // owned by a shared buffer
+      static PBYTE AllocateData( ULONG dataLen );
+
+      // (Static) Get the buffer pool hit/miss counters
+      static void GetPoolCounters( 
+         ULONG &                    hits,
+         ULONG &                    misses );
+
+      // (Static) Allocate a shared buffer object from the buffer pool
+      static void * operator new( size_t sz );
+
+      // (Static) Return a shared buffer object to the buffer pool
+      static void operator delete( 
+         void *                     pObj,
+         size_t                     sz );
+
    protected:
       // Add reference
       void AddRef();
@@ -145,9 +200,19 @@ struct sSharedBuffer
       /* Type of data */
       ULONG mType;
 
-      /* Reference count */
+      /* Reference count (atomically updated, all the members above are
+         pointer sized so it is naturally aligned despite the packing) */
       ULONG mRefCount;
 
+      /* Was the data allocated from the buffer pool? */
+      bool mbPooled;
+
+      /* Validation state (atomically updated) */
+      mutable BYTE mValidation;
+
+      /* Record index (set before a successful validation is cached) */
+      mutable sSharedBufferIndex mIndex;
+
    private:
       // Leave copy constructor and assignment operator unimplemented
       // to prevent unintentional and unauthorized copying of the object
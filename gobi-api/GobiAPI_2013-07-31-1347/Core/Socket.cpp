@@ -184,68 +184,10 @@ void * RxSocketThread( void * pData )
          FD_CLR( pSocket->mSocket, &inputSet );
          largestFD = pSocket->mCommandPipe[READING];
 
-         // Perform a recv for the header
-         sQMUXDHeader recvHdr;
-         status = recv( pSocket->mSocket,
-                        &recvHdr,
-                        sizeof( recvHdr ),
-                        0 );         
-         if (status != sizeof( recvHdr ))
+         // Perform the read
+         if (pSocket->Receive() == false)
          {
-            TRACE( "recv error, bad size %d\n", status );
             break;
-         }            
-
-         // Calculate and read the remaining data
-         if ((recvHdr.mTotalSize < 0)
-         ||  ((ULONG)recvHdr.mTotalSize < sizeof( recvHdr ))
-         ||  ((ULONG)recvHdr.mTotalSize > sizeof( recvHdr ) + pSocket->mBuffSz))
-         {
-            TRACE( "read too large for buffer\n" );
-            break;
-         }
-
-         status = recv( pSocket->mSocket,
-                        pSocket->mpBuffer,
-                        recvHdr.mTotalSize - sizeof( recvHdr ),
-                        0 );
-
-         // Is this one of our IOCTLS or a standard message?
-         if (recvHdr.mQMUXDMsgID == eQMUXD_MSG_WRITE_QMI_SDU)
-         {
-            cIOCallback * pCallback = pSocket->mpRxCallback;
-            pSocket->mpRxCallback = 0;
-
-            if (pCallback == (cIOCallback *)1)
-            {
-               // We wanted to read, but not to be notified
-            }   
-            else if (status >= 0)
-            {
-               pCallback->IOComplete( 0, status );
-            }
-            else
-            {
-               pCallback->IOComplete( status, 0 );
-            }
-         }
-         else
-         {
-            pSocket->mpRxCallback = 0;
-            // Notify SendCtl() that control message completed
-
-            if (recvHdr.mQMUXDMsgID == eQMUXD_MSG_ALLOC_QMI_CLIENT_ID)
-            {
-               DWORD clientID;
-               memcpy( &clientID, &pSocket->mpBuffer[0], 4 );
-
-               pSocket->mCtrlMsgComplete.Set( clientID );
-            }
-            else
-            {
-               // Just set the event
-               pSocket->mCtrlMsgComplete.Set( 0 );
-            }
          }
       }
    }
@@ -346,25 +288,31 @@ bool cSocket::Connect( LPCSTR pPort )
       Disconnect();
    }
 
-   // Initialize command pipe for read thread
-   int nRet = pipe( mCommandPipe );
-   if (nRet != 0)
-   {
-      TRACE( "cSocket:Connect() pipe creation failed %d\n", nRet );
-      return false;
-   }
+   int nRet = 0;
 
-   // Start the read thread
-   nRet = pthread_create( &mRxThreadID,
-                          0,
-                          RxSocketThread,
-                          this );
-   if (nRet != 0)
+   // Reads are served by the shared I/O thread when multiplexed
+   if (mpMultiplexer == 0)
    {
-      TRACE( "cSocket::Connect() pthread_create = %d\n",  nRet );
+      // Initialize command pipe for read thread
+      nRet = pipe( mCommandPipe );
+      if (nRet != 0)
+      {
+         TRACE( "cSocket:Connect() pipe creation failed %d\n", nRet );
+         return false;
+      }
 
-      Disconnect();
-      return false;
+      // Start the read thread
+      nRet = pthread_create( &mRxThreadID,
+                             0,
+                             RxSocketThread,
+                             this );
+      if (nRet != 0)
+      {
+         TRACE( "cSocket::Connect() pthread_create = %d\n",  nRet );
+
+         Disconnect();
+         return false;
+      }
    }
 
    // Create a socket
@@ -601,6 +549,11 @@ bool cSocket::Disconnect()
 
    if (mSocket != INVALID_HANDLE_VALUE)
    {
+      if (mpMultiplexer != 0)
+      {
+         mpMultiplexer->UnwatchRead( mSocket, this );
+      }
+
       close( mSocket );
       mSocket = INVALID_HANDLE_VALUE;
    }
@@ -653,6 +606,22 @@ RETURN VALUE:
 ===========================================================================*/
 bool cSocket::CancelRx()
 {
+   if (mpMultiplexer != 0)
+   {
+      if (mSocket == INVALID_HANDLE_VALUE || mpRxCallback == 0)
+      {
+         TRACE( "cannot cancel, no read active\n" );
+         mpRxCallback = 0;
+         return false;
+      }
+
+      // Once unwatched the callback can no longer be exercised
+      mpMultiplexer->UnwatchRead( mSocket, this );
+      mpRxCallback = 0;
+
+      return true;
+   }
+
    if (mSocket == INVALID_HANDLE_VALUE
    ||  mCommandPipe[WRITING] == INVALID_HANDLE_VALUE
    ||  mpRxCallback == 0
@@ -741,6 +710,12 @@ bool cSocket::RxData(
    mpBuffer = pBuf;
    mBuffSz = bufSz;
 
+   if (mpMultiplexer != 0)
+   {
+      // Have the shared I/O thread watch for the data
+      return mpMultiplexer->WatchRead( mSocket, this );
+   }
+
    // Notify the thread to start reading
    BYTE byte = START_READ_CMD;
    int nRC = write( mCommandPipe[WRITING], &byte, 1 );
@@ -753,6 +728,111 @@ bool cSocket::RxData(
    return true;
 }
 
+/*===========================================================================
+METHOD:
+   ReadReady (Public Method)
+
+DESCRIPTION:
+   Data is available to be read, perform the pending receive operation
+
+SEQUENCING:
+   Called from the shared I/O thread
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cSocket::ReadReady()
+{
+   if (Receive() == false)
+   {
+      // The stream can no longer be parsed, stop reading from it
+      TRACE( "cSocket::ReadReady() receive failed, reads stopped\n" );
+   }
+}
+
+/*===========================================================================
+METHOD:
+   Receive (Internal Method)
+
+DESCRIPTION:
+   Receive a single QMUXD message and exercise the receive callback
+   (or complete the pending control message)
+
+SEQUENCING:
+   Called from the Rx thread (or the shared I/O thread)
+
+RETURN VALUE:
+   bool - false if the socket can no longer be read from
+===========================================================================*/
+bool cSocket::Receive()
+{
+   // Perform a recv for the header
+   sQMUXDHeader recvHdr;
+   int status = recv( mSocket,
+                      &recvHdr,
+                      sizeof( recvHdr ),
+                      0 );
+   if (status != sizeof( recvHdr ))
+   {
+      TRACE( "recv error, bad size %d\n", status );
+      return false;
+   }            
+
+   // Calculate and read the remaining data
+   if ((recvHdr.mTotalSize < 0)
+   ||  ((ULONG)recvHdr.mTotalSize < sizeof( recvHdr ))
+   ||  ((ULONG)recvHdr.mTotalSize > sizeof( recvHdr ) + mBuffSz))
+   {
+      TRACE( "read too large for buffer\n" );
+      return false;
+   }
+
+   status = recv( mSocket,
+                  mpBuffer,
+                  recvHdr.mTotalSize - sizeof( recvHdr ),
+                  0 );
+
+   // Is this one of our IOCTLS or a standard message?
+   if (recvHdr.mQMUXDMsgID == eQMUXD_MSG_WRITE_QMI_SDU)
+   {
+      cIOCallback * pCallback = mpRxCallback;
+      mpRxCallback = 0;
+
+      if (pCallback == 0 || pCallback == (cIOCallback *)1)
+      {
+         // We wanted to read, but not to be notified
+      }   
+      else if (status >= 0)
+      {
+         pCallback->IOComplete( 0, status );
+      }
+      else
+      {
+         pCallback->IOComplete( status, 0 );
+      }
+   }
+   else
+   {
+      mpRxCallback = 0;
+      // Notify SendCtl() that control message completed
+
+      if (recvHdr.mQMUXDMsgID == eQMUXD_MSG_ALLOC_QMI_CLIENT_ID)
+      {
+         DWORD clientID;
+         memcpy( &clientID, &mpBuffer[0], 4 );
+
+         mCtrlMsgComplete.Set( clientID );
+      }
+      else
+      {
+         // Just set the event
+         mCtrlMsgComplete.Set( 0 );
+      }
+   }
+
+   return true;
+}
+
 /*===========================================================================
 METHOD:
    TxData (Public Method)
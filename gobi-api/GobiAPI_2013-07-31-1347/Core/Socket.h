@@ -110,6 +110,9 @@ class cSocket : public cConnection
          const BYTE *               pBuf, 
          ULONG                      bufSz );
 
+      // Data is available, perform the pending receive operation
+      void ReadReady();
+
       // (Inline) Return current channel ID
       int GetChannelID() const 
       {
@@ -123,6 +126,8 @@ class cSocket : public cConnection
       };
 
    protected:
+      // Receive a single QMUXD message
+      bool Receive();
 
       /* Handle to socket */
       int mSocket;
@@ -98,3 +98,69 @@ ULONG GetTLV(
    // TLV not found
    return eGOBI_ERR_INVALID_RSP;
 }
+
+/*=========================================================================*/
+// cTLVIndex Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   Scan (Protected Method)
+
+DESCRIPTION:
+   Index TLVs from where the last scan stopped until the given type ID
+   turns up, recording the first instance of every type ID passed
+
+   NOTE: the buffer must outlive the index
+
+PARAMETERS:
+   typeID            [ I ] - Type ID
+  
+RETURN VALUE:
+   ULONG - Return code
+===========================================================================*/
+ULONG cTLVIndex::Scan( BYTE typeID )
+{
+   if (mbScanDone == true)
+   {
+      return mScanRC;
+   }
+
+   const BYTE * pIn = mpIn;
+   ULONG inLen = mInLen;
+   ULONG offset = mScanOffset;
+   while (offset + sizeof( sQMIRawContentHeader ) <= inLen)
+   {
+      const sQMIRawContentHeader * pHeader = 0;
+      pHeader = (const sQMIRawContentHeader *)(pIn + offset);
+
+      // Is it big enough to contain this TLV?
+      ULONG next = offset + sizeof( sQMIRawContentHeader ) + pHeader->mLength;
+      if (next > inLen)
+      {
+         mScanRC = eGOBI_ERR_MALFORMED_RSP;
+         break;
+      }
+
+      // Only the first instance of each type ID is found by GetTLV()
+      BYTE id = pHeader->mTypeID;
+      BYTE idMask = (BYTE)(1 << (id & 7));
+      if ((mPresent[id >> 3] & idMask) == 0)
+      {
+         mPresent[id >> 3] |= idMask;
+         mOffsets[id] = offset;
+         if (id == typeID)
+         {
+            mScanOffset = next;
+            return eGOBI_ERR_NONE;
+         }
+      }
+
+      offset = next;
+   }
+
+   // TLV not found (or malformed)
+   mScanOffset = offset;
+   mbScanDone = true;
+   return mScanRC;
+}
@@ -86,6 +86,85 @@ ULONG GetTLV(
    ULONG *        pOutLen,
    const BYTE **  ppOut );
 
+/*=========================================================================*/
+// Class cTLVIndex
+//
+//    Index of the TLVs in a response, filled in as the buffer is scanned
+//    so that no TLV header is walked twice (results match GetTLV())
+//
+//    NOTE: only pays off for parsers that look up more than one TLV, a
+//    single lookup is cheaper through GetTLV()
+/*=========================================================================*/
+class cTLVIndex
+{
+   public:
+      // (Inline) Constructor
+      cTLVIndex(
+         ULONG          inLen,
+         const BYTE *   pIn )
+         :  mpIn( pIn ),
+            mInLen( inLen ),
+            mScanOffset( 0 ),
+            mScanRC( eGOBI_ERR_INVALID_RSP ),
+            mbScanDone( false )
+      {
+         memset( &mPresent[0], 0, sizeof( mPresent ) );
+      };
+
+      // (Inline) Get a TLV
+      ULONG GetTLV(
+         BYTE           typeID,
+         ULONG *        pOutLen,
+         const BYTE **  ppOut )
+      {
+         if (mpIn == 0 || pOutLen == 0 || ppOut == 0)
+         {
+            return eGOBI_ERR_INVALID_ARG;
+         }
+
+         // Only scan for type IDs not indexed yet
+         if ((mPresent[typeID >> 3] & (1 << (typeID & 7))) == 0)
+         {
+            ULONG rc = Scan( typeID );
+            if (rc != eGOBI_ERR_NONE)
+            {
+               return rc;
+            }
+         }
+
+         const BYTE * pTLV = mpIn + mOffsets[typeID];
+         *pOutLen = ((const sQMIRawContentHeader *)pTLV)->mLength;
+         *ppOut = pTLV + sizeof( sQMIRawContentHeader );
+
+         return eGOBI_ERR_NONE;
+      };
+
+   protected:
+      // Index TLVs until the given type ID is found
+      ULONG Scan( BYTE typeID );
+
+      /* Input buffer */
+      const BYTE * mpIn;
+
+      /* Length of input buffer */
+      ULONG mInLen;
+
+      /* Offset of the first TLV not yet indexed */
+      ULONG mScanOffset;
+
+      /* Return code once the scan is over (TLV not found/malformed) */
+      ULONG mScanRC;
+
+      /* Has the whole buffer been scanned? */
+      bool mbScanDone;
+
+      /* Bitmap of the type IDs indexed so far */
+      BYTE mPresent[256 / 8];
+
+      /* Offset of the TLV header for each type ID indexed */
+      ULONG mOffsets[256];
+};
+
 // WDS
 
 ULONG ParseGetSessionState(
@@ -351,11 +351,14 @@ ULONG ParseGetFirmwareRevisions(
    *pBootString = 0;
    *pPRIString = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the AMSS version
    // sDMSGetDeviceRevisionResponse_Revision only contains this
    const CHAR * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -374,7 +377,7 @@ ULONG ParseGetFirmwareRevisions(
    // sDMSGetDeviceRevisionResponse_BootCodeRevision only contains this
    const CHAR * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -441,11 +444,14 @@ ULONG ParseGetVoiceNumber(
    *pVoiceNumber = 0;
    *pMIN = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the Voice number
    // sDMSGetDeviceVoiceNumberResponse_VoiceNumber only contains this
    const CHAR * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -464,7 +470,7 @@ ULONG ParseGetVoiceNumber(
    // sDMSGetDeviceVoiceNumberResponse_MobileIDNumber only contains this
    const CHAR * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       // Space to perform the copy?
@@ -584,11 +590,14 @@ ULONG ParseGetSerialNumbers(
    *pIMEIString = 0;
    *pMEIDString = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the ESN
    // sDMSGetDeviceSerialNumbersResponse_ESN only contains this
    const CHAR * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -607,7 +616,7 @@ ULONG ParseGetSerialNumbers(
    // sDMSGetDeviceSerialNumbersResponse_IMEI only contains this
    const CHAR * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -626,7 +635,7 @@ ULONG ParseGetSerialNumbers(
    // sDMSGetDeviceSerialNumbersResponse_MEID only contains this
    const CHAR * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1332,10 +1341,13 @@ ULONG ParseGetOfflineReason(
    *pReasonMask = 0;
    *pbPlatform = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the reason mask (optional)
    const sDMSGetOperatingModeResponse_OfflineReason * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sDMSGetOperatingModeResponse_OfflineReason ))
@@ -1350,7 +1362,7 @@ ULONG ParseGetOfflineReason(
    // Find the platform restriction (optional)
    const sDMSGetOperatingModeResponse_PlatformRestricted * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sDMSGetOperatingModeResponse_PlatformRestricted ))
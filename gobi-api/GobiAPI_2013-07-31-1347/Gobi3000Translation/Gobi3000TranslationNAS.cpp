@@ -289,10 +289,13 @@ ULONG ParseGetSignalStrengths(
    // Assume failure
    *pArraySizes = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the first signal strength value
    const sNASGetSignalStrengthResponse_SignalStrength * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -317,7 +320,7 @@ ULONG ParseGetSignalStrengths(
    // Handle list, if present
    const sNASGetSignalStrengthResponse_SignalStrengthList * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sNASGetSignalStrengthResponse_SignalStrengthList ))
@@ -925,10 +928,13 @@ ULONG ParseGetServingNetwork(
 
    // Parse the serving system (mandatory)
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sNASGetServingSystemResponse_ServingSystem * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -979,7 +985,7 @@ ULONG ParseGetServingNetwork(
    // Find the roaming indicator (optional)
    const sNASGetServingSystemResponse_RoamingIndicator * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sNASGetServingSystemResponse_RoamingIndicator ))
@@ -994,7 +1000,7 @@ ULONG ParseGetServingNetwork(
    // Find the PLMN (optional)
    const sNASGetServingSystemResponse_CurrentPLMN * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx12 < sizeof( sNASGetServingSystemResponse_CurrentPLMN ))
@@ -1168,10 +1174,13 @@ ULONG ParseGetHomeNetwork(
    *pSID = 0xffff;
    *pNID = 0xffff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the name (mandatory)
    const sNASGetHomeNetworkResponse_HomeNetwork * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1213,7 +1222,7 @@ ULONG ParseGetHomeNetwork(
    // Find the SID/NID (optional)
    const sNASGetHomeNetworkResponse_HomeIDs * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sNASGetHomeNetworkResponse_HomeIDs ))
@@ -1319,10 +1328,13 @@ ULONG ParseGetNetworkPreference(
       return eGOBI_ERR_INVALID_ARG;
    }
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the preference (mandatory)
    const sNASGetTechnologyPreferenceResponse_ActivePreference * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1346,7 +1358,7 @@ ULONG ParseGetNetworkPreference(
    // Find the persistant technology preference (optional)
    const sNASGetTechnologyPreferenceResponse_PersistentPreference * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sNASGetTechnologyPreferenceResponse_PersistentPreference ))
@@ -1659,10 +1671,13 @@ ULONG ParseGetCDMANetworkParameters(
    *pApplication = 0xffffffff;
    *pRoaming = 0xff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the SCI
    const sNASGetNetworkParametersResponse_SCI * pTLVx11;
    ULONG outLenx11;
-   ULONG rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   ULONG rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sNASGetNetworkParametersResponse_SCI ))
@@ -1676,7 +1691,7 @@ ULONG ParseGetCDMANetworkParameters(
    // Find the SCM
    const sNASGetNetworkParametersResponse_SCM * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx12 < sizeof( sNASGetNetworkParametersResponse_SCM ))
@@ -1690,7 +1705,7 @@ ULONG ParseGetCDMANetworkParameters(
    // Find the Registration
    const sNASGetNetworkParametersResponse_Registration * pTLVx13;
    ULONG outLenx13;
-   rc = GetTLV( inLen, pIn, 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
+   rc = tlvs.GetTLV( 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx13 < sizeof( sNASGetNetworkParametersResponse_Registration ))
@@ -1706,7 +1721,7 @@ ULONG ParseGetCDMANetworkParameters(
    // Rev. 0?
    const sNASGetNetworkParametersResponse_CDMA1xEVDORevision * pTLVx14;
    ULONG outLenx14;
-   rc = GetTLV( inLen, pIn, 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
+   rc = tlvs.GetTLV( 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx14 < sizeof( sNASGetNetworkParametersResponse_CDMA1xEVDORevision ))
@@ -1722,7 +1737,7 @@ ULONG ParseGetCDMANetworkParameters(
    // respective container parameters
    const sEVDOCustomSCPConfig * pTLVx15;
    ULONG outLenx15;
-   rc = GetTLV( inLen, pIn, 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
+   rc = tlvs.GetTLV( 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx15 < sizeof( sEVDOCustomSCPConfig ))
@@ -1739,7 +1754,7 @@ ULONG ParseGetCDMANetworkParameters(
    // Roaming?
    const sNASGetNetworkParametersResponse_Roaming * pTLVx16;
    ULONG outLenx16;
-   rc = GetTLV( inLen, pIn, 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
+   rc = tlvs.GetTLV( 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx16 < sizeof( sNASGetNetworkParametersResponse_Roaming ))
@@ -208,10 +208,13 @@ ULONG ParseGetPortAutomaticTracking(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find pbAuto
    const sPDSGetCOMPortAutoTrackingConfigResponse_Config * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -310,10 +313,13 @@ ULONG ParseGetServiceAutomaticTracking(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find pbAuto
    const sPDSGetServiceAutoTrackingStateResponse_State * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -426,10 +432,13 @@ ULONG ParseGetAGPSConfig(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find arguments
    const sPDSGetAGPSConfigResponse_ServerAddress * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -534,10 +543,13 @@ ULONG ParseGetXTRATimeState(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find pState
    const sPDSGetPositionMethodsStateResponse_XTRATime * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -636,10 +648,13 @@ ULONG ParseGetXTRADataState(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find pState
    const sPDSGetPositionMethodsStateResponse_XTRAData * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -686,10 +701,13 @@ ULONG ParseGetXTRAValidity(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find arguments
    const sPDSGetXTRAParametersResponse_Validity * pTLVx13;
    ULONG outLenx13;
-   ULONG rc = GetTLV( inLen, pIn, 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
+   ULONG rc = tlvs.GetTLV( 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -790,10 +808,13 @@ ULONG ParseGetXTRANetwork(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find pPreference
    const sPDSGetXTRAParametersResponse_Network * pTLVx12;
    ULONG outLenx12;
-   ULONG rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   ULONG rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -897,10 +918,13 @@ ULONG ParseGetXTRAAutomaticDownload(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find arguments
    const sPDSGetXTRAParametersResponse_Automatic * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -947,10 +971,13 @@ ULONG ParseGetPDSState(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find arguments
    const sPDSGetServiceStateResponse_State * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1116,10 +1143,13 @@ ULONG ParseGetPDSDefaults(
       return eGOBI_ERR_INVALID_ARG;
    }
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find arguments
    const sPDSGetDefaultsResponse_Defaults * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -65,10 +65,13 @@ ULONG ParseGetSMSWake(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the first TLV
    const sRMSGetSMSWakeResponse_State * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -83,7 +86,7 @@ ULONG ParseGetSMSWake(
    // Find the second TLV
    const sRMSGetSMSWakeRequest_Mask * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -65,10 +65,13 @@ ULONG ParseUIMUnblockControlKey(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMUnblockControlKeyResponse_Status * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -179,10 +182,13 @@ ULONG ParseUIMSetControlKeyProtection(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMSetControlKeyProtectionResponse_Status * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -306,10 +312,13 @@ ULONG ParseUIMGetControlKeyBlockingStatus(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the first arguments
    const sDMSUIMGetControlKeyStatusResponse_Status * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -330,7 +339,7 @@ ULONG ParseUIMGetControlKeyBlockingStatus(
    {
       const sDMSUIMGetControlKeyStatusResponse_Blocking * pTLVx10;
       ULONG tlvLenx10;
-      rc = GetTLV( inLen, pIn, 0x10, &tlvLenx10, (const BYTE **)&pTLVx10 );
+      rc = tlvs.GetTLV( 0x10, &tlvLenx10, (const BYTE **)&pTLVx10 );
       if (rc != eGOBI_ERR_NONE)
       {
          return rc;
@@ -441,10 +450,13 @@ ULONG ParseUIMGetControlKeyStatus(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the arguments
    const sDMSUIMGetControlKeyStatusResponse_Status * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -520,10 +532,13 @@ ULONG ParseUIMGetICCID(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMGetICCIDResponse_ICCID * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -591,11 +606,14 @@ ULONG ParseUIMGetPINStatus(
    
    ULONG tlvLen;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // The typeID is either 0x11 or 0x12
    if (id == 1)
    {
       const sDMSUIMGetPINStatusResponse_PIN1Status * pTLV11;
-      ULONG rc = GetTLV( inLen, pIn, 0x11, &tlvLen, (const BYTE **)&pTLV11 );
+      ULONG rc = tlvs.GetTLV( 0x11, &tlvLen, (const BYTE **)&pTLV11 );
 
       if (rc != eGOBI_ERR_NONE)
       {
@@ -615,7 +633,7 @@ ULONG ParseUIMGetPINStatus(
    else if (id == 2)
    {
       const sDMSUIMGetPINStatusResponse_PIN2Status * pTLV12;
-      ULONG rc = GetTLV( inLen, pIn, 0x12, &tlvLen, (const BYTE **)&pTLV12 );
+      ULONG rc = tlvs.GetTLV( 0x12, &tlvLen, (const BYTE **)&pTLV12 );
 
       if (rc != eGOBI_ERR_NONE)
       {
@@ -673,10 +691,13 @@ ULONG ParseUIMChangePIN(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMChangePINResponse_RetryInfo * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -814,10 +835,13 @@ ULONG ParseUIMUnblockPIN(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMUnblockPINResponse_RetryInfo * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -951,10 +975,13 @@ ULONG ParseUIMVerifyPIN(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMVerifyPINResponse_RetryInfo * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1074,10 +1101,13 @@ ULONG ParseUIMSetPINProtection(
       return eGOBI_ERR_INVALID_ARG;
    }
    
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TLV
    const sDMSUIMSetPINProtectionResponse_RetryInfo * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -205,10 +205,13 @@ ULONG ParseGetEnhancedAutoconnect(
    *pSetting = 0xffffffff;
    *pRoamSetting = 0xffffffff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the first TLV
    const sWDSGetAutoconnectSettingResponse_Autoconnect * pTLVx01;
    ULONG outLenx01;
-   ULONG rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   ULONG rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -225,7 +228,7 @@ ULONG ParseGetEnhancedAutoconnect(
    // Find the second TLV (optional)
    const sWDSGetAutoconnectSettingResponse_Roam * pTLVx10;
    ULONG outLenx10;
-   rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       // Is the TLV large enough?
@@ -792,10 +795,13 @@ ULONG ParseGetDefaultProfile(
    pAPNName[0] = 0;
    pUsername[0] = 0;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the name
    const sWDSGetDefaultSettingsResponse_ProfileName * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (nameSize < outLenx10 + 1)
@@ -812,7 +818,7 @@ ULONG ParseGetDefaultProfile(
    // Find the PDP type
    const sWDSGetDefaultSettingsResponse_PDPType * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sWDSGetDefaultSettingsResponse_PDPType ))
@@ -826,7 +832,7 @@ ULONG ParseGetDefaultProfile(
    // Find the APN name
    const sWDSGetDefaultSettingsResponse_APNName * pTLVx14;
    ULONG outLenx14;
-   rc = GetTLV( inLen, pIn, 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
+   rc = tlvs.GetTLV( 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (apnSize < outLenx14 + 1)
@@ -843,7 +849,7 @@ ULONG ParseGetDefaultProfile(
    // Find the Primary DNS
    const sWDSGetDefaultSettingsResponse_PrimaryDNS * pTLVx15;
    ULONG outLenx15;
-   rc = GetTLV( inLen, pIn, 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
+   rc = tlvs.GetTLV( 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx15 < sizeof( sWDSGetDefaultSettingsResponse_PrimaryDNS ))
@@ -862,7 +868,7 @@ ULONG ParseGetDefaultProfile(
    // Find the Secondary DNS
    const sWDSGetDefaultSettingsResponse_SecondaryDNS * pTLVx16;
    ULONG outLenx16;
-   rc = GetTLV( inLen, pIn, 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
+   rc = tlvs.GetTLV( 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx16 < sizeof( sWDSGetDefaultSettingsResponse_SecondaryDNS ))
@@ -881,7 +887,7 @@ ULONG ParseGetDefaultProfile(
    // Find the Username
    const sWDSGetDefaultSettingsResponse_APNName * pTLVx1B;
    ULONG outLenx1B;
-   rc = GetTLV( inLen, pIn, 0x1B, &outLenx1B, (const BYTE **)&pTLVx1B );
+   rc = tlvs.GetTLV( 0x1B, &outLenx1B, (const BYTE **)&pTLVx1B );
    if (rc == eGOBI_ERR_NONE)
    {
       if (userSize < outLenx1B + 1)
@@ -898,7 +904,7 @@ ULONG ParseGetDefaultProfile(
    // Find the Authentication
    const sWDSGetDefaultSettingsResponse_Authentication * pTLVx1D;
    ULONG outLenx1D;
-   rc = GetTLV( inLen, pIn, 0x1D, &outLenx1D, (const BYTE **)&pTLVx1D );
+   rc = tlvs.GetTLV( 0x1D, &outLenx1D, (const BYTE **)&pTLVx1D );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx1D < sizeof( sWDSGetDefaultSettingsResponse_Authentication ))
@@ -915,7 +921,7 @@ ULONG ParseGetDefaultProfile(
    // Find the IP Address
    const sWDSGetDefaultSettingsResponse_IPAddress * pTLVx1E;
    ULONG outLenx1E;
-   rc = GetTLV( inLen, pIn, 0x1E, &outLenx1E, (const BYTE **)&pTLVx1E );
+   rc = tlvs.GetTLV( 0x1E, &outLenx1E, (const BYTE **)&pTLVx1E );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx1E < sizeof( sWDSGetDefaultSettingsResponse_IPAddress ))
@@ -1314,10 +1320,13 @@ ULONG ParseStartDataSession(
       return eGOBI_ERR_INVALID_ARG;
    }
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Check mandatory response
    const sResultCode * pTLVx02;
    ULONG outLenx02;
-   ULONG rc = GetTLV( inLen, pIn, 0x02, &outLenx02, (const BYTE **)&pTLVx02 );
+   ULONG rc = tlvs.GetTLV( 0x02, &outLenx02, (const BYTE **)&pTLVx02 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -1338,7 +1347,7 @@ ULONG ParseStartDataSession(
       // Still parse call end reason, if present
       const sWDSStartNetworkInterfaceResponse_CallEndReason * pTLVx10;
       ULONG outLenx10;
-      ULONG rc2 = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+      ULONG rc2 = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
       if (rc2 == eGOBI_ERR_NONE)
       {
          if (outLenx10 >= sizeof( sWDSStartNetworkInterfaceResponse_CallEndReason ))
@@ -1353,7 +1362,7 @@ ULONG ParseStartDataSession(
    // Find the Session ID
    const sWDSStartNetworkInterfaceResponse_PacketDataHandle * pTLVx01;
    ULONG outLenx01;
-   rc = GetTLV( inLen, pIn, 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
+   rc = tlvs.GetTLV( 0x01, &outLenx01, (const BYTE **)&pTLVx01 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx01 < sizeof( sWDSStartNetworkInterfaceResponse_PacketDataHandle ))
@@ -1691,10 +1700,13 @@ ULONG ParseGetPacketStatus(
 
    // NOTE: All TLVs are required.  If any fail then all fail
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TX packet sucesses
    const sWDSGetPacketStatisticsResponse_TXPacketSuccesses * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sWDSGetPacketStatisticsResponse_TXPacketSuccesses ))
@@ -1710,7 +1722,7 @@ ULONG ParseGetPacketStatus(
    // Find the RX packet sucesses
    const sWDSGetPacketStatisticsResponse_RXPacketSuccesses * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sWDSGetPacketStatisticsResponse_RXPacketSuccesses ))
@@ -1726,7 +1738,7 @@ ULONG ParseGetPacketStatus(
    // Find the TX packet errors
    const sWDSGetPacketStatisticsResponse_TXPacketErrors * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx12 < sizeof( sWDSGetPacketStatisticsResponse_TXPacketErrors ))
@@ -1742,7 +1754,7 @@ ULONG ParseGetPacketStatus(
    // Find the RX packet errors
    const sWDSGetPacketStatisticsResponse_RXPacketErrors * pTLVx13;
    ULONG outLenx13;
-   rc = GetTLV( inLen, pIn, 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
+   rc = tlvs.GetTLV( 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx13 < sizeof( sWDSGetPacketStatisticsResponse_RXPacketErrors ))
@@ -1758,7 +1770,7 @@ ULONG ParseGetPacketStatus(
    // Find the TX packet overflows
    const sWDSGetPacketStatisticsResponse_TXOverflows * pTLVx14;
    ULONG outLenx14;
-   rc = GetTLV( inLen, pIn, 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
+   rc = tlvs.GetTLV( 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx14 < sizeof( sWDSGetPacketStatisticsResponse_TXOverflows ))
@@ -1774,7 +1786,7 @@ ULONG ParseGetPacketStatus(
    // Find the RX packet overflows
    const sWDSGetPacketStatisticsResponse_RXOverflows * pTLVx15;
    ULONG outLenx15;
-   rc = GetTLV( inLen, pIn, 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
+   rc = tlvs.GetTLV( 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx15 < sizeof( sWDSGetPacketStatisticsResponse_RXOverflows ))
@@ -1887,10 +1899,13 @@ ULONG ParseGetByteTotals(
 
    // NOTE: All TLVs are required.  If any fail then all fail
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the TX bytes
    const sWDSGetPacketStatisticsResponse_TXBytes * pTLVx19;
    ULONG outLenx19;
-   ULONG rc = GetTLV( inLen, pIn, 0x19, &outLenx19, (const BYTE **)&pTLVx19 );
+   ULONG rc = tlvs.GetTLV( 0x19, &outLenx19, (const BYTE **)&pTLVx19 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx19 < sizeof( sWDSGetPacketStatisticsResponse_TXBytes ))
@@ -1906,7 +1921,7 @@ ULONG ParseGetByteTotals(
    // Find the RX bytes
    const sWDSGetPacketStatisticsResponse_RXBytes * pTLVx1A;
    ULONG outLenx1A;
-   rc = GetTLV( inLen, pIn, 0x1A, &outLenx1A, (const BYTE **)&pTLVx1A );
+   rc = tlvs.GetTLV( 0x1A, &outLenx1A, (const BYTE **)&pTLVx1A );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx1A < sizeof( sWDSGetPacketStatisticsResponse_RXBytes ))
@@ -2632,10 +2647,13 @@ ULONG ParseGetMobileIPProfile(
    *pHAState = 0xffffffff;
    *pAAAState = 0xffffffff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the State
    const sWDSGetMIPProfileResponse_State * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sWDSGetMIPProfileResponse_State ))
@@ -2649,7 +2667,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the Home Address
    const sWDSGetMIPProfileResponse_HomeAddress * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sWDSGetMIPProfileResponse_HomeAddress ))
@@ -2668,7 +2686,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the Primary Home Agent Address
    const sWDSGetMIPProfileResponse_PrimaryHomeAgentAddress * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx12 < sizeof( sWDSGetMIPProfileResponse_PrimaryHomeAgentAddress ))
@@ -2687,7 +2705,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the Secondary Home Agent Address
    const sWDSGetMIPProfileResponse_SecondaryHomeAgentAddress * pTLVx13;
    ULONG outLenx13;
-   rc = GetTLV( inLen, pIn, 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
+   rc = tlvs.GetTLV( 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx13 < sizeof( sWDSGetMIPProfileResponse_SecondaryHomeAgentAddress ))
@@ -2706,7 +2724,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the Reverse tunneling, if enabled
    const sWDSGetMIPProfileResponse_ReverseTunneling * pTLVx14;
    ULONG outLenx14;
-   rc = GetTLV( inLen, pIn, 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
+   rc = tlvs.GetTLV( 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sWDSGetMIPProfileResponse_ReverseTunneling ))
@@ -2720,7 +2738,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the NAI, if enabled
    const sWDSGetMIPProfileResponse_NAI * pTLVx15;
    ULONG outLenx15;
-   rc = GetTLV( inLen, pIn, 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
+   rc = tlvs.GetTLV( 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (naiSize < outLenx15 + 1)
@@ -2737,7 +2755,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the HA SPI
    const sWDSGetMIPProfileResponse_HASPI * pTLVx16;
    ULONG outLenx16;
-   rc = GetTLV( inLen, pIn, 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
+   rc = tlvs.GetTLV( 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx16 < sizeof( sWDSGetMIPProfileResponse_HASPI ))
@@ -2751,7 +2769,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the AAA SPI
    const sWDSGetMIPProfileResponse_AAASPI * pTLVx17;
    ULONG outLenx17;
-   rc = GetTLV( inLen, pIn, 0x17, &outLenx17, (const BYTE **)&pTLVx17 );
+   rc = tlvs.GetTLV( 0x17, &outLenx17, (const BYTE **)&pTLVx17 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx17 < sizeof( sWDSGetMIPProfileResponse_AAASPI ))
@@ -2765,7 +2783,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the HA state
    const sWDSGetMIPProfileResponse_HAState * pTLVx1A;
    ULONG outLenx1A;
-   rc = GetTLV( inLen, pIn, 0x1A, &outLenx1A, (const BYTE **)&pTLVx1A );
+   rc = tlvs.GetTLV( 0x1A, &outLenx1A, (const BYTE **)&pTLVx1A );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx1A < sizeof( sWDSGetMIPProfileResponse_HAState ))
@@ -2779,7 +2797,7 @@ ULONG ParseGetMobileIPProfile(
    // Find the AAA state
    const sWDSGetMIPProfileResponse_AAAState * pTLVx1B;
    ULONG outLenx1B;
-   rc = GetTLV( inLen, pIn, 0x1B, &outLenx1B, (const BYTE **)&pTLVx1B );
+   rc = tlvs.GetTLV( 0x1B, &outLenx1B, (const BYTE **)&pTLVx1B );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx1B < sizeof( sWDSGetMIPProfileResponse_AAAState ))
@@ -3114,10 +3132,13 @@ ULONG ParseGetMobileIPParameters(
    *pHAAuthenticator = 0xff;
    *pHA2002bis = 0xff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the mode
    const sWDSGetMIPParametersResponse_MobileIPMode * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sWDSGetMIPParametersResponse_MobileIPMode ))
@@ -3131,7 +3152,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the Retry limit
    const sWDSGetMIPParametersResponse_RetryAttemptLimit * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sWDSGetMIPParametersResponse_RetryAttemptLimit ))
@@ -3145,7 +3166,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the Retry Interval
    const sWDSGetMIPParametersResponse_RetryAttemptInterval * pTLVx12;
    ULONG outLenx12;
-   rc = GetTLV( inLen, pIn, 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
+   rc = tlvs.GetTLV( 0x12, &outLenx12, (const BYTE **)&pTLVx12 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx12 < sizeof( sWDSGetMIPParametersResponse_RetryAttemptInterval ))
@@ -3159,7 +3180,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the Re-registration period
    const sWDSGetMIPParametersResponse_ReRegistrationPeriod * pTLVx13;
    ULONG outLenx13;
-   rc = GetTLV( inLen, pIn, 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
+   rc = tlvs.GetTLV( 0x13, &outLenx13, (const BYTE **)&pTLVx13 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx13 < sizeof( sWDSGetMIPParametersResponse_ReRegistrationPeriod ))
@@ -3173,7 +3194,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the Re-register on traffic flag
    const sWDSGetMIPParametersResponse_ReRegistrationOnlyWithTraffic * pTLVx14;
    ULONG outLenx14;
-   rc = GetTLV( inLen, pIn, 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
+   rc = tlvs.GetTLV( 0x14, &outLenx14, (const BYTE **)&pTLVx14 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx14 < sizeof( sWDSGetMIPParametersResponse_ReRegistrationOnlyWithTraffic ))
@@ -3187,7 +3208,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the HA authenticator
    const sWDSGetMIPParametersResponse_MNHAAuthenticatorCalculator * pTLVx15;
    ULONG outLenx15;
-   rc = GetTLV( inLen, pIn, 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
+   rc = tlvs.GetTLV( 0x15, &outLenx15, (const BYTE **)&pTLVx15 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx15 < sizeof( sWDSGetMIPParametersResponse_MNHAAuthenticatorCalculator ))
@@ -3201,7 +3222,7 @@ ULONG ParseGetMobileIPParameters(
    // Find the HA RFC2002bis authentication flag
    const sWDSGetMIPParametersResponse_MNHARFC2002BISAuthentication * pTLVx16;
    ULONG outLenx16;
-   rc = GetTLV( inLen, pIn, 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
+   rc = tlvs.GetTLV( 0x16, &outLenx16, (const BYTE **)&pTLVx16 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx16 < sizeof( sWDSGetMIPParametersResponse_MNHARFC2002BISAuthentication ))
@@ -3396,10 +3417,13 @@ ULONG ParseGetDNSSettings(
       return eGOBI_ERR_INVALID_ARG;
    }
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Find the Primary DNS
    const sWDSGetDNSSettingResponse_PrimaryDNS * pTLVx10;
    ULONG outLenx10;
-   ULONG rc = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+   ULONG rc = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx10 < sizeof( sWDSGetDNSSettingResponse_PrimaryDNS ))
@@ -3418,7 +3442,7 @@ ULONG ParseGetDNSSettings(
    // Find the Secondary DNS
    const sWDSGetDNSSettingResponse_SecondaryDNS * pTLVx11;
    ULONG outLenx11;
-   rc = GetTLV( inLen, pIn, 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
+   rc = tlvs.GetTLV( 0x11, &outLenx11, (const BYTE **)&pTLVx11 );
    if (rc == eGOBI_ERR_NONE)
    {
       if (outLenx11 < sizeof( sWDSGetDNSSettingResponse_SecondaryDNS ))
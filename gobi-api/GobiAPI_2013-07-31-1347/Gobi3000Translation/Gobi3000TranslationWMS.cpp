@@ -747,10 +747,13 @@ ULONG ParseSendSMS(
    // Assume we have no message failure cause code
    *pMessageFailureCode = 0xffffffff;
 
+   // Index the TLVs
+   cTLVIndex tlvs( inLen, pIn );
+
    // Check mandatory response
    const sResultCode * pTLVx02;
    ULONG outLenx02;
-   ULONG rc = GetTLV( inLen, pIn, 0x02, &outLenx02, (const BYTE **)&pTLVx02 );
+   ULONG rc = tlvs.GetTLV( 0x02, &outLenx02, (const BYTE **)&pTLVx02 );
    if (rc != eGOBI_ERR_NONE)
    {
       return rc;
@@ -771,7 +774,7 @@ ULONG ParseSendSMS(
       // Check for the failure code (optional)
       const sWMSRawSendResponse_CauseCode * pTLVx10;
       ULONG outLenx10;
-      ULONG rc2 = GetTLV( inLen, pIn, 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
+      ULONG rc2 = tlvs.GetTLV( 0x10, &outLenx10, (const BYTE **)&pTLVx10 );
       if (rc2 == eGOBI_ERR_NONE)
       {
          if (outLenx10 < sizeof( sWMSRawSendResponse_CauseCode ))
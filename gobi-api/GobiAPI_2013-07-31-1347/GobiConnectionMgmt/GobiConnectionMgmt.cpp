@@ -117,15 +117,17 @@ void * TrafficProcessThread( PVOID pArg )
    TRACE( "GobiConnectionMgmt traffic thread [%u] started\n", 
           (UINT)pthread_self() );
 
+   // The events do not change while we run, register them only once
+   cEventSet eventSet( events );
+
    // Loop waiting for exit event
    while (bRun == true)
    {
       // Wait for activity
       DWORD ignoredVal, index;
-      int nRet = WaitOnMultipleEvents( events, 
-                                       TRAFFIC_INTERVAL_MS, 
-                                       ignoredVal, 
-                                       index );
+      int nRet = eventSet.Wait( TRAFFIC_INTERVAL_MS, 
+                                ignoredVal, 
+                                index );
    
       // Timeout
       if (nRet == -ETIME)
@@ -199,6 +201,312 @@ void * CallbackThread( PVOID pArg )
    return 0;
 }
 
+/*===========================================================================
+METHOD:
+   CallbackPoolThread (Free Method)
+   
+DESCRIPTION:
+   Callback dispatcher thread, executes queued callbacks in order
+
+PARAMETERS:
+   pArg        [ I ] - The cGobiCMCallbackPool::sWorker object
+
+RETURN VALUE:
+   void * - thread exit value (always 0)
+===========================================================================*/
+void * CallbackPoolThread( PVOID pArg )
+{
+   cGobiCMCallbackPool::sWorker * pWorker = 0;
+   pWorker = (cGobiCMCallbackPool::sWorker *)pArg;
+   if (pWorker == 0)
+   {
+      ASSERT( 0 );
+      return 0;
+   }
+
+   TRACE( "GobiConnectionMgmt callback thread [%u] started\n", 
+          (UINT)pthread_self() );
+
+   pthread_mutex_lock( &pWorker->mSyncSection );
+
+   while (true)
+   {
+      while (pWorker->mQueue.size() == 0 && pWorker->mbExit == false)
+      {
+         pthread_cond_wait( &pWorker->mSignal, &pWorker->mSyncSection );
+      }
+
+      // Only exit once everything queued has been executed
+      if (pWorker->mQueue.size() == 0)
+      {
+         break;
+      }
+
+      cGobiCMCallback * pCB = pWorker->mQueue.front();
+      pWorker->mQueue.pop_front();
+
+      // Execute the callback without holding up the dispatcher
+      pthread_mutex_unlock( &pWorker->mSyncSection );
+
+      if (pCB != 0)
+      {
+         pCB->Call();
+         delete pCB;
+      }
+
+      pthread_mutex_lock( &pWorker->mSyncSection );
+   }
+
+   bool bDetached = pWorker->mbDetached;
+   pthread_mutex_unlock( &pWorker->mSyncSection );
+
+   TRACE( "GobiConnectionMgmt callback thread [%u] exited\n", 
+          (UINT)pthread_self() );
+
+   // Nobody is waiting on us, clean up our own state
+   if (bDetached == true)
+   {
+      pthread_cond_destroy( &pWorker->mSignal );
+      pthread_mutex_destroy( &pWorker->mSyncSection );
+      delete pWorker;
+   }
+
+   return 0;
+}
+
+/*=========================================================================*/
+// cGobiCMCallbackPool Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cGobiCMCallbackPool (Public Method)
+
+DESCRIPTION:
+   Constructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cGobiCMCallbackPool::cGobiCMCallbackPool()
+   :  mQueued( 0 ),
+      mDropped( 0 )
+{
+   // Nothing to do
+}
+
+/*===========================================================================
+METHOD:
+   ~cGobiCMCallbackPool (Public Method)
+
+DESCRIPTION:
+   Destructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cGobiCMCallbackPool::~cGobiCMCallbackPool()
+{
+   Stop();
+}
+
+/*===========================================================================
+METHOD:
+   Start (Public Method)
+
+DESCRIPTION:
+   Start the dispatcher threads
+  
+RETURN VALUE:
+   bool
+===========================================================================*/
+bool cGobiCMCallbackPool::Start()
+{
+   // Already started?
+   if (mWorkers.size() > 0)
+   {
+      return true;
+   }
+
+   for (ULONG t = 0; t < CALLBACK_POOL_THREADS; t++)
+   {
+      sWorker * pWorker = new sWorker;
+      pWorker->mThreadID = 0;
+      pWorker->mbExit = false;
+      pWorker->mbDetached = false;
+      pthread_mutex_init( &pWorker->mSyncSection, NULL );
+      pthread_cond_init( &pWorker->mSignal, NULL );
+
+      int nRC = pthread_create( &pWorker->mThreadID,
+                                NULL,
+                                CallbackPoolThread,
+                                pWorker );
+
+      if (nRC != 0)
+      {
+         TRACE( "GobiConnectionMgmt callback thread error %d\n", nRC );
+
+         pthread_cond_destroy( &pWorker->mSignal );
+         pthread_mutex_destroy( &pWorker->mSyncSection );
+         delete pWorker;
+
+         Stop();
+         return false;
+      }
+
+      mWorkers.push_back( pWorker );
+   }
+
+   // Success!
+   return true;
+}
+
+/*===========================================================================
+METHOD:
+   Stop (Public Method)
+
+DESCRIPTION:
+   Stop the dispatcher threads, each thread exits once the callbacks
+   queued on it have been executed
+
+   NOTE: When called from within a callback the calling thread is left
+   to exit on its own
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiCMCallbackPool::Stop()
+{
+   if (mWorkers.size() == 0)
+   {
+      return;
+   }
+
+   for (ULONG t = 0; t < (ULONG)mWorkers.size(); t++)
+   {
+      sWorker * pWorker = mWorkers[t];
+
+      bool bSelf = (pthread_equal( pthread_self(), pWorker->mThreadID ) != 0);
+
+      pthread_mutex_lock( &pWorker->mSyncSection );
+      pWorker->mbExit = true;
+      pWorker->mbDetached = bSelf;
+      pthread_cond_signal( &pWorker->mSignal );
+      pthread_mutex_unlock( &pWorker->mSyncSection );
+
+      if (bSelf == true)
+      {
+         pthread_detach( pWorker->mThreadID );
+         continue;
+      }
+
+      pthread_join( pWorker->mThreadID, NULL );
+
+      pthread_cond_destroy( &pWorker->mSignal );
+      pthread_mutex_destroy( &pWorker->mSyncSection );
+      delete pWorker;
+   }
+
+   mWorkers.clear();
+
+   ULONG queued = 0;
+   ULONG dropped = 0;
+   GetCounts( queued, dropped );
+
+   TRACE( "GobiConnectionMgmt callbacks: %lu queued, %lu dropped\n",
+          queued,
+          dropped );
+}
+
+/*===========================================================================
+METHOD:
+   Dispatch (Public Method)
+
+DESCRIPTION:
+   Queue a callback for execution, callbacks for the same service/message
+   pair are executed in the order they were dispatched
+
+   NOTE: The pool takes ownership of the callback, which is deleted right
+   away if it cannot be queued (i.e. the dispatcher thread is backed up)
+  
+PARAMETERS:
+   svcID       [ I ] - Service ID of the callback
+   msgID       [ I ] - Message ID of the callback
+   pCallback   [ I ] - Callback to execute
+
+RETURN VALUE:
+   bool - Was the callback queued?
+===========================================================================*/
+bool cGobiCMCallbackPool::Dispatch( 
+   ULONG                      svcID,
+   ULONG                      msgID,
+   cGobiCMCallback *          pCallback )
+{
+   if (pCallback == 0)
+   {
+      return false;
+   }
+
+   // Assume failure
+   bool bRC = false;
+
+   ULONG workers = (ULONG)mWorkers.size();
+   if (workers > 0)
+   {
+      sWorker * pWorker = mWorkers[(svcID * 31 + msgID) % workers];
+
+      pthread_mutex_lock( &pWorker->mSyncSection );
+
+      if (pWorker->mQueue.size() < CALLBACK_POOL_QUEUE_DEPTH)
+      {
+         pWorker->mQueue.push_back( pCallback );
+         pthread_cond_signal( &pWorker->mSignal );
+         bRC = true;
+      }
+
+      pthread_mutex_unlock( &pWorker->mSyncSection );
+   }
+
+   if (bRC == true)
+   {
+      __atomic_add_fetch( &mQueued, 1, __ATOMIC_RELAXED );
+   }
+   else
+   {
+      __atomic_add_fetch( &mDropped, 1, __ATOMIC_RELAXED );
+      TRACE( "GobiConnectionMgmt callback 0x%02lX/0x%04lX dropped (%lu)\n",
+             svcID,
+             msgID,
+             __atomic_load_n( &mDropped, __ATOMIC_RELAXED ) );
+
+      delete pCallback;
+   }
+
+   return bRC;
+}
+
+/*===========================================================================
+METHOD:
+   GetCounts (Public Method)
+
+DESCRIPTION:
+   Return the number of callbacks queued/dropped so far
+  
+PARAMETERS:
+   queued      [ O ] - Number of callbacks queued for execution
+   dropped     [ O ] - Number of callbacks dropped
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiCMCallbackPool::GetCounts( 
+   ULONG &                    queued,
+   ULONG &                    dropped ) const
+{
+   queued = __atomic_load_n( &mQueued, __ATOMIC_RELAXED );
+   dropped = __atomic_load_n( &mDropped, __ATOMIC_RELAXED );
+}
+
 /*=========================================================================*/
 // CGobiConnectionMgmtDLL Methods
 /*=========================================================================*/
@@ -468,13 +776,8 @@ void cGobiConnectionMgmt::ProcessTraffic( eQMIService svc )
                                      outLen,
                                      pOutput );
 
-         if (pCB != 0)
-         {
-            if (pCB->Initialize() == false)
-            {
-               delete pCB;
-            }
-         }
+         // Hand off to the dispatcher threads (which take ownership)
+         mCallbackPool.Dispatch( svcID, msgID, pCB );
       }
 
       si.mLogsProcessed = count;
@@ -505,6 +808,9 @@ std::set <eQMIService> cGobiConnectionMgmt::Connect(
       // Start the traffic processing thread?
       if (mbThreadStarted == false)
       {
+         // Start the callback dispatcher threads
+         mCallbackPool.Start();
+
          // Clear mExitEvent;
          mExitEvent.Clear();
 
@@ -556,6 +862,9 @@ bool cGobiConnectionMgmt::Disconnect()
    mbThreadStarted = false;
    mThreadID = 0;
 
+   // Exit callback dispatcher threads (once queued callbacks are executed)
+   mCallbackPool.Stop();
+
    return cGobiQMICore::Disconnect();
 }
 
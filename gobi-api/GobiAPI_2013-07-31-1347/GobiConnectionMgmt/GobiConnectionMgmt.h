@@ -8,6 +8,7 @@ DESCRIPTION:
 PUBLIC CLASSES AND FUNCTIONS:
    CGobiConnectionMgmtDLL
    cGobiConnectionMgmt
+   cGobiCMCallbackPool
 
 Copyright (c) 2013, The Linux Foundation. All rights reserved.
 
@@ -48,10 +49,18 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "QMIBuffers.h"
 
+#include <deque>
+
 //---------------------------------------------------------------------------
 // Definitions
 //---------------------------------------------------------------------------
 
+// Number of callback dispatcher threads
+const ULONG CALLBACK_POOL_THREADS = 4;
+
+// Maximum number of callbacks waiting on a single dispatcher thread
+const ULONG CALLBACK_POOL_QUEUE_DEPTH = 32;
+
 // Handle to Gobi API
 typedef ULONG_PTR GOBIHANDLE;
 
@@ -71,6 +80,10 @@ extern "C"
 // Thread to execute a callback asynchronously
 void * CallbackThread( PVOID pArg );
 
+// CallbackPoolThread prototype
+// Callback dispatcher thread, executes queued callbacks in order
+void * CallbackPoolThread( PVOID pArg );
+
 /*=========================================================================*/
 // Class cGobiCMCallback
 /*=========================================================================*/
@@ -114,6 +127,79 @@ class cGobiCMCallback
 
       // Function thread gets full access
       friend void * CallbackThread( PVOID pArg );
+
+      // Dispatcher threads get full access
+      friend void * CallbackPoolThread( PVOID pArg );
+};
+
+/*=========================================================================*/
+// Class cGobiCMCallbackPool
+//
+//    Fixed set of threads executing callbacks, callbacks for the same
+//    service/message pair are always executed by the same thread and
+//    hence in the order they were dispatched
+/*=========================================================================*/
+class cGobiCMCallbackPool
+{
+   public:
+      // Constructor
+      cGobiCMCallbackPool();
+
+      // Destructor
+      virtual ~cGobiCMCallbackPool();
+
+      // Start the dispatcher threads
+      bool Start();
+
+      // Stop the dispatcher threads (once queued callbacks are executed)
+      void Stop();
+
+      // Queue a callback for execution (taking ownership of it)
+      bool Dispatch( 
+         ULONG                      svcID,
+         ULONG                      msgID,
+         cGobiCMCallback *          pCallback );
+
+      // Return the number of callbacks queued/dropped so far
+      void GetCounts( 
+         ULONG &                    queued,
+         ULONG &                    dropped ) const;
+
+   protected:
+      /* Dispatcher thread state */
+      struct sWorker
+      {
+         public:
+            /* ID of dispatcher thread */
+            pthread_t mThreadID;
+
+            /* Synchronization object for the below */
+            pthread_mutex_t mSyncSection;
+
+            /* Signalled when a callback is queued or upon exit */
+            pthread_cond_t mSignal;
+
+            /* Callbacks waiting to be executed */
+            std::deque <cGobiCMCallback *> mQueue;
+
+            /* Should the thread exit once the queue is empty? */
+            bool mbExit;
+
+            /* Has the thread been left to clean up after itself? */
+            bool mbDetached;
+      };
+
+      /* Dispatcher threads (empty when stopped) */
+      std::vector <sWorker *> mWorkers;
+
+      /* Number of callbacks queued */
+      ULONG mQueued;
+
+      /* Number of callbacks dropped (queue full or pool stopped) */
+      ULONG mDropped;
+
+      // Dispatcher threads get full access
+      friend void * CallbackPoolThread( PVOID pArg );
 };
 
 /*=========================================================================*/
@@ -210,6 +296,14 @@ class cGobiConnectionMgmt : public cGobiQMICore
          tFNGenericCallback         pCallback,
          ULONG_PTR                  userValue );
 
+      // (Inline) Return the number of callbacks queued/dropped so far
+      void GetCallbackCounts( 
+         ULONG &                    queued,
+         ULONG &                    dropped ) const
+      {
+         mCallbackPool.GetCounts( queued, dropped );
+      };
+
    protected:
       // Process new traffic
       void ProcessTraffic( eQMIService svc );
@@ -232,6 +326,9 @@ class cGobiConnectionMgmt : public cGobiQMICore
 
       /* Callback functions */
       std::map <tCallbackKey, tCallbackValue> mCallbacks;
+
+      /* Callback dispatcher threads */
+      cGobiCMCallbackPool mCallbackPool;
       
       // Traffic process thread gets full access
       friend VOID * TrafficProcessThread( PVOID pArg );
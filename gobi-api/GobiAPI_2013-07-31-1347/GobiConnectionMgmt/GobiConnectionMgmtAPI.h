@@ -83,6 +83,36 @@ typedef void (* tFNGenericCallback)(
    };
 #endif
 
+/*=========================================================================*/
+// Struct sGobiBatchEntry
+//    Request sent through GobiSendBatch()
+/*=========================================================================*/
+struct sGobiBatchEntry
+{
+   /* Service ID */
+   ULONG mServiceID;
+
+   /* Message ID */
+   ULONG mMessageID;
+
+   /* Length of input buffer */
+   ULONG mInLen;
+
+   /* Input buffer */
+   const BYTE * mpIn;
+
+   /* Upon input the maximum number of BYTEs mpOut can contain, upon 
+      output the number of BYTEs copied to mpOut (the number of BYTEs 
+      needed when mpOut is too small, 0 when nothing was copied) */
+   ULONG mOutLen;
+
+   /* Output buffer */
+   BYTE * mpOut;
+
+   /* Return code of this request (upon output) */
+   ULONG mStatus;
+};
+
 /*=========================================================================*/
 // Prototypes
 /*=========================================================================*/
@@ -173,6 +203,31 @@ ULONG SetGenericCallback(
    ULONG                      msgID,
    tFNGenericCallback         pCallback );
 
+/*===========================================================================
+METHOD:
+   GobiSendBatch
+
+DESCRIPTION:
+   This function sends several independent requests at once and waits for
+   all of the responses together (i.e. in the time of a single round 
+   trip, when the device allows for it)
+  
+PARAMETERS:
+   handle      [ I ] - Gobi interface handle
+   to          [ I ] - Timeout for the whole batch (in milliseconds)
+   count       [ I ] - Number of requests in pEntries
+   pEntries    [I/O] - The requests, upon output the return code and 
+                       response of each request (see sGobiBatchEntry)
+
+RETURN VALUE:
+   ULONG - Return code (that of the first request to fail, if any)
+===========================================================================*/
+ULONG GobiSendBatch( 
+   GOBIHANDLE                 handle,
+   ULONG                      to,
+   ULONG                      count,
+   sGobiBatchEntry *          pEntries );
+
 /*===========================================================================
 METHOD:
    WDSReset
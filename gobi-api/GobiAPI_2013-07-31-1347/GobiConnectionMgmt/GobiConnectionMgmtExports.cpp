@@ -37,6 +37,7 @@ POSSIBILITY OF SUCH DAMAGE.
 //---------------------------------------------------------------------------
 #include "StdAfx.h"
 #include "GobiConnectionMgmt.h"
+#include "GobiConnectionMgmtAPI.h"
 
 //---------------------------------------------------------------------------
 // Definitions
@@ -236,6 +237,97 @@ ULONG SetGenericCallback(
                                            handle );
 }
 
+/*===========================================================================
+METHOD:
+   GobiSendBatch
+
+DESCRIPTION:
+   This function sends several independent requests at once and waits for
+   all of the responses together (i.e. in the time of a single round 
+   trip, when the device allows for it)
+  
+PARAMETERS:
+   handle      [ I ] - Gobi interface handle
+   to          [ I ] - Timeout for the whole batch (in milliseconds)
+   count       [ I ] - Number of requests in pEntries
+   pEntries    [I/O] - The requests, upon output the return code and 
+                       response of each request (see sGobiBatchEntry)
+
+RETURN VALUE:
+   ULONG - Return code (that of the first request to fail, if any)
+===========================================================================*/
+ULONG GobiSendBatch( 
+   GOBIHANDLE                 handle,
+   ULONG                      to,
+   ULONG                      count,
+   sGobiBatchEntry *          pEntries )
+{
+   cGobiConnectionMgmt * pAPI = gDLL.GetAPI( handle );
+   if (pAPI == 0)
+   {
+      return (ULONG)eGOBI_ERR_INTERNAL;
+   }
+
+   if (count == 0 || pEntries == 0)
+   {
+      return (ULONG)eGOBI_ERR_INVALID_ARG;
+   }
+
+   std::vector <sGobiBatchRequest> requests( count );
+   for (ULONG e = 0; e < count; e++)
+   {
+      const sGobiBatchEntry & entry = pEntries[e];
+      sGobiBatchRequest & req = requests[e];
+
+      req.mServiceID = entry.mServiceID;
+      req.mMessageID = entry.mMessageID;
+      if (entry.mInLen > 0 && entry.mpIn != 0)
+      {
+         req.mInput.assign( entry.mpIn, entry.mpIn + entry.mInLen );
+      }
+   }
+
+   pAPI->SendBatch( requests, to );
+
+   // Hand back each response the way Send() does
+   ULONG rc = (ULONG)eGOBI_ERR_NONE;
+   for (ULONG e = 0; e < count; e++)
+   {
+      sGobiBatchEntry & entry = pEntries[e];
+      const sGobiBatchRequest & req = requests[e];
+
+      entry.mStatus = (ULONG)req.mError;
+
+      ULONG needSz = (ULONG)req.mOutput.size();
+      if (entry.mOutLen > 0 && needSz > 0)
+      {
+         ULONG maxSz = entry.mOutLen;
+         entry.mOutLen = needSz;
+
+         if (needSz > maxSz || entry.mpOut == 0)
+         {
+            entry.mStatus = (ULONG)eGOBI_ERR_BUFFER_SZ;
+         }
+         else
+         {
+            memcpy( entry.mpOut, &req.mOutput[0], needSz );
+         }
+      }
+      else
+      {
+         // Nothing was copied (no response or no output buffer)
+         entry.mOutLen = 0;
+      }
+
+      if (rc == (ULONG)eGOBI_ERR_NONE)
+      {
+         rc = entry.mStatus;
+      }
+   }
+
+   return rc;
+}
+
 /*===========================================================================
 METHOD:
    WDSReset
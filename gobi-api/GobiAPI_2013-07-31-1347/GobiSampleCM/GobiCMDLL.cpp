@@ -481,6 +481,80 @@ ULONG cGobiCMDLL::GetDataBearerTechnology( ULONG * pDataBearerTech )
    return status;
 }
 
+/*===========================================================================
+METHOD:
+   GetBearerAndDuration (Public Method)
+
+DESCRIPTION:
+   Calls WDSGetDataBearerTechnology and WDSGetDataSessionDuration as a 
+   single batch (saving a round trip)
+
+PARAMETERS:
+   pDataBearerTech   [ O ] - Data bearer technology
+   pSessionDuration  [ O ] - Session duration
+
+RETURN VALUE:
+   ULONG
+===========================================================================*/
+ULONG cGobiCMDLL::GetBearerAndDuration(
+   ULONG *                    pDataBearerTech,
+   ULONGLONG *                pSessionDuration )
+{
+   // Assume failure
+   if (pDataBearerTech != 0)
+   {
+      *pDataBearerTech = 0xFFFFFFFF;
+   }
+
+   if (pSessionDuration != 0)
+   {
+      *pSessionDuration = 0xFFFFFFFF;
+   }
+
+   ULONG status = eGOBI_ERR_GENERAL;
+   if (mhGobi == 0)
+   {
+      return status;
+   }
+
+   BYTE bearerRsp[1024] = { 0 };
+   BYTE durationRsp[1024] = { 0 };
+
+   sGobiBatchEntry entries[2];
+   memset( &entries[0], 0, sizeof( entries ) );
+
+   // WDS/Get Data Bearer Technology
+   entries[0].mServiceID = 1;
+   entries[0].mMessageID = 55;
+   entries[0].mOutLen = (ULONG)sizeof( bearerRsp );
+   entries[0].mpOut = &bearerRsp[0];
+
+   // WDS/Get Data Session Duration
+   entries[1].mServiceID = 1;
+   entries[1].mMessageID = 53;
+   entries[1].mOutLen = (ULONG)sizeof( durationRsp );
+   entries[1].mpOut = &durationRsp[0];
+
+   status = GobiSendBatch( mhGobi, 2000, 2, &entries[0] );
+   if (status != 0)
+   {
+      return status;
+   }
+
+   status = ParseGetDataBearerTechnology( entries[0].mOutLen, 
+                                          &bearerRsp[0], 
+                                          pDataBearerTech );
+   if (status != 0)
+   {
+      return status;
+   }
+
+   status = ParseGetSessionDuration( entries[1].mOutLen, 
+                                     &durationRsp[0], 
+                                     pSessionDuration );
+   return status;
+}
+
 /*===========================================================================
 METHOD:
    GetConnectionRate (Public Method)
@@ -161,6 +161,11 @@ class cGobiCMDLL
       // Get data bearer technology
       ULONG GetDataBearerTechnology( ULONG * pDataBearerTech );
 
+      // Get data bearer technology and session duration (in one batch)
+      ULONG GetBearerAndDuration(
+         ULONG *                    pDataBearerTech,
+         ULONGLONG *                pSessionDuration );
+
       // Get connection rate
       ULONG GetConnectionRate(
          ULONG *                    pCurTX,
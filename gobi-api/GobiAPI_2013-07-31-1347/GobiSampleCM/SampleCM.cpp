@@ -1341,18 +1341,12 @@ DESCRIPTION:
 ===========================================================================*/
 void cSampleCM::CheckConnectedStats()
 {
-   ULONG rc = mGobi.GetDataBearerTechnology( &mDataBearerTech );
-   if (rc != eGOBI_ERR_NONE || mDataBearerTech == ULONG_MAX)
-   {
-      TRACE( "GetDataBearerTechnology error %lu\n", rc );
-      return;
-   }
-
+   // Both queries go out together
    ULONGLONG duration;
-   rc = mGobi.GetSessionDuration( &duration );
-   if (rc != eGOBI_ERR_NONE)
+   ULONG rc = mGobi.GetBearerAndDuration( &mDataBearerTech, &duration );
+   if (rc != eGOBI_ERR_NONE || mDataBearerTech == ULONG_MAX)
    {
-      TRACE( "GetSessionDuration error %lu\n", rc );
+      TRACE( "GetBearerAndDuration error %lu\n", rc );
       return;
    }
 
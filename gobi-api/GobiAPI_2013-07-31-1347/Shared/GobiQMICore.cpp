@@ -44,6 +44,13 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "QMIBuffers.h"
 #include "ProtocolNotification.h"
 
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Default number of buffers kept in the protocol log of each service
+const ULONG DEFAULT_LOG_SIZE = 512;
+
 /*=========================================================================*/
 // cGobiQMICore Methods
 /*=========================================================================*/
@@ -59,9 +66,15 @@ RETURN VALUE:
    None
 ===========================================================================*/
 cGobiQMICore::cGobiQMICore()
-   :  mLastError( eGOBI_ERR_NONE )
+   :  mbMultiplexedIO( false ),
+      mLogSizes(),
+      mIOMultiplexer(),
+      mLastError( eGOBI_ERR_NONE ),
+      mLastAsyncHandle( INVALID_ASYNC_HANDLE )
 {
    mInterface[0] = 0;
+
+   pthread_mutex_init( &mAsyncSection, NULL );
 }
 
 /*===========================================================================
@@ -77,6 +90,8 @@ RETURN VALUE:
 cGobiQMICore::~cGobiQMICore()
 {
    Cleanup();
+
+   pthread_mutex_destroy( &mAsyncSection );
 }
 
 /*===========================================================================
@@ -141,14 +156,34 @@ std::set <eQMIService> cGobiQMICore::Connect(
       return retServices;
    }
 
+   // Start the shared I/O thread?
+   if (mbMultiplexedIO == true && mIOMultiplexer.Start() == false)
+   {
+      mLastError = eGOBI_ERR_CONNECT;
+      return retServices;
+   }
+
    // Allocate configured QMI servers
    std::set <eQMIService>::const_iterator pIter = services.begin();
    while (pIter != services.end())
    {
+      ULONG logSz = DEFAULT_LOG_SIZE;
+      std::map <eQMIService, ULONG>::const_iterator pSizeIter;
+      pSizeIter = mLogSizes.find( *pIter );
+      if (pSizeIter != mLogSizes.end())
+      {
+         logSz = pSizeIter->second;
+      }
+
       cQMIProtocolServer * pSvr = 0;
-      pSvr = new cQMIProtocolServer( *pIter, 8192, 512 );
+      pSvr = new cQMIProtocolServer( *pIter, 8192, logSz );
       if (pSvr != 0)
       {
+         if (mbMultiplexedIO == true)
+         {
+            pSvr->SetMultiplexer( &mIOMultiplexer );
+         }
+
          // Initialize server (we don't care about the return code
          // since the following Connect() call will fail if we are
          // unable to initialize the server)
@@ -163,6 +198,12 @@ std::set <eQMIService> cGobiQMICore::Connect(
 
             retServices.insert( *pIter );
          }
+         else if (mbMultiplexedIO == true)
+         {
+            // Do not leave a schedule behind on the shared I/O thread
+            pSvr->Exit();
+            delete pSvr;
+         }
       }
    
       pIter++;
@@ -173,6 +214,7 @@ std::set <eQMIService> cGobiQMICore::Connect(
    {
       // Yes, disconnect them all
       Disconnect();
+      mIOMultiplexer.Stop();
 
       // ... and set the error code
       mLastError = eGOBI_ERR_CONNECT;
@@ -208,6 +250,26 @@ bool cGobiQMICore::Disconnect()
       return bRC;
    }
 
+   // Fail outstanding SendAsync() based operations while the servers
+   // are still around to cancel them
+   pthread_mutex_lock( &mAsyncSection );
+   std::map <ULONG, sAsyncRequest> asyncRequests = mAsyncRequests;
+   pthread_mutex_unlock( &mAsyncSection );
+
+   std::map <ULONG, sAsyncRequest>::const_iterator pAsyncIter;
+   pAsyncIter = asyncRequests.begin();
+   while (pAsyncIter != asyncRequests.end())
+   {
+      const sAsyncRequest & ar = pAsyncIter->second;
+      if (ar.mpServer != 0 && ar.mRequestID != INVALID_REQUEST_ID)
+      {
+         ar.mpServer->RemoveRequest( ar.mRequestID );
+      }
+
+      FinishAsync( pAsyncIter->first, eGOBI_ERR_NO_CONNECTION, 0 );
+      pAsyncIter++;
+   }
+
    // Disconnect/clean-up all configured QMI servers
    std::map <eQMIService, sServerInfo>::iterator pIter;
    pIter = mServers.begin();
@@ -230,6 +292,9 @@ bool cGobiQMICore::Disconnect()
 
    mServers.clear();
 
+   // Every server is gone, so is the need for the shared I/O thread
+   mIOMultiplexer.Stop();
+
    bRC = true;
    return bRC;
 }
@@ -529,5 +594,674 @@ eGobiError cGobiQMICore::CancelSend(
    return eGOBI_ERR_NONE;
 }
 
+/*===========================================================================
+METHOD:
+   SendAsync (Public Method)
+
+DESCRIPTION:
+   Send a request using the specified QMI protocol server without waiting
+   for the response, the outcome (including the response) is added to the 
+   given completion queue once the request completes
+
+   NOTE: Every request that is successfully scheduled results in exactly
+   one completion, the completion queue must outlive the request
+  
+PARAMETERS:
+   svcID       [ I ] - Service ID to send request on
+   msgID       [ I ] - Message ID of request
+   to          [ I ] - Timeout value (in milliseconds)
+   inLen       [ I ] - Length of input buffer
+   pIn         [ I ] - Input buffer
+   completions [ I ] - Completion queue to add the outcome to
+   userValue   [ I ] - User value to pass back in the completion
+
+RETURN VALUE:
+   ULONG - Request handle (INVALID_ASYNC_HANDLE upon failure, in which 
+           case GetLastError() returns the reason)
+===========================================================================*/
+ULONG cGobiQMICore::SendAsync(
+   ULONG                      svcID,
+   ULONG                      msgID,
+   ULONG                      to,
+   ULONG                      inLen,
+   const BYTE *               pIn,
+   cGobiCompletionQueue &     completions,
+   ULONG_PTR                  userValue )
+{
+   // Clear last error recorded
+   ClearLastError();
+
+   if (msgID > 0xffff || to == 0)
+   {
+      mLastError = eGOBI_ERR_INVALID_ARG;
+      return INVALID_ASYNC_HANDLE;
+   }
+
+   // Grab the server
+   std::map <eQMIService, cGobiQMICore::sServerInfo>::iterator pSvrIter;
+   pSvrIter = mServers.find( (eQMIService)svcID );
+   if (pSvrIter == mServers.end())
+   {
+      mLastError = eGOBI_ERR_NO_CONNECTION;
+      return INVALID_ASYNC_HANDLE;
+   }
+
+   cQMIProtocolServer * pSvr = pSvrIter->second.mpServer;
+   if (pSvr == 0 || pSvr->IsConnected() == false)
+   {
+      mLastError = eGOBI_ERR_NO_CONNECTION;
+      return INVALID_ASYNC_HANDLE;
+   }
+
+   sSharedBuffer * pRequest = 0;
+   pRequest = sQMIServiceBuffer::BuildBuffer( (eQMIService)svcID,
+                                              (WORD)msgID,
+                                              false,
+                                              false,
+                                              pIn,
+                                              inLen );
+
+   if (pRequest == 0)
+   {
+      mLastError = eGOBI_ERR_MEMORY;
+      return INVALID_ASYNC_HANDLE;
+   }
+
+   // Register the request before it is scheduled, the outcome may well
+   // be in before AddRequest() returns
+   sAsyncRequest ar;
+   ar.mpServer = pSvr;
+   ar.mRequestID = INVALID_REQUEST_ID;
+   ar.mServiceID = svcID;
+   ar.mMessageID = msgID;
+   ar.mUserValue = userValue;
+   ar.mpCompletions = &completions;
+
+   pthread_mutex_lock( &mAsyncSection );
+
+   ULONG handle = ++mLastAsyncHandle;
+   while ( (handle == INVALID_ASYNC_HANDLE)
+   ||      (mAsyncRequests.find( handle ) != mAsyncRequests.end()) )
+   {
+      handle = ++mLastAsyncHandle;
+   }
+
+   mAsyncRequests[handle] = ar;
+
+   pthread_mutex_unlock( &mAsyncSection );
+
+   // Build the request object
+   cGobiAsyncNotification pn( this, handle );
+   sProtocolRequest req( pRequest, 0, to, 1, 1, &pn );
+
+   // Schedule the request
+   ULONG reqID = pSvr->AddRequest( req );
+   if (reqID == INVALID_REQUEST_ID)
+   {
+      pthread_mutex_lock( &mAsyncSection );
+      mAsyncRequests.erase( handle );
+      pthread_mutex_unlock( &mAsyncSection );
+
+      mLastError = eGOBI_ERR_REQ_SCHEDULE;
+      return INVALID_ASYNC_HANDLE;
+   }
+
+   // Store for cancel (unless already complete)
+   pthread_mutex_lock( &mAsyncSection );
+
+   std::map <ULONG, sAsyncRequest>::iterator pIter;
+   pIter = mAsyncRequests.find( handle );
+   if (pIter != mAsyncRequests.end())
+   {
+      pIter->second.mRequestID = reqID;
+   }
+
+   pthread_mutex_unlock( &mAsyncSection );
+
+   return handle;
+}
+
+/*===========================================================================
+METHOD:
+   CancelAsync (Public Method)
+
+DESCRIPTION:
+   Cancel an in-progress SendAsync() based operation, the operation
+   still results in a completion (reporting the cancellation)
+
+PARAMETERS:
+   handle      [ I ] - Request handle (as returned by SendAsync())
+
+RETURN VALUE:
+   eGobiError - The result
+===========================================================================*/
+eGobiError cGobiQMICore::CancelAsync( ULONG handle )
+{
+   pthread_mutex_lock( &mAsyncSection );
+
+   bool bFound = false;
+   sAsyncRequest ar;
+
+   std::map <ULONG, sAsyncRequest>::const_iterator pIter;
+   pIter = mAsyncRequests.find( handle );
+   if (pIter != mAsyncRequests.end())
+   {
+      ar = pIter->second;
+      bFound = true;
+   }
+
+   pthread_mutex_unlock( &mAsyncSection );
+
+   if (bFound == false || ar.mRequestID == INVALID_REQUEST_ID)
+   {
+      return eGOBI_ERR_NO_CANCELABLE_OP;
+   }
+
+   // NOTE: The protocol server notifies us of the cancellation (and hence
+   // completes the request) unless the request was yet to be sent
+   bool bRemove = ar.mpServer->RemoveRequest( ar.mRequestID );
+   if (bRemove == false)
+   {
+      return eGOBI_ERR_CANCEL_OP;
+   }
+
+   FinishAsync( handle, eGOBI_ERR_REQUEST, 0 );
+   return eGOBI_ERR_NONE;
+}
+
+/*===========================================================================
+METHOD:
+   SendBatch (Public Method)
 
+DESCRIPTION:
+   Send several independent requests at once (using the appropriate 
+   QMI protocol servers) and wait for all of the responses together, the
+   result/response of each request is stored with the request itself
+
+PARAMETERS:
+   requests    [I/O] - Requests to send (results/responses upon output)
+   to          [ I ] - Timeout value for the whole batch (in milliseconds)
+
+RETURN VALUE:
+   eGobiError - eGOBI_ERR_NONE if every request succeeded, otherwise
+                the error of the first request that failed
+===========================================================================*/
+eGobiError cGobiQMICore::SendBatch(
+   std::vector <sGobiBatchRequest> &   requests,
+   ULONG                               to )
+{
+   // Clear last error recorded
+   ClearLastError();
+
+   if (to == 0)
+   {
+      mLastError = eGOBI_ERR_INVALID_ARG;
+      return mLastError;
+   }
+
+   ULONGLONG deadline = GetTickCount() + (ULONGLONG)to;
+
+   // Schedule everything up front
+   cGobiCompletionQueue completions;
+   std::map <ULONG, ULONG> pending;
+
+   ULONG reqCount = (ULONG)requests.size();
+   for (ULONG r = 0; r < reqCount; r++)
+   {
+      sGobiBatchRequest & req = requests[r];
+      req.mOutput.clear();
 
+      const BYTE * pIn = 0;
+      if (req.mInput.size() > 0)
+      {
+         pIn = &req.mInput[0];
+      }
+
+      ULONG handle = SendAsync( req.mServiceID,
+                                req.mMessageID,
+                                to,
+                                (ULONG)req.mInput.size(),
+                                pIn,
+                                completions,
+                                (ULONG_PTR)r );
+
+      if (handle == INVALID_ASYNC_HANDLE)
+      {
+         req.mError = GetCorrectedLastError();
+         continue;
+      }
+
+      req.mError = eGOBI_ERR_INTERNAL;
+      pending[handle] = r;
+   }
+
+   // Collect the responses as they come in
+   std::set <ULONG> timedOut;
+   while (pending.size() > 0)
+   {
+      ULONGLONG now = GetTickCount();
+      if (now >= deadline)
+      {
+         // Give up on the rest, cancelling makes sure every remaining 
+         // request is complete (and hence in the queue) before we go
+         std::map <ULONG, ULONG>::const_iterator pIter = pending.begin();
+         while (pIter != pending.end())
+         {
+            CancelAsync( pIter->first );
+            FinishAsync( pIter->first, eGOBI_ERR_RESPONSE_TO, 0 );
+
+            timedOut.insert( pIter->first );
+            pIter++;
+         }
+
+         deadline = now;
+      }
+
+      sGobiAsyncCompletion completion;
+      if (completions.Poll( (DWORD)(deadline - now), completion ) == false)
+      {
+         if (timedOut.size() > 0)
+         {
+            // Everything was completed above, so this should never happen
+            ASSERT( 0 );
+            break;
+         }
+
+         continue;
+      }
+
+      std::map <ULONG, ULONG>::iterator pIter;
+      pIter = pending.find( completion.mHandle );
+      if (pIter == pending.end())
+      {
+         continue;
+      }
+
+      sGobiBatchRequest & req = requests[pIter->second];
+      req.mError = completion.mError;
+      req.mOutput.swap( completion.mOutput );
+
+      // Report cancellations on our part as timeouts (as Send() does)
+      if (timedOut.find( completion.mHandle ) != timedOut.end())
+      {
+         if (req.mError == eGOBI_ERR_REQUEST)
+         {
+            req.mError = eGOBI_ERR_REQUEST_TO;
+         }
+         else if (req.mError == eGOBI_ERR_RESPONSE)
+         {
+            req.mError = eGOBI_ERR_RESPONSE_TO;
+         }
+      }
+
+      pending.erase( pIter );
+   }
+
+   // Report the first failure (if any)
+   for (ULONG r = 0; r < reqCount; r++)
+   {
+      if (requests[r].mError != eGOBI_ERR_NONE)
+      {
+         mLastError = requests[r].mError;
+         return mLastError;
+      }
+   }
+
+   // Success!
+   return eGOBI_ERR_NONE;
+}
+
+/*===========================================================================
+METHOD:
+   CompleteAsync (Internal Method)
+
+DESCRIPTION:
+   Handle a protocol event for a SendAsync() based operation
+
+PARAMETERS:
+   handle      [ I ] - Request handle
+   eventType   [ I ] - Protocol event type
+   param       [ I ] - Second event parameter
+
+SEQUENCING:
+   Called from the protocol server thread
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiQMICore::CompleteAsync(
+   ULONG                      handle,
+   eProtocolEventType         eventType,
+   DWORD                      param )
+{
+   switch (eventType)
+   {
+      case ePROTOCOL_EVT_REQ_ERR:
+         FinishAsync( handle, eGOBI_ERR_REQUEST, 0 );
+         break;
+
+      case ePROTOCOL_EVT_RSP_ERR:
+      {
+         // A response error without an error code is a timeout
+         eGobiError ec = eGOBI_ERR_RESPONSE;
+         if (param == 0)
+         {
+            ec = eGOBI_ERR_RESPONSE_TO;
+         }
+
+         FinishAsync( handle, ec, 0 );
+      }
+      break;
+
+      case ePROTOCOL_EVT_RSP_RECV:
+      {
+         pthread_mutex_lock( &mAsyncSection );
+
+         cQMIProtocolServer * pSvr = 0;
+         std::map <ULONG, sAsyncRequest>::const_iterator pIter;
+         pIter = mAsyncRequests.find( handle );
+         if (pIter != mAsyncRequests.end())
+         {
+            pSvr = pIter->second.mpServer;
+         }
+
+         pthread_mutex_unlock( &mAsyncSection );
+
+         if (pSvr != 0)
+         {
+            const cProtocolLog & protocolLog = pSvr->GetLog();
+            sProtocolBuffer rsp = protocolLog.GetBuffer( param );
+
+            FinishAsync( handle, eGOBI_ERR_NONE, &rsp );
+         }
+      }
+      break;
+
+      default:
+         break;
+   }
+}
+
+/*===========================================================================
+METHOD:
+   FinishAsync (Internal Method)
+
+DESCRIPTION:
+   Complete a SendAsync() based operation by adding its outcome to the
+   completion queue, nothing is done if the operation was already 
+   completed
+
+   NOTE: Once the operation is no longer outstanding its completion is
+   guaranteed to be in the queue
+
+PARAMETERS:
+   handle      [ I ] - Request handle
+   ec          [ I ] - Result (when there is no response)
+   pRsp        [ I ] - Response received (0 if none)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiQMICore::FinishAsync(
+   ULONG                      handle,
+   eGobiError                 ec,
+   const sProtocolBuffer *    pRsp )
+{
+   pthread_mutex_lock( &mAsyncSection );
+
+   std::map <ULONG, sAsyncRequest>::iterator pIter;
+   pIter = mAsyncRequests.find( handle );
+   if (pIter == mAsyncRequests.end())
+   {
+      pthread_mutex_unlock( &mAsyncSection );
+      return;
+   }
+
+   sAsyncRequest ar = pIter->second;
+
+   sGobiAsyncCompletion completion;
+   completion.mHandle = handle;
+   completion.mServiceID = ar.mServiceID;
+   completion.mMessageID = ar.mMessageID;
+   completion.mUserValue = ar.mUserValue;
+   completion.mError = ec;
+
+   if (pRsp != 0)
+   {
+      completion.mError = ParseResponse( *pRsp, completion.mOutput );
+   }
+
+   if (ar.mpCompletions != 0)
+   {
+      ar.mpCompletions->Add( completion );
+   }
+
+   mAsyncRequests.erase( pIter );
+
+   pthread_mutex_unlock( &mAsyncSection );
+}
+
+/*===========================================================================
+METHOD:
+   ParseResponse (Internal Method)
+
+DESCRIPTION:
+   Parse a QMI response as Send() does
+
+PARAMETERS:
+   rsp         [ I ] - Response received
+   output      [ O ] - Response content
+
+RETURN VALUE:
+   eGobiError - The result
+===========================================================================*/
+eGobiError cGobiQMICore::ParseResponse( 
+   const sProtocolBuffer &    rsp,
+   std::vector <BYTE> &       output )
+{
+   if (rsp.IsValid() == false)
+   {
+      return eGOBI_ERR_INTERNAL;
+   }
+
+   // Did we receive a valid QMI response?
+   sQMIServiceBuffer qmiRsp( rsp.GetSharedBuffer() );
+   if (qmiRsp.IsValid() == false)
+   {
+      return eGOBI_ERR_MALFORMED_RSP;
+   }
+
+   // TLV 2 is always present
+   ULONG needSz = 0;
+   const BYTE * pData = (const BYTE *)qmiRsp.GetRawContents( needSz );
+   if (needSz == 0 || pData == 0)
+   {
+      return eGOBI_ERR_INVALID_RSP;
+   }
+
+   output.assign( pData, pData + needSz );
+
+   // Check the mandatory QMI result TLV for success
+   ULONG rc = 0;
+   ULONG ec = 0;
+   bool bResult = qmiRsp.GetResult( rc, ec );
+   if (bResult == false)
+   {
+      return eGOBI_ERR_MALFORMED_RSP;
+   }
+   else if (rc != 0)
+   {
+      return GetCorrectedQMIError( ec );
+   }
+
+   // Success!
+   return eGOBI_ERR_NONE;
+}
+
+/*=========================================================================*/
+// cGobiAsyncNotification Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   Notify (Public Method)
+
+DESCRIPTION:
+   Notify the core of a protocol event
+
+PARAMETERS:
+   eventType   [ I ] - Protocol event type
+   param1      [ I ] - Event type specific argument (see header description)
+   param2      [ I ] - Event type specific argument (see header description)
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiAsyncNotification::Notify(
+   eProtocolEventType         eventType,
+   DWORD                      /* param1 */,
+   DWORD                      param2 ) const
+{
+   if (mpCore != 0)
+   {
+      mpCore->CompleteAsync( mHandle, eventType, param2 );
+   }
+}
+
+/*=========================================================================*/
+// cGobiCompletionQueue Methods
+/*=========================================================================*/
+
+/*===========================================================================
+METHOD:
+   cGobiCompletionQueue (Public Method)
+
+DESCRIPTION:
+   Constructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cGobiCompletionQueue::cGobiCompletionQueue()
+{
+   pthread_mutex_init( &mSyncSection, NULL );
+}
+
+/*===========================================================================
+METHOD:
+   ~cGobiCompletionQueue (Public Method)
+
+DESCRIPTION:
+   Destructor
+  
+RETURN VALUE:
+   None
+===========================================================================*/
+cGobiCompletionQueue::~cGobiCompletionQueue()
+{
+   pthread_mutex_destroy( &mSyncSection );
+}
+
+/*===========================================================================
+METHOD:
+   Poll (Public Method)
+
+DESCRIPTION:
+   Wait (up to the given timeout) for the next completion
+
+PARAMETERS:
+   timeoutMS   [ I ] - Timeout (in milliseconds, 0 to not wait at all)
+   completion  [ O ] - The completion
+
+RETURN VALUE:
+   bool - Was a completion returned?
+===========================================================================*/
+bool cGobiCompletionQueue::Poll( 
+   DWORD                      timeoutMS,
+   sGobiAsyncCompletion &     completion )
+{
+   ULONGLONG deadline = GetTickCount() + (ULONGLONG)timeoutMS;
+
+   // NOTE: Each completion signals the event once and each completion
+   // polled consumes one signal, unless a waiter outside of Poll() got to
+   // it first; the queue itself is what counts
+   bool bSignalConsumed = false;
+   while (true)
+   {
+      pthread_mutex_lock( &mSyncSection );
+
+      if (mCompletions.size() > 0)
+      {
+         completion = mCompletions.front();
+         mCompletions.pop_front();
+
+         pthread_mutex_unlock( &mSyncSection );
+
+         if (bSignalConsumed == false)
+         {
+            DWORD val = 0;
+            mSignalEvent.Wait( 0, val );
+         }
+
+         return true;
+      }
+
+      pthread_mutex_unlock( &mSyncSection );
+
+      ULONGLONG now = GetTickCount();
+      if (now >= deadline)
+      {
+         return false;
+      }
+
+      DWORD val = 0;
+      int nRet = mSignalEvent.Wait( (DWORD)(deadline - now), val );
+      if (nRet != 0 && nRet != ETIME)
+      {
+         return false;
+      }
+
+      bSignalConsumed = (nRet == 0);
+   }
+}
+
+/*===========================================================================
+METHOD:
+   GetCount (Public Method)
+
+DESCRIPTION:
+   Return the number of completions waiting to be polled
+
+RETURN VALUE:
+   ULONG
+===========================================================================*/
+ULONG cGobiCompletionQueue::GetCount() const
+{
+   pthread_mutex_lock( &mSyncSection );
+   ULONG count = (ULONG)mCompletions.size();
+   pthread_mutex_unlock( &mSyncSection );
+
+   return count;
+}
+
+/*===========================================================================
+METHOD:
+   Add (Internal Method)
+
+DESCRIPTION:
+   Add a completion to the queue and signal it
+
+PARAMETERS:
+   completion  [ I ] - The completion
+
+RETURN VALUE:
+   None
+===========================================================================*/
+void cGobiCompletionQueue::Add( const sGobiAsyncCompletion & completion )
+{
+   pthread_mutex_lock( &mSyncSection );
+   mCompletions.push_back( completion );
+   pthread_mutex_unlock( &mSyncSection );
+
+   mSignalEvent.Set( (DWORD)completion.mHandle );
+}
@@ -45,9 +45,180 @@ POSSIBILITY OF SUCH DAMAGE.
 //---------------------------------------------------------------------------
 #include "ProtocolBuffer.h"
 #include "QMIProtocolServer.h"
+#include "IOMultiplexer.h"
 #include "SyncQueue.h"
+#include "ProtocolNotification.h"
 #include "GobiError.h"
 
+#include <deque>
+#include <set>
+
+//---------------------------------------------------------------------------
+// Definitions
+//---------------------------------------------------------------------------
+
+// Handle returned by cGobiQMICore::SendAsync() upon failure
+const ULONG INVALID_ASYNC_HANDLE = 0;
+
+// Forward declarations
+class cGobiQMICore;
+
+/*=========================================================================*/
+// Struct sGobiAsyncCompletion
+//
+//    Outcome of a request issued through cGobiQMICore::SendAsync()
+/*=========================================================================*/
+struct sGobiAsyncCompletion
+{
+   public:
+      // (Inline) Constructor
+      sGobiAsyncCompletion()
+         :  mHandle( INVALID_ASYNC_HANDLE ),
+            mServiceID( 0 ),
+            mMessageID( 0 ),
+            mUserValue( 0 ),
+            mError( eGOBI_ERR_INTERNAL )
+      { };
+
+      /* Request handle (as returned by SendAsync()) */
+      ULONG mHandle;
+
+      /* Service ID */
+      ULONG mServiceID;
+
+      /* Message ID */
+      ULONG mMessageID;
+
+      /* User value (as passed to SendAsync()) */
+      ULONG_PTR mUserValue;
+
+      /* Result, as Send() would have returned it */
+      eGobiError mError;
+
+      /* Response content (as Send() would have copied it to pOut) */
+      std::vector <BYTE> mOutput;
+};
+
+/*=========================================================================*/
+// Struct sGobiBatchRequest
+//
+//    Request issued through cGobiQMICore::SendBatch() and its outcome
+/*=========================================================================*/
+struct sGobiBatchRequest
+{
+   public:
+      // (Inline) Constructor
+      sGobiBatchRequest()
+         :  mServiceID( 0 ),
+            mMessageID( 0 ),
+            mError( eGOBI_ERR_INTERNAL )
+      { };
+
+      /* Service ID */
+      ULONG mServiceID;
+
+      /* Message ID */
+      ULONG mMessageID;
+
+      /* Request content */
+      std::vector <BYTE> mInput;
+
+      /* Result, as Send() would have returned it */
+      eGobiError mError;
+
+      /* Response content (as Send() would have copied it to pOut) */
+      std::vector <BYTE> mOutput;
+};
+
+/*=========================================================================*/
+// Class cGobiCompletionQueue
+//
+//    Queue of completed asynchronous requests, a single queue can be
+//    shared by the requests of any number of services and devices
+/*=========================================================================*/
+class cGobiCompletionQueue
+{
+   public:
+      // Constructor
+      cGobiCompletionQueue();
+
+      // Destructor
+      ~cGobiCompletionQueue();
+
+      // Wait (up to the given timeout) for the next completion
+      bool Poll( 
+         DWORD                      timeoutMS,
+         sGobiAsyncCompletion &     completion );
+
+      // Return the number of completions waiting to be polled
+      ULONG GetCount() const;
+
+      // (Inline) Return the event signalled upon each completion, this
+      // allows waiting on several queues (see cEventSet), followed by 
+      // calling Poll() with a timeout of 0 until it fails
+      cEvent & GetSignalEvent()
+      {
+         return mSignalEvent;
+      };
+
+   protected:
+      // Add a completion to the queue
+      void Add( const sGobiAsyncCompletion & completion );
+
+      /* Synchronization object for the queue */
+      mutable pthread_mutex_t mSyncSection;
+
+      /* Completions waiting to be polled */
+      std::deque <sGobiAsyncCompletion> mCompletions;
+
+      /* Signalled upon each completion (value is the request handle) */
+      cEvent mSignalEvent;
+
+      // Core object gets full access
+      friend class cGobiQMICore;
+};
+
+/*=========================================================================*/
+// Class cGobiAsyncNotification
+//
+//    Protocol server notification for requests issued through
+//    cGobiQMICore::SendAsync(), hands the outcome back to the core
+/*=========================================================================*/
+class cGobiAsyncNotification : public cProtocolNotification
+{
+   public:
+      // (Inline) Constructor
+      cGobiAsyncNotification( 
+         cGobiQMICore *             pCore,
+         ULONG                      handle )
+         :  mpCore( pCore ),
+            mHandle( handle )
+      { };
+
+      // (Inline) Destructor
+      virtual ~cGobiAsyncNotification()
+      { };
+
+      // (Inline) Return a copy of this object
+      virtual cProtocolNotification * Clone() const
+      {
+         return new cGobiAsyncNotification( mpCore, mHandle );
+      };
+
+      // Notify the core of a protocol event
+      virtual void Notify(
+         eProtocolEventType         eventType,
+         DWORD                      param1,
+         DWORD                      param2 ) const;
+
+   protected:
+      /* Core object that issued the request */
+      cGobiQMICore * mpCore;
+
+      /* Request handle */
+      ULONG mHandle;
+};
+
 /*=========================================================================*/
 // Class cGobiQMICore
 /*=========================================================================*/
@@ -122,6 +293,41 @@ class cGobiQMICore
          return (eGobiError)ec;
       };
 
+      // (Inline) Serve all the services of the device from a single
+      // shared I/O thread (only allowed while disconnected)
+      bool SetMultiplexedIO( bool bMultiplexed )
+      {
+         if (mServers.size() > 0)
+         {
+            return false;
+         }
+
+         mbMultiplexedIO = bMultiplexed;
+         return true;
+      };
+
+      // (Inline) Are all the services served by a single I/O thread?
+      bool IsMultiplexedIO()
+      {
+         return mbMultiplexedIO;
+      };
+
+      // (Inline) Set the number of buffers kept in the protocol log of
+      // the given service (only allowed while disconnected), the log
+      // clamps it to 16 - 16K buffers and rounds it up to a power of two
+      bool SetLogSize( 
+         eQMIService                svc,
+         ULONG                      logSz )
+      {
+         if (mServers.size() > 0)
+         {
+            return false;
+         }
+
+         mLogSizes[svc] = logSz;
+         return true;
+      };
+
       // Connect to the specified Gobi device interface
       virtual std::set <eQMIService> Connect( 
          LPCSTR                     pInterface,
@@ -146,7 +352,68 @@ class cGobiQMICore
          ULONG                      svcID,
          ULONG *                    pTXID );
 
+      // Send a request using the specified QMI protocol server without
+      // waiting for the response, the outcome is added to the given
+      // completion queue
+      ULONG SendAsync(
+         ULONG                      svcID,
+         ULONG                      msgID,
+         ULONG                      to,
+         ULONG                      inLen,
+         const BYTE *               pIn,
+         cGobiCompletionQueue &     completions,
+         ULONG_PTR                  userValue = 0 );
+
+      // Cancel an in-progress SendAsync() based operation
+      eGobiError CancelAsync( ULONG handle );
+
+      // Send several independent requests at once and wait for all of
+      // the responses together
+      eGobiError SendBatch(
+         std::vector <sGobiBatchRequest> &   requests,
+         ULONG                               to );
+
    protected:
+      /* Outstanding SendAsync() based operation */
+      struct sAsyncRequest
+      {
+         public:
+            /* Protocol server the request was scheduled on */
+            cQMIProtocolServer * mpServer;
+
+            /* Protocol server request ID (INVALID_REQUEST_ID until known) */
+            ULONG mRequestID;
+
+            /* Service ID */
+            ULONG mServiceID;
+
+            /* Message ID */
+            ULONG mMessageID;
+
+            /* User value */
+            ULONG_PTR mUserValue;
+
+            /* Where the outcome goes */
+            cGobiCompletionQueue * mpCompletions;
+      };
+
+      // Handle a protocol event for a SendAsync() based operation
+      void CompleteAsync(
+         ULONG                      handle,
+         eProtocolEventType         eventType,
+         DWORD                      param );
+
+      // Complete a SendAsync() based operation (if still outstanding)
+      void FinishAsync(
+         ULONG                      handle,
+         eGobiError                 ec,
+         const sProtocolBuffer *    pRsp );
+
+      // Parse a QMI response as Send() does
+      eGobiError ParseResponse( 
+         const sProtocolBuffer &    rsp,
+         std::vector <BYTE> &       output );
+
       /* Device interface */
       CHAR mInterface[MAX_PATH];
 
@@ -186,6 +453,27 @@ class cGobiQMICore
       /* QMI protocol servers */
       std::map <eQMIService, sServerInfo> mServers;
 
+      /* Serve all the protocol servers from a single I/O thread? */
+      bool mbMultiplexedIO;
+
+      /* Protocol log sizes (services not present use the default) */
+      std::map <eQMIService, ULONG> mLogSizes;
+
+      /* Shared I/O thread (used when mbMultiplexedIO is set) */
+      cIOMultiplexer mIOMultiplexer;
+
       /* Last error recorded */
       eGobiError mLastError;
+
+      /* Outstanding SendAsync() based operations (indexed by handle) */
+      std::map <ULONG, sAsyncRequest> mAsyncRequests;
+
+      /* Last SendAsync() handle issued */
+      ULONG mLastAsyncHandle;
+
+      /* Synchronization object for the above */
+      pthread_mutex_t mAsyncSection;
+
+      // Asynchronous notifications get full access
+      friend class cGobiAsyncNotification;
 };
@@ -107,6 +107,12 @@ struct _QmiDevicePrivate {
     /* HT to keep track of ongoing transactions */
     GHashTable *transactions;
 
+    /* Completed transactions kept for reuse */
+    GPtrArray *transaction_pool;
+
+    /* Transactions matched while parsing input, with their response */
+    GPtrArray *matched_transactions;
+
     /* HT of clients that want to get indications */
     GHashTable *registered_clients;
 };
@@ -120,13 +126,15 @@ typedef struct {
 } TransactionWaitContext;
 
 typedef struct {
+    QmiDevice              *self;
     QmiMessage             *message;
     QmiMessageContext      *message_context;
-    GSimpleAsyncResult     *result;
+    QmiMessage             *response;
+    GTask                  *task;
     GSource                *timeout_source;
     GCancellable           *cancellable;
     gulong                  cancellable_id;
-    TransactionWaitContext *wait_ctx;
+    TransactionWaitContext  wait_ctx;
 
     /* abortable support */
     GError                                   *abort_error;
@@ -137,6 +145,45 @@ typedef struct {
     GDestroyNotify                            abort_user_data_free;
 } Transaction;
 
+/* Maximum number of completed transactions kept for reuse in each device;
+ * enough for the usual amount of requests in flight at the same time */
+#define TRANSACTION_POOL_MAX_SIZE 16
+
+static void
+transaction_pool_free (Transaction *tr)
+{
+    g_slice_free (Transaction, tr);
+}
+
+static Transaction *
+transaction_pool_acquire (QmiDevice *self)
+{
+    GPtrArray   *pool = self->priv->transaction_pool;
+    Transaction *tr;
+
+    if (pool->len == 0)
+        return g_slice_new0 (Transaction);
+
+    /* Removing the last item never reallocates the array */
+    tr = g_ptr_array_index (pool, pool->len - 1);
+    g_ptr_array_remove_index (pool, pool->len - 1);
+    memset (tr, 0, sizeof (Transaction));
+    return tr;
+}
+
+static void
+transaction_pool_release (QmiDevice   *self,
+                          Transaction *tr)
+{
+    GPtrArray *pool = self->priv->transaction_pool;
+
+    if (pool->len >= TRANSACTION_POOL_MAX_SIZE) {
+        transaction_pool_free (tr);
+        return;
+    }
+    g_ptr_array_add (pool, tr);
+}
+
 static Transaction *
 transaction_new (QmiDevice           *self,
                  QmiMessage          *message,
@@ -147,13 +194,13 @@ transaction_new (QmiDevice           *self,
 {
     Transaction *tr;
 
-    tr = g_slice_new0 (Transaction);
+    tr = transaction_pool_acquire (self);
+    tr->self = self;
     tr->message = qmi_message_ref (message);
     tr->message_context = (message_context ? qmi_message_context_ref (message_context) : NULL);
-    tr->result = g_simple_async_result_new (G_OBJECT (self),
-                                            callback,
-                                            user_data,
-                                            transaction_new);
+    /* The cancellable is handled by the transaction itself, not by the task,
+     * as it needs to report its own error */
+    tr->task = g_task_new (self, NULL, callback, user_data);
     if (cancellable)
         tr->cancellable = g_object_ref (cancellable);
 
@@ -165,9 +212,12 @@ transaction_complete_and_free (Transaction  *tr,
                                QmiMessage   *reply,
                                const GError *error)
 {
+    GTask  *task;
+    GError *task_error = NULL;
+
     g_assert (reply != NULL || error != NULL);
 
-    /* always set result first, as we may be using one of the GErrors
+    /* always copy the error first, as we may be using one of the GErrors
      * stored in the Transaction as result itself */
     if (reply) {
         /* if we got a valid response, we can cancel any ongoing abort
@@ -177,11 +227,8 @@ transaction_complete_and_free (Transaction  *tr,
                      qmi_message_get_transaction_id (tr->message));
             g_cancellable_cancel (tr->abort_cancellable);
         }
-        g_simple_async_result_set_op_res_gpointer (tr->result,
-                                                   qmi_message_ref (reply),
-                                                   (GDestroyNotify)qmi_message_unref);
     } else if (error)
-        g_simple_async_result_set_from_error (tr->result, error);
+        task_error = g_error_copy (error);
     else
         g_assert_not_reached ();
 
@@ -194,9 +241,6 @@ transaction_complete_and_free (Transaction  *tr,
         g_object_unref (tr->cancellable);
     }
 
-    if (tr->wait_ctx)
-        g_slice_free (TransactionWaitContext, tr->wait_ctx);
-
     if (tr->abort_error)
         g_error_free (tr->abort_error);
 
@@ -206,12 +250,23 @@ transaction_complete_and_free (Transaction  *tr,
     if (tr->abort_user_data && tr->abort_user_data_free)
         tr->abort_user_data_free (tr->abort_user_data);
 
-    g_simple_async_result_complete_in_idle (tr->result);
-    g_object_unref (tr->result);
     if (tr->message_context)
         qmi_message_context_unref (tr->message_context);
     qmi_message_unref (tr->message);
-    g_slice_free (Transaction, tr);
+
+    /* The task keeps a reference to the device, so recycle the transaction
+     * before dropping it */
+    task = tr->task;
+    transaction_pool_release (tr->self, tr);
+
+    /* GTask completes in an idle only when needed, i.e. if the transaction
+     * was created in this same main loop iteration (early errors); responses
+     * are reported right away. */
+    if (reply)
+        g_task_return_pointer (task, qmi_message_ref (reply), (GDestroyNotify) qmi_message_unref);
+    else
+        g_task_return_error (task, task_error);
+    g_object_unref (task);
 }
 
 static inline gpointer
@@ -320,7 +375,7 @@ transaction_abort (QmiDevice   *self,
      * to the user. */
     if (!__qmi_message_is_abortable (tr->message, tr->message_context)) {
         g_debug ("transaction 0x%x aborted, but message is not abortable", transaction_id);
-        device_release_transaction (self, tr->wait_ctx->key);
+        device_release_transaction (self, tr->wait_ctx.key);
         transaction_complete_and_free (tr, NULL, abort_error_take);
         g_error_free (abort_error_take);
         return;
@@ -330,7 +385,7 @@ transaction_abort (QmiDevice   *self,
      * then return the error right away anyway */
     if (!tr->abort_build_request_fn || !tr->abort_parse_response_fn) {
         g_debug ("transaction 0x%x aborted, but no way to build abort request", transaction_id);
-        device_release_transaction (self, tr->wait_ctx->key);
+        device_release_transaction (self, tr->wait_ctx.key);
         transaction_complete_and_free (tr, NULL, abort_error_take);
         g_error_free (abort_error_take);
         return;
@@ -347,7 +402,7 @@ transaction_abort (QmiDevice   *self,
         /* complete the transaction with the error we got while building the
          * abort request */
         g_debug ("transaction 0x%x aborted, but building abort request failed", transaction_id);
-        device_release_transaction (self, tr->wait_ctx->key);
+        device_release_transaction (self, tr->wait_ctx.key);
         transaction_complete_and_free (tr, NULL, error);
         g_error_free (error);
         return;
@@ -365,7 +420,7 @@ transaction_abort (QmiDevice   *self,
                              30,
                              tr->abort_cancellable,
                              (GAsyncReadyCallback) transaction_abort_ready,
-                             tr->wait_ctx->key);
+                             tr->wait_ctx.key);
 
     qmi_message_unref (abort_request);
 }
@@ -376,9 +431,15 @@ transaction_timed_out (TransactionWaitContext *ctx)
     Transaction *tr;
     GError *error = NULL;
 
-    /* A timed out transaction is always tracked */
     tr = device_peek_transaction (ctx->self, ctx->key);
-    g_assert (tr);
+
+    /* The timeout is disarmed as soon as the transaction is no longer tracked
+     * (e.g. matched with a response still to be reported), but just ignore
+     * it if it fires anyway. */
+    if (!tr) {
+        g_debug ("transaction timed out, but it has already been completed");
+        return G_SOURCE_REMOVE;
+    }
 
     tr->timeout_source = NULL;
 
@@ -422,14 +483,13 @@ device_store_transaction (QmiDevice *self,
 
     /* Setup the timeout and cancellation */
 
-    tr->wait_ctx = g_slice_new (TransactionWaitContext);
-    tr->wait_ctx->self = self;
-    tr->wait_ctx->key = key; /* valid as long as the transaction is in the HT */
+    tr->wait_ctx.self = self;
+    tr->wait_ctx.key = key; /* valid as long as the transaction is in the HT */
 
     /* Timeout is optional (e.g. disabled when MBIM is used) */
     if (timeout > 0) {
         tr->timeout_source = g_timeout_source_new_seconds (timeout);
-        g_source_set_callback (tr->timeout_source, (GSourceFunc)transaction_timed_out, tr->wait_ctx, NULL);
+        g_source_set_callback (tr->timeout_source, (GSourceFunc)transaction_timed_out, &tr->wait_ctx, NULL);
         g_source_attach (tr->timeout_source, g_main_context_get_thread_default ());
         g_source_unref (tr->timeout_source);
     }
@@ -439,7 +499,7 @@ device_store_transaction (QmiDevice *self,
          * cancellable is already cancelled */
         tr->cancellable_id = g_cancellable_connect (tr->cancellable,
                                                     (GCallback)transaction_cancelled,
-                                                    tr->wait_ctx,
+                                                    &tr->wait_ctx,
                                                     NULL);
         if (!tr->cancellable_id) {
             g_set_error (error,
@@ -476,8 +536,26 @@ static Transaction *
 device_match_transaction (QmiDevice *self,
                           QmiMessage *message)
 {
+    Transaction *tr;
+
     /* msg can be either the original message or the response */
-    return device_release_transaction (self, build_transaction_key (message));
+    tr = device_release_transaction (self, build_transaction_key (message));
+    if (!tr)
+        return NULL;
+
+    /* The response is reported once all input is processed, and the
+     * transaction is no longer in the HT, so neither the timeout nor the
+     * cancellation may complete it in the meantime */
+    if (tr->timeout_source) {
+        g_source_destroy (tr->timeout_source);
+        tr->timeout_source = NULL;
+    }
+    if (tr->cancellable_id) {
+        g_cancellable_disconnect (tr->cancellable, tr->cancellable_id);
+        tr->cancellable_id = 0;
+    }
+
+    return tr;
 }
 
 /*****************************************************************************/
@@ -1494,6 +1572,30 @@ qmi_device_set_instance_id (QmiDevice *self,
 
 static void process_message (QmiMessage *message, QmiDevice *self);
 
+static void
+complete_matched_transactions (QmiDevice *self)
+{
+    GPtrArray *matched = self->priv->matched_transactions;
+
+    /* Completing a transaction runs the user callback, which may end up
+     * disposing the device or processing input again (e.g. running a nested
+     * main loop), so always take the first pending one */
+    g_object_ref (self);
+    while (matched->len > 0) {
+        Transaction *tr;
+        QmiMessage  *response;
+
+        tr = g_ptr_array_index (matched, 0);
+        g_ptr_array_remove_index (matched, 0);
+
+        response = tr->response;
+        tr->response = NULL;
+        transaction_complete_and_free (tr, response, NULL);
+        qmi_message_unref (response);
+    }
+    g_object_unref (self);
+}
+
 static void
 endpoint_new_data_cb (QmiEndpoint *endpoint,
                       QmiDevice   *self)
@@ -1508,6 +1610,10 @@ endpoint_new_data_cb (QmiEndpoint *endpoint,
                    qmi_file_get_path_display (self->priv->file), error->message);
         g_error_free (error);
     }
+
+    /* Responses are reported only once the parser is done with the input
+     * buffer, but without waiting for another main loop iteration */
+    complete_matched_transactions (self);
 }
 
 static void
@@ -1657,8 +1763,9 @@ process_message (QmiMessage *message,
         } else {
             /* Matched transactions translated with the same context as the request */
             trace_message (self, message, FALSE, "response", tr->message_context);
-            /* Report the reply message */
-            transaction_complete_and_free (tr, message, NULL);
+            /* Report the reply message once all input is processed */
+            tr->response = qmi_message_ref (message);
+            g_ptr_array_add (self->priv->matched_transactions, tr);
         }
 
         return;
@@ -2301,11 +2408,7 @@ qmi_device_command_abortable_finish (QmiDevice     *self,
                                      GAsyncResult  *res,
                                      GError       **error)
 {
-    if (g_simple_async_result_propagate_error (G_SIMPLE_ASYNC_RESULT (res), error))
-        return NULL;
-
-    return qmi_message_ref (g_simple_async_result_get_op_res_gpointer (
-                                G_SIMPLE_ASYNC_RESULT (res)));
+    return g_task_propagate_pointer (G_TASK (res), error);
 }
 
 static void
@@ -2678,6 +2781,9 @@ qmi_device_init (QmiDevice *self)
 
     self->priv->transactions = g_hash_table_new (g_direct_hash,
                                                  g_direct_equal);
+    self->priv->transaction_pool = g_ptr_array_new_full (TRANSACTION_POOL_MAX_SIZE,
+                                                         (GDestroyNotify) transaction_pool_free);
+    self->priv->matched_transactions = g_ptr_array_sized_new (TRANSACTION_POOL_MAX_SIZE);
 
     self->priv->registered_clients = g_hash_table_new_full (g_direct_hash,
                                                             g_direct_equal,
@@ -2740,6 +2846,12 @@ finalize (GObject *object)
         g_assert (g_hash_table_size (self->priv->transactions) == 0);
         g_hash_table_unref (self->priv->transactions);
     }
+    g_ptr_array_unref (self->priv->transaction_pool);
+
+    /* Matched transactions are always completed before returning to the
+     * main loop */
+    g_assert (self->priv->matched_transactions->len == 0);
+    g_ptr_array_unref (self->priv->matched_transactions);
 
     g_hash_table_unref (self->priv->registered_clients);
 
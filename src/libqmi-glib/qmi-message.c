@@ -27,6 +27,8 @@
  * Copyright (C) 2012-2019 Aleksander Morgado <aleksander@aleksander.es>
  */
 
+#include <config.h>
+
 #include <glib.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -59,6 +61,10 @@
 
 #define PACKED __attribute__((packed))
 
+/* Most messages built locally are well below this size (the maximum QMUX
+ * frame size is 64K) */
+#define MESSAGE_PREALLOCATED_SIZE 512
+
 struct qmux {
   guint16 length;
   guint8 flags;
@@ -394,6 +400,38 @@ message_check (QmiMessage *self,
     return TRUE;
 }
 
+/*
+ * Checks only the length bookkeeping of a message built locally: the QMUX
+ * length must match the buffer length, and the QMI TLV length must match the
+ * QMUX length. This is O(1), as opposed to message_check() which walks all
+ * TLVs.
+ */
+static inline gboolean
+message_check_lengths (QmiMessage *self)
+{
+    gsize header_length;
+
+    header_length = sizeof (struct qmux) + (message_is_control (self) ?
+                                            sizeof (struct control_header) :
+                                            sizeof (struct service_header));
+
+    return (get_qmux_length (self) == self->len - 1 &&
+            get_qmux_length (self) == header_length + get_all_tlvs_length (self));
+}
+
+/*
+ * Messages built locally are only fully validated when configured with
+ * --enable-message-full-check (as 'make distcheck' does), so that appending
+ * TLVs doesn't end up being O(n^2) in regular builds. Messages received from
+ * outside (qmi_message_new_from_raw() and qmi_message_new_from_data()) are
+ * always fully validated with message_check().
+ */
+#if defined (QMI_ENABLE_MESSAGE_FULL_CHECK)
+# define message_assert_valid(self) g_assert (message_check (self, NULL))
+#else
+# define message_assert_valid(self) g_assert (message_check_lengths (self))
+#endif
+
 QmiMessage *
 qmi_message_new (QmiService service,
                  guint8 client_id,
@@ -420,8 +458,9 @@ qmi_message_new (QmiService service,
      * https://bugzilla.gnome.org/show_bug.cgi?id=738170
      */
 
-    /* Create the GByteArray with buffer_len bytes preallocated */
-    self = g_byte_array_sized_new (buffer_len);
+    /* Create the GByteArray with enough bytes preallocated for the usual
+     * message size, so that appending TLVs doesn't reallocate the buffer */
+    self = g_byte_array_sized_new (MESSAGE_PREALLOCATED_SIZE);
     /* Actually flag as all the buffer_len bytes being used. */
     g_byte_array_set_size (self, buffer_len);
 
@@ -446,7 +485,7 @@ qmi_message_new (QmiService service,
     set_all_tlvs_length (self, 0);
 
     /* We shouldn't create invalid empty messages */
-    g_assert (message_check (self, NULL));
+    message_assert_valid (self);
 
     return (QmiMessage *)self;
 }
@@ -526,7 +565,7 @@ qmi_message_response_new (QmiMessage       *request,
     g_assert (qmi_message_tlv_write_complete (response, tlv_offset, NULL));
 
     /* We shouldn't create invalid response messages */
-    g_assert (message_check (response, NULL));
+    message_assert_valid (response);
 
     return response;
 }
@@ -662,7 +701,7 @@ qmi_message_tlv_write_complete (QmiMessage  *self,
     set_all_tlvs_length (self, (guint16)(get_all_tlvs_length (self) + tlv_length));
 
     /* Make sure we didn't break anything. */
-    g_assert (message_check (self, NULL));
+    message_assert_valid (self);
 
     return TRUE;
 }
@@ -1449,7 +1488,7 @@ qmi_message_add_raw_tlv (QmiMessage *self,
     set_all_tlvs_length (self, (guint16)(get_all_tlvs_length (self) + tlv_len));
 
     /* Make sure we didn't break anything. */
-    g_assert (message_check (self, NULL));
+    message_assert_valid (self);
 
     return TRUE;
 }
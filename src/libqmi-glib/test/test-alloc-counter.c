@@ -0,0 +1,87 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <config.h>
+#include <stdlib.h>
+
+#include "test-alloc-counter.h"
+
+static volatile gint counting;
+static volatile gint n_allocations;
+
+#if defined (__GLIBC__)
+
+/* Interpose the allocator entry points, so that allocations done by GLib on
+ * behalf of the library are also counted */
+
+extern void *__libc_malloc  (size_t size);
+extern void *__libc_calloc  (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+void *
+malloc (size_t size)
+{
+    if (g_atomic_int_get (&counting))
+        g_atomic_int_inc (&n_allocations);
+    return __libc_malloc (size);
+}
+
+void *
+calloc (size_t nmemb,
+        size_t size)
+{
+    if (g_atomic_int_get (&counting))
+        g_atomic_int_inc (&n_allocations);
+    return __libc_calloc (nmemb, size);
+}
+
+void *
+realloc (void   *ptr,
+         size_t  size)
+{
+    if (g_atomic_int_get (&counting))
+        g_atomic_int_inc (&n_allocations);
+    return __libc_realloc (ptr, size);
+}
+
+gboolean
+test_alloc_counter_supported (void)
+{
+    return TRUE;
+}
+
+#else
+
+gboolean
+test_alloc_counter_supported (void)
+{
+    return FALSE;
+}
+
+#endif
+
+void
+test_alloc_counter_start (void)
+{
+    g_atomic_int_set (&n_allocations, 0);
+    g_atomic_int_set (&counting, TRUE);
+}
+
+guint
+test_alloc_counter_stop (void)
+{
+    g_atomic_int_set (&counting, FALSE);
+    return (guint) g_atomic_int_get (&n_allocations);
+}
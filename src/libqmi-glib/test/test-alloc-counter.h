@@ -0,0 +1,28 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef TEST_ALLOC_COUNTER_H
+#define TEST_ALLOC_COUNTER_H
+
+#include <glib.h>
+
+/* Counts the heap allocations done by any thread of the process between
+ * start() and stop(). Counting is only supported when building against
+ * glibc; otherwise stop() always returns 0. */
+gboolean test_alloc_counter_supported (void);
+void     test_alloc_counter_start     (void);
+guint    test_alloc_counter_stop      (void);
+
+#endif /* TEST_ALLOC_COUNTER_H */
@@ -0,0 +1,298 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+/*
+ * Every message and indication defined in the JSON data is built and read
+ * back through the public QMI message API, using the samples synthesized by
+ * qmi-codegen. By default each sample is just checked once and then fuzzed;
+ * when run in perf mode (e.g. 'make perf-report') the encode, decode,
+ * printable and free operations are also timed, and the ns/op and
+ * allocations/op of each of them are reported as minimized results in the
+ * gtester log.
+ */
+
+#include <config.h>
+#include <string.h>
+#include <libqmi-glib.h>
+
+#include "test-alloc-counter.h"
+#include "test-message-samples.h"
+
+/* Operations timed per message and operation in perf mode */
+#define BENCHMARK_ITERATIONS 1000
+
+/* Mutated copies of each sample parsed */
+#define FUZZ_ITERATIONS 64
+
+/*****************************************************************************/
+
+static void
+benchmark_start (void)
+{
+    test_alloc_counter_start ();
+    g_test_timer_start ();
+}
+
+static void
+benchmark_stop (const gchar *path,
+                const gchar *operation)
+{
+    gdouble elapsed;
+    guint   n_allocations;
+
+    elapsed = g_test_timer_elapsed ();
+    n_allocations = test_alloc_counter_stop ();
+
+    g_test_minimized_result (elapsed * 1e9 / BENCHMARK_ITERATIONS,
+                             "%s %s: ns/op", path, operation);
+    g_test_minimized_result ((gdouble) n_allocations / BENCHMARK_ITERATIONS,
+                             "%s %s: allocs/op", path, operation);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    const gchar             *name;
+    const TestMessageSample *samples;
+} TestService;
+
+static const TestService services[] = {
+    { "ctl",   test_message_samples_ctl   },
+    { "dms",   test_message_samples_dms   },
+    { "nas",   test_message_samples_nas   },
+    { "wds",   test_message_samples_wds   },
+    { "wms",   test_message_samples_wms   },
+    { "pds",   test_message_samples_pds   },
+    { "pdc",   test_message_samples_pdc   },
+    { "pbm",   test_message_samples_pbm   },
+    { "uim",   test_message_samples_uim   },
+    { "oma",   test_message_samples_oma   },
+    { "wda",   test_message_samples_wda   },
+    { "voice", test_message_samples_voice },
+    { "loc",   test_message_samples_loc   },
+    { "qos",   test_message_samples_qos   },
+    { "gas",   test_message_samples_gas   },
+    { "dsd",   test_message_samples_dsd   },
+};
+
+typedef struct {
+    gchar                   *path;
+    const TestService       *service;
+    const TestMessageSample *sample;
+} TestCase;
+
+static void
+test_case_free (TestCase *test)
+{
+    g_free (test->path);
+    g_slice_free (TestCase, test);
+}
+
+/*****************************************************************************/
+
+static QmiMessage *
+sample_message_new (GByteArray    *raw,
+                    const guint8  *data,
+                    gsize          data_size,
+                    GError       **error)
+{
+    /* The message is consumed from the raw buffer, which can be reused */
+    g_byte_array_append (raw, data, data_size);
+    return qmi_message_new_from_raw (raw, error);
+}
+
+static void
+test_encode (TestCase          *test,
+             QmiMessageContext *context)
+{
+    QmiMessage  *message;
+    QmiMessage **messages;
+    gchar       *printable;
+    GError      *error = NULL;
+    guint        i;
+
+    message = test->sample->request_new (1, &error);
+    g_assert_no_error (error);
+    g_assert (message);
+    g_assert_cmpuint (qmi_message_get_message_id (message), ==, test->sample->message_id);
+
+    printable = qmi_message_get_printable_full (message, context, "");
+    g_assert (printable);
+    g_free (printable);
+    qmi_message_unref (message);
+
+    if (g_test_perf ()) {
+        messages = g_new (QmiMessage *, BENCHMARK_ITERATIONS);
+        benchmark_start ();
+        for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+            messages[i] = test->sample->request_new (1, NULL);
+        benchmark_stop (test->path, "encode");
+        for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+            qmi_message_unref (messages[i]);
+        g_free (messages);
+    }
+}
+
+static void
+test_decode (TestCase          *test,
+             QmiMessageContext *context)
+{
+    GByteArray  *raw;
+    QmiMessage  *message;
+    QmiMessage **messages;
+    gchar       *printable;
+    GError      *error = NULL;
+    guint        i;
+
+    raw = g_byte_array_sized_new (test->sample->output_size);
+
+    message = sample_message_new (raw, test->sample->output, test->sample->output_size, &error);
+    g_assert_no_error (error);
+    g_assert (message);
+    g_assert_cmpuint (raw->len, ==, 0);
+
+    if (test->sample->output_read) {
+        g_assert (test->sample->output_read (message, &error));
+        g_assert_no_error (error);
+    }
+
+    if (g_test_perf ()) {
+        messages = g_new (QmiMessage *, BENCHMARK_ITERATIONS);
+        benchmark_start ();
+        for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            messages[i] = sample_message_new (raw, test->sample->output, test->sample->output_size, NULL);
+            if (test->sample->output_read)
+                test->sample->output_read (messages[i], NULL);
+        }
+        benchmark_stop (test->path, "decode");
+        benchmark_start ();
+        for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+            qmi_message_unref (messages[i]);
+        benchmark_stop (test->path, "free");
+        g_free (messages);
+    }
+
+    printable = qmi_message_get_printable_full (message, context, "");
+    g_assert (printable);
+    g_free (printable);
+
+    if (g_test_perf ()) {
+        benchmark_start ();
+        for (i = 0; i < BENCHMARK_ITERATIONS; i++)
+            g_free (qmi_message_get_printable_full (message, context, ""));
+        benchmark_stop (test->path, "printable");
+    }
+
+    qmi_message_unref (message);
+    g_byte_array_unref (raw);
+}
+
+static void
+test_fuzz (TestCase          *test,
+           QmiMessageContext *context)
+{
+    GByteArray *raw;
+    guint8     *data;
+    gsize       header_size;
+    guint       i;
+
+    /* Marker, QMUX header and QMI header are left untouched */
+    header_size = 1 + 5 + (test->sample->service == QMI_SERVICE_CTL ? 6 : 7);
+    if (test->sample->output_size <= header_size)
+        return;
+
+    raw = g_byte_array_sized_new (test->sample->output_size);
+    data = g_malloc (test->sample->output_size);
+    for (i = 0; i < FUZZ_ITERATIONS; i++) {
+        QmiMessage *message;
+        GError     *error = NULL;
+        guint       n_mutations;
+
+        memcpy (data, test->sample->output, test->sample->output_size);
+        for (n_mutations = g_test_rand_int_range (1, 5); n_mutations > 0; n_mutations--)
+            data[g_test_rand_int_range ((gint32) header_size, (gint32) test->sample->output_size)] = (guint8) g_test_rand_int ();
+
+        /* Messages failing the basic checks are just discarded */
+        message = sample_message_new (raw, data, test->sample->output_size, &error);
+        if (!message) {
+            g_clear_error (&error);
+            g_byte_array_set_size (raw, 0);
+            continue;
+        }
+
+        /* Mutated TLVs may or may not be readable, just don't crash */
+        if (test->sample->output_read) {
+            test->sample->output_read (message, &error);
+            g_clear_error (&error);
+        }
+
+        g_free (qmi_message_get_printable_full (message, context, ""));
+        qmi_message_unref (message);
+    }
+    g_free (data);
+    g_byte_array_unref (raw);
+}
+
+static void
+test_sample (gconstpointer data)
+{
+    TestCase          *test = (TestCase *) data;
+    QmiMessageContext *context;
+
+    context = qmi_message_context_new ();
+    qmi_message_context_set_vendor_id (context, test->sample->vendor_id);
+
+    if (!test->sample->indication)
+        test_encode (test, context);
+    test_decode (test, context);
+    test_fuzz (test, context);
+
+    qmi_message_context_unref (context);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    GPtrArray *tests;
+    guint      i;
+    gint       result;
+
+    g_test_init (&argc, &argv, NULL);
+
+    tests = g_ptr_array_new_with_free_func ((GDestroyNotify) test_case_free);
+    for (i = 0; i < G_N_ELEMENTS (services); i++) {
+        const TestMessageSample *sample;
+
+        for (sample = services[i].samples; sample->name; sample++) {
+            TestCase *test;
+
+            test = g_slice_new (TestCase);
+            test->service = &services[i];
+            test->sample = sample;
+            test->path = g_strdup_printf ("/libqmi-glib/benchmark/%s/%s/%s",
+                                          services[i].name,
+                                          sample->indication ? "indication" : "message",
+                                          sample->name);
+            g_test_add_data_func (test->path, test, test_sample);
+            g_ptr_array_add (tests, test);
+        }
+    }
+
+    result = g_test_run ();
+
+    g_ptr_array_unref (tests);
+    return result;
+}
@@ -17,6 +17,7 @@
 #include <libqmi-glib.h>
 
 #include "test-fixture.h"
+#include "test-alloc-counter.h"
 
 /*****************************************************************************/
 
@@ -103,6 +104,182 @@ test_generated_dms_get_ids (TestFixture *fixture)
     test_fixture_loop_run (fixture);
 }
 
+/* Requests run in each batch once the transaction pool has been filled */
+#define DMS_GET_IDS_STEADY_STATE_REQUESTS 16
+
+static guint
+dms_get_ids_batch (TestFixture *fixture,
+                   gdouble     *elapsed)
+{
+    guint i;
+
+    /* Measures the end-to-end latency from the request until the callback
+     * is run, including the round-trip through the virtual port */
+    test_alloc_counter_start ();
+    g_test_timer_start ();
+    for (i = 0; i < DMS_GET_IDS_STEADY_STATE_REQUESTS; i++)
+        test_generated_dms_get_ids (fixture);
+    *elapsed = g_test_timer_elapsed ();
+    return test_alloc_counter_stop ();
+}
+
+static void
+test_generated_dms_get_ids_repeated (TestFixture *fixture)
+{
+    guint cold;
+    guint steady;
+    guint steady_next;
+    gdouble elapsed;
+
+    test_alloc_counter_start ();
+    test_generated_dms_get_ids (fixture);
+    cold = test_alloc_counter_stop ();
+
+    steady = dms_get_ids_batch (fixture, &elapsed);
+    g_test_minimized_result (elapsed * 1e9 / DMS_GET_IDS_STEADY_STATE_REQUESTS, "ns/request in steady state");
+
+    if (!test_alloc_counter_supported ())
+        return;
+
+    g_test_minimized_result (cold, "allocs in first request");
+    g_test_minimized_result ((gdouble) steady / DMS_GET_IDS_STEADY_STATE_REQUESTS, "allocs/request in steady state");
+
+    /* Requests are run one after the other, so once the first one has
+     * completed every new transaction is taken from the pool: a request never
+     * needs more allocations than the first one did, and the count doesn't
+     * grow from one batch to the next */
+    g_assert_cmpuint (steady, <=, cold * DMS_GET_IDS_STEADY_STATE_REQUESTS);
+    steady_next = dms_get_ids_batch (fixture, &elapsed);
+    g_assert_cmpuint (steady_next, <=, steady);
+}
+
+/* Matched transactions are reported once all the input is processed, so a
+ * transaction may stay queued with its response while the callback of a
+ * previous one runs. The timeout of the queued one must not fire then. */
+
+typedef struct {
+    TestFixture *fixture;
+    gboolean     first_reported;
+    gboolean     second_reported;
+} MatchedTimeoutContext;
+
+static void
+dms_get_ids_matched_timeout_check (QmiClientDms *client,
+                                   GAsyncResult *res)
+{
+    QmiMessageDmsGetIdsOutput *output;
+    GError *error = NULL;
+    gboolean st;
+
+    output = qmi_client_dms_get_ids_finish (client, res, &error);
+    g_assert_no_error (error);
+    g_assert (output);
+
+    st = qmi_message_dms_get_ids_output_get_result (output, &error);
+    g_assert_no_error (error);
+    g_assert (st);
+
+    qmi_message_dms_get_ids_output_unref (output);
+}
+
+static gboolean
+nested_loop_quit (GMainLoop *loop)
+{
+    g_main_loop_quit (loop);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+dms_get_ids_matched_timeout_second_ready (QmiClientDms          *client,
+                                          GAsyncResult          *res,
+                                          MatchedTimeoutContext *ctx)
+{
+    GMainLoop *loop;
+
+    dms_get_ids_matched_timeout_check (client, res);
+    g_assert (!ctx->first_reported);
+    ctx->second_reported = TRUE;
+
+    /* Keep on running the main loop for longer than the timeout of the
+     * first request, whose response is already queued */
+    loop = g_main_loop_new (g_main_context_get_thread_default (), FALSE);
+    g_timeout_add_seconds (2, (GSourceFunc) nested_loop_quit, loop);
+    g_main_loop_run (loop);
+    g_main_loop_unref (loop);
+
+    g_assert (!ctx->first_reported);
+}
+
+static void
+dms_get_ids_matched_timeout_first_ready (QmiClientDms          *client,
+                                         GAsyncResult          *res,
+                                         MatchedTimeoutContext *ctx)
+{
+    dms_get_ids_matched_timeout_check (client, res);
+    g_assert (ctx->second_reported);
+    ctx->first_reported = TRUE;
+
+    test_fixture_loop_stop (ctx->fixture);
+}
+
+static void
+test_generated_dms_get_ids_matched_timeout (TestFixture *fixture)
+{
+    guint8 expected[] = {
+        0x01,
+        0x0C, 0x00, 0x00, 0x02, 0x01,
+        0x00, 0xFF, 0xFF, 0x25, 0x00, 0x00, 0x00
+    };
+    guint8 response[] = {
+        0x01,
+        0x45, 0x00, 0x80, 0x02, 0x01,
+        0x02, 0xFF, 0xFF, 0x25, 0x00, 0x39, 0x00, 0x02,
+        0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x01,
+        0x00, 0x42, 0x12, 0x0E, 0x00, 0x33, 0x35, 0x39,
+        0x32, 0x32, 0x35, 0x30, 0x35, 0x30, 0x30, 0x33,
+        0x39, 0x39, 0x37, 0x10, 0x08, 0x00, 0x38, 0x30,
+        0x39, 0x39, 0x37, 0x38, 0x37, 0x34, 0x11, 0x0F,
+        0x00, 0x33, 0x35, 0x39, 0x32, 0x32, 0x35, 0x30,
+        0x35, 0x30, 0x30, 0x33, 0x39, 0x39, 0x37, 0x33
+    };
+    MatchedTimeoutContext  ctx = { fixture, FALSE, FALSE };
+    GByteArray            *responses;
+    guint16                first_transaction_id;
+    guint16                second_transaction_id;
+
+    first_transaction_id = fixture->service_info[QMI_SERVICE_DMS].transaction_id++;
+    second_transaction_id = fixture->service_info[QMI_SERVICE_DMS].transaction_id++;
+
+    /* The first request isn't replied until the second one is received, and
+     * then both responses are sent at once, the second one first */
+    responses = g_byte_array_sized_new (2 * G_N_ELEMENTS (response));
+    response[7] = first_transaction_id & 0xFF;
+    response[8] = (first_transaction_id >> 8) & 0xFF;
+    g_byte_array_append (responses, response, G_N_ELEMENTS (response));
+    g_byte_array_prepend (responses, response, G_N_ELEMENTS (response));
+
+    test_port_context_set_command (fixture->ctx,
+                                   expected, G_N_ELEMENTS (expected),
+                                   NULL, 0,
+                                   first_transaction_id);
+    test_port_context_set_command (fixture->ctx,
+                                   expected, G_N_ELEMENTS (expected),
+                                   responses->data, responses->len,
+                                   second_transaction_id);
+    g_byte_array_unref (responses);
+
+    qmi_client_dms_get_ids (QMI_CLIENT_DMS (fixture->service_info[QMI_SERVICE_DMS].client), NULL, 1, NULL,
+                            (GAsyncReadyCallback) dms_get_ids_matched_timeout_first_ready,
+                            &ctx);
+    qmi_client_dms_get_ids (QMI_CLIENT_DMS (fixture->service_info[QMI_SERVICE_DMS].client), NULL, 10, NULL,
+                            (GAsyncReadyCallback) dms_get_ids_matched_timeout_second_ready,
+                            &ctx);
+    test_fixture_loop_run (fixture);
+
+    g_assert (ctx.first_reported);
+    g_assert (ctx.second_reported);
+}
+
 /*****************************************************************************/
 /* DMS UIM Get PIN Status */
 
@@ -521,6 +698,72 @@ nas_network_scan_ready (QmiClientNas *client,
     test_fixture_loop_stop (fixture);
 }
 
+static void
+nas_network_scan_foreach_network_information (const QmiMessageNasNetworkScanOutputNetworkInformationElement *el,
+                                              guint                                                         *i)
+{
+    g_assert_cmpuint (*i, <, G_N_ELEMENTS (scan_results));
+    g_assert_cmpuint (el->mcc, ==, scan_results[*i].mcc);
+    g_assert_cmpuint (el->mnc, ==, scan_results[*i].mnc);
+    g_assert_cmpuint (el->network_status, ==, scan_results[*i].network_status);
+    g_assert_cmpstr  (el->description, ==, scan_results[*i].description);
+    (*i)++;
+}
+
+static void
+nas_network_scan_foreach_radio_access_technology (const QmiMessageNasNetworkScanOutputRadioAccessTechnologyElement *el,
+                                                  guint                                                             *i)
+{
+    g_assert_cmpuint (*i, <, G_N_ELEMENTS (scan_results));
+    g_assert_cmpuint (el->mcc, ==, scan_results[*i].mcc);
+    g_assert_cmpuint (el->mnc, ==, scan_results[*i].mnc);
+    g_assert_cmpuint (el->radio_interface, ==, scan_results[*i].rat);
+    (*i)++;
+}
+
+static void
+nas_network_scan_foreach_ready (QmiClientNas *client,
+                                GAsyncResult *res,
+                                TestFixture  *fixture)
+{
+    QmiMessageNasNetworkScanOutput *output;
+    GError *error = NULL;
+    gboolean st;
+    guint i;
+
+    output = qmi_client_nas_network_scan_finish (client, res, &error);
+    g_assert_no_error (error);
+    g_assert (output);
+
+    st = qmi_message_nas_network_scan_output_get_result (output, &error);
+    g_assert_no_error (error);
+    g_assert (st);
+
+    i = 0;
+    st = (qmi_message_nas_network_scan_output_foreach_network_information (
+              output,
+              (QmiMessageNasNetworkScanOutputNetworkInformationForeachFn) nas_network_scan_foreach_network_information,
+              &i,
+              &error));
+    g_assert_no_error (error);
+    g_assert (st);
+    g_assert_cmpuint (i, ==, 8);
+
+    i = 0;
+    st = (qmi_message_nas_network_scan_output_foreach_radio_access_technology (
+              output,
+              (QmiMessageNasNetworkScanOutputRadioAccessTechnologyForeachFn) nas_network_scan_foreach_radio_access_technology,
+              &i,
+              &error));
+    g_assert_no_error (error);
+    g_assert (st);
+    g_assert_cmpuint (i, ==, 8);
+
+    qmi_message_nas_network_scan_output_unref (output);
+
+    test_fixture_loop_stop (fixture);
+}
+
 static void
 nas_get_cell_location_info_ready (QmiClientNas *client,
                                   GAsyncResult *res,
@@ -544,7 +787,8 @@ nas_get_cell_location_info_ready (QmiClientNas *client,
 }
 
 static void
-test_generated_nas_network_scan (TestFixture *fixture)
+common_test_generated_nas_network_scan (TestFixture         *fixture,
+                                        GAsyncReadyCallback  callback)
 {
     guint8 expected[] = {
         0x01,
@@ -602,12 +846,24 @@ test_generated_nas_network_scan (TestFixture *fixture)
                                    fixture->service_info[QMI_SERVICE_NAS].transaction_id++);
 
     qmi_client_nas_network_scan (QMI_CLIENT_NAS (fixture->service_info[QMI_SERVICE_NAS].client), NULL, 3, NULL,
-                                 (GAsyncReadyCallback) nas_network_scan_ready,
+                                 callback,
                                  fixture);
 
     test_fixture_loop_run (fixture);
 }
 
+static void
+test_generated_nas_network_scan (TestFixture *fixture)
+{
+    common_test_generated_nas_network_scan (fixture, (GAsyncReadyCallback) nas_network_scan_ready);
+}
+
+static void
+test_generated_nas_network_scan_foreach (TestFixture *fixture)
+{
+    common_test_generated_nas_network_scan (fixture, (GAsyncReadyCallback) nas_network_scan_foreach_ready);
+}
+
 static void
 test_generated_nas_get_cell_location_info (TestFixture *fixture)
 {
@@ -655,11 +911,14 @@ int main (int argc, char **argv)
 
     /* DMS */
     TEST_ADD ("/libqmi-glib/generated/dms/get-ids",                test_generated_dms_get_ids);
+    TEST_ADD ("/libqmi-glib/generated/dms/get-ids-repeated",       test_generated_dms_get_ids_repeated);
+    TEST_ADD ("/libqmi-glib/generated/dms/get-ids-matched-timeout", test_generated_dms_get_ids_matched_timeout);
     TEST_ADD ("/libqmi-glib/generated/dms/uim-get-pin-status",     test_generated_dms_uim_get_pin_status);
     TEST_ADD ("/libqmi-glib/generated/dms/uim-verify-pin",         test_generated_dms_uim_verify_pin);
     TEST_ADD ("/libqmi-glib/generated/dms/get-time",               test_generated_dms_get_time);
     /* NAS */
     TEST_ADD ("/libqmi-glib/generated/nas/network-scan",           test_generated_nas_network_scan);
+    TEST_ADD ("/libqmi-glib/generated/nas/network-scan-foreach",   test_generated_nas_network_scan_foreach);
     TEST_ADD ("/libqmi-glib/generated/nas/get-cell-location-info", test_generated_nas_get_cell_location_info);
 
     return g_test_run ();
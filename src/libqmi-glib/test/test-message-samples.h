@@ -0,0 +1,60 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef TEST_MESSAGE_SAMPLES_H
+#define TEST_MESSAGE_SAMPLES_H
+
+#include <glib.h>
+#include <libqmi-glib.h>
+
+/* Sample of a single message or indication, as generated by qmi-codegen with
+ * --output-samples. Samples only use the public QMI message API: requests are
+ * built with qmi_message_new() and the TLV writers, and the raw response or
+ * indication is read back with the TLV readers. The request builder is NULL
+ * for indications, and the output reader is NULL if the response or
+ * indication has no TLVs to read. */
+typedef struct {
+    const gchar    *name;
+    QmiService      service;
+    guint16         message_id;
+    guint16         vendor_id;
+    gboolean        indication;
+    QmiMessage   * (* request_new) (guint16   transaction_id,
+                                    GError  **error);
+    const guint8   *output;
+    gsize           output_size;
+    gboolean       (* output_read) (QmiMessage  *message,
+                                    GError     **error);
+} TestMessageSample;
+
+/* Sample tables, each one finished with a NULL name */
+extern const TestMessageSample test_message_samples_ctl[];
+extern const TestMessageSample test_message_samples_dms[];
+extern const TestMessageSample test_message_samples_nas[];
+extern const TestMessageSample test_message_samples_wds[];
+extern const TestMessageSample test_message_samples_wms[];
+extern const TestMessageSample test_message_samples_pds[];
+extern const TestMessageSample test_message_samples_pdc[];
+extern const TestMessageSample test_message_samples_pbm[];
+extern const TestMessageSample test_message_samples_uim[];
+extern const TestMessageSample test_message_samples_oma[];
+extern const TestMessageSample test_message_samples_wda[];
+extern const TestMessageSample test_message_samples_voice[];
+extern const TestMessageSample test_message_samples_loc[];
+extern const TestMessageSample test_message_samples_qos[];
+extern const TestMessageSample test_message_samples_gas[];
+extern const TestMessageSample test_message_samples_dsd[];
+
+#endif /* TEST_MESSAGE_SAMPLES_H */
@@ -466,6 +466,48 @@ test_message_tlv_write_reset (void)
     qmi_message_unref (self);
 }
 
+static void
+test_message_add_raw_tlv_many (void)
+{
+    QmiMessage *self;
+    QmiMessage *parsed;
+    GByteArray *raw;
+    GError *error = NULL;
+    const guint8 *buffer;
+    gsize buffer_length = 0;
+    gboolean ret;
+    guint i;
+
+    self = qmi_message_new (QMI_SERVICE_DMS, 0x01, 0x02, 0xFFFF);
+
+    /* Lengths are updated incrementally on every append */
+    for (i = 0; i < 200; i++) {
+        guint8 value[4] = { i, i + 1, i + 2, i + 3 };
+
+        ret = qmi_message_add_raw_tlv (self, (guint8)(0x10 + (i % 0x20)), value, sizeof (value), &error);
+        g_assert_no_error (error);
+        g_assert (ret);
+    }
+
+    /* length = qmux marker (1) + qmux header (5) + qmi header (7) + 200 TLVs (3 + 4) */
+    g_assert_cmpuint (qmi_message_get_length (self), ==, 13 + 200 * 7);
+
+    /* The built message must pass the full validation */
+    buffer = qmi_message_get_raw (self, &buffer_length, &error);
+    g_assert_no_error (error);
+    raw = g_byte_array_sized_new (buffer_length);
+    g_byte_array_append (raw, buffer, buffer_length);
+    parsed = qmi_message_new_from_raw (raw, &error);
+    g_assert_no_error (error);
+    g_assert (parsed);
+    g_assert_cmpuint (raw->len, ==, 0);
+    g_assert_cmpuint (qmi_message_get_length (parsed), ==, qmi_message_get_length (self));
+
+    g_byte_array_unref (raw);
+    qmi_message_unref (parsed);
+    qmi_message_unref (self);
+}
+
 static void
 test_message_tlv_rw_8 (void)
 {
@@ -1573,6 +1615,7 @@ int main (int argc, char **argv)
 
     g_test_add_func ("/libqmi-glib/message/tlv-write/empty",           test_message_tlv_write_empty);
     g_test_add_func ("/libqmi-glib/message/tlv-write/reset",           test_message_tlv_write_reset);
+    g_test_add_func ("/libqmi-glib/message/tlv-write/raw-many",        test_message_add_raw_tlv_many);
     g_test_add_func ("/libqmi-glib/message/tlv-rw/8",                  test_message_tlv_rw_8);
     g_test_add_func ("/libqmi-glib/message/tlv-rw/16",                 test_message_tlv_rw_16);
     g_test_add_func ("/libqmi-glib/message/tlv-rw/32",                 test_message_tlv_rw_32);
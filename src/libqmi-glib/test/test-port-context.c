@@ -38,9 +38,21 @@ struct _TestPortContext {
     GSocketService *socket_service;
     GList *clients;
     GMutex command_mutex;
+    GQueue commands;
+};
+
+typedef struct {
     GByteArray *command;
     GByteArray *response;
-};
+} Command;
+
+static void
+command_free (Command *command)
+{
+    g_byte_array_unref (command->command);
+    g_byte_array_unref (command->response);
+    g_slice_free (Command, command);
+}
 
 /*****************************************************************************/
 /* Helpers */
@@ -89,16 +101,21 @@ test_port_context_set_command (TestPortContext *ctx,
                                gsize            response_size,
                                guint16          transaction_id)
 {
+    Command *cmd;
+
+    cmd = g_slice_new (Command);
+    cmd->command = g_byte_array_append (g_byte_array_sized_new (command_size), command, command_size);
+    qmi_message_set_transaction_id ((QmiMessage *)cmd->command, transaction_id);
+
+    /* An empty response means the command is not replied; the response may
+     * also contain several messages, the first one being the actual reply */
+    cmd->response = g_byte_array_append (g_byte_array_sized_new (response_size), response, response_size);
+    if (response_size > 0)
+        qmi_message_set_transaction_id ((QmiMessage *)cmd->response, transaction_id);
+
+    /* Commands are expected in the same order as they're set */
     g_mutex_lock (&ctx->command_mutex);
-    {
-        g_assert (!ctx->command);
-        ctx->command = g_byte_array_append (g_byte_array_sized_new (command_size), command, command_size);
-        qmi_message_set_transaction_id ((QmiMessage *)ctx->command, transaction_id);
-
-        g_assert (!ctx->response);
-        ctx->response = g_byte_array_append (g_byte_array_sized_new (response_size), response, response_size);
-        qmi_message_set_transaction_id ((QmiMessage *)ctx->response, transaction_id);
-    }
+    g_queue_push_tail (&ctx->commands, cmd);
     g_mutex_unlock (&ctx->command_mutex);
 }
 
@@ -112,6 +129,7 @@ process_next_command (TestPortContext *ctx,
     gsize         message_raw_length;
     gchar        *expected;
     gchar        *received;
+    Command      *cmd;
     GByteArray   *response;
 
     /* Every message received must start with the QMUX marker.
@@ -138,27 +156,20 @@ process_next_command (TestPortContext *ctx,
     /* Get printables to compare (we'll just get a nicer error if they are
      * different), compared to a simple memcmp(). */
     g_mutex_lock (&ctx->command_mutex);
-    {
-        g_assert (ctx->command);
-        expected = str_hex (ctx->command->data, ctx->command->len, ':');
-    }
+    cmd = g_queue_pop_head (&ctx->commands);
     g_mutex_unlock (&ctx->command_mutex);
 
+    g_assert (cmd);
+    expected = str_hex (cmd->command->data, cmd->command->len, ':');
     received = str_hex (message_raw, message_raw_length, ':');
     g_assert_cmpstr (expected, ==, received);
     g_free (expected);
     g_free (received);
     qmi_message_unref (message);
-    g_byte_array_unref (ctx->command);
-    ctx->command = NULL;
 
     /* Command Expected == Received, so now return the Response */
-    g_mutex_lock (&ctx->command_mutex);
-    {
-        response = ctx->response;
-        ctx->response = NULL;
-    }
-    g_mutex_unlock (&ctx->command_mutex);
+    response = g_byte_array_ref (cmd->response);
+    command_free (cmd);
 
     return response;
 }
@@ -421,10 +432,8 @@ test_port_context_free (TestPortContext *ctx)
         g_object_unref (ctx->socket_service);
     }
     g_free (ctx->name);
-    if (ctx->command)
-        g_byte_array_unref (ctx->command);
-    if (ctx->response)
-        g_byte_array_unref (ctx->response);
+    g_queue_foreach (&ctx->commands, (GFunc)command_free, NULL);
+    g_queue_clear (&ctx->commands);
     g_slice_free (TestPortContext, ctx);
 }
 
@@ -438,5 +447,6 @@ test_port_context_new (const gchar *name)
     g_cond_init (&ctx->ready_cond);
     g_mutex_init (&ctx->ready_mutex);
     g_mutex_init (&ctx->command_mutex);
+    g_queue_init (&ctx->commands);
     return ctx;
 }
@@ -66,140 +66,6 @@ struct _QfuQdlDevicePrivate {
 /* HDLC */
 
 #define CONTROL 0x7e
-#define ESCAPE  0x7d
-#define MASK    0x20
-
-static gsize
-escape (const guint8 *in,
-        gsize         inlen,
-        guint8       *out,
-        gsize         outlen)
-{
-    gsize i, j;
-
-    for (i = 0, j = 0; i < inlen; i++) {
-        /* Caller should give a big enough buffer */
-        g_assert ((j + 1) < outlen);
-        if (in[i] == CONTROL || in[i] == ESCAPE) {
-            out[j++] = ESCAPE;
-            out[j++] = in[i] ^ MASK;
-        } else
-            out[j++] = in[i];
-    }
-    return j;
-}
-
-static gsize
-unescape (const guint8 *in,
-          gsize         inlen,
-          guint8       *out,
-          gsize         outlen)
-{
-    gsize    i, j = 0;
-    gboolean escaping = FALSE;
-
-    for (i = 0; i < inlen; i++) {
-        /* Caller should give a big enough buffer */
-        g_assert (j < outlen);
-        if (escaping) {
-            out[j++] = in[i] ^ MASK;
-            escaping = FALSE;
-        } else if (in[i] == ESCAPE) {
-            escaping = TRUE;
-        } else {
-            out[j++] = in[i];
-        }
-    }
-
-    return j;
-}
-
-/* copy a possibly escaped single byte to out */
-static gsize
-escape_byte (guint8  byte,
-             guint8 *out,
-             gsize   outlen)
-{
-    gsize j = 0;
-
-    if (byte == CONTROL || byte == ESCAPE) {
-        out[j++] = ESCAPE;
-        byte ^= MASK;
-    }
-    out[j++] = byte;
-    return j;
-}
-
-static gsize
-hdlc_max_framed_size (gsize unframed_size)
-{
-    /* 1 header byte, (2 * input size) bytes, 2 crc bytes and 1 trailing byte */
-    return 4 + (2 * unframed_size);
-}
-
-static gsize
-hdlc_frame (const guint8 *in,
-            gsize         inlen,
-            guint8       *out,
-            gsize         outlen)
-{
-    guint16 crc;
-    gsize j = 0;
-
-    out[j++] = CONTROL;
-    j += escape (in, inlen, &out[j], outlen - j);
-    crc = qfu_utils_crc16 (in, inlen);
-    j += escape_byte (crc & 0xff, &out[j], outlen - j);
-    j += escape_byte (crc >> 8 & 0xff, &out[j], outlen - j);
-    out[j++] = CONTROL;
-
-    return j;
-}
-
-static gsize
-hdlc_max_unframed_size (gsize framed_size)
-{
-    /* -1 header byte, -2 crc bytes and -1 trailing byte */
-    g_assert (framed_size > 3);
-    return framed_size - 3;
-}
-
-static gsize
-hdlc_unframe (const guint8 *in,
-              gsize         inlen,
-              guint8       *out,
-              gsize         outlen,
-              GError      **error)
-{
-    guint16 crc;
-    gsize j, i = inlen;
-
-    /* the first control char is optional */
-    if (*in == CONTROL) {
-        in++;
-        i--;
-    }
-    if (in[i - 1] == CONTROL)
-        i--;
-
-    j = unescape (in, i, out, outlen);
-    if (j < 2) {
-        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
-                     "unescaping failed: too few bytes as output: %" G_GSIZE_FORMAT, j);
-        return 0;
-    }
-    j -= 2; /* remove the crc */
-
-    /* verify the crc */
-    crc = qfu_utils_crc16 (out, j);
-    if (crc != (out[j] | out[j + 1] << 8)) {
-        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
-                     "crc check failed: 0x%04x != 0x%04x\n", crc, out[j] | out[j + 1] << 8);
-        return 0;
-    }
-
-    return j;
-}
 
 /******************************************************************************/
 /* Send */
@@ -302,12 +168,12 @@ send_framed_request (QfuQdlDevice  *self,
         g_free (printable);
     }
 
-    max_framed_size = hdlc_max_framed_size (request_size);
+    max_framed_size = qfu_utils_hdlc_max_framed_size (request_size);
     if (G_UNLIKELY (max_framed_size > self->priv->secondary_buffer->len))
         g_byte_array_set_size (self->priv->secondary_buffer, max_framed_size);
 
     /* Pack into an HDLC frame */
-    framed_size = hdlc_frame (request, request_size, self->priv->secondary_buffer->data, self->priv->secondary_buffer->len);
+    framed_size = qfu_utils_hdlc_frame (request, request_size, self->priv->secondary_buffer->data, self->priv->secondary_buffer->len);
     g_assert (framed_size > 0);
 
     return send_request (self, self->priv->secondary_buffer->data, framed_size, cancellable, error);
@@ -407,11 +273,11 @@ receive_response (QfuQdlDevice  *self,
         g_debug ("[qfu-qdl-device] received %" G_GSSIZE_FORMAT " trailing bytes after HDLC frame (ignored)",
                  rlen - frame_size);
 
-    max_unframed_size = hdlc_max_unframed_size (frame_size);
+    max_unframed_size = qfu_utils_hdlc_max_unframed_size (frame_size);
     if (G_UNLIKELY (max_unframed_size > self->priv->secondary_buffer->len))
         g_byte_array_set_size (self->priv->secondary_buffer, max_unframed_size);
 
-    unframed_size = hdlc_unframe (self->priv->buffer->data, (gsize)frame_size, self->priv->secondary_buffer->data, self->priv->secondary_buffer->len, error);
+    unframed_size = qfu_utils_hdlc_unframe (self->priv->buffer->data, (gsize)frame_size, self->priv->secondary_buffer->data, self->priv->secondary_buffer->len, error);
     if (unframed_size == 0) {
         g_prefix_error (error, "error unframing message: ");
         return -1;
@@ -155,6 +155,30 @@ static const guint16 crc_table[256] = {
     0x7bc7, 0x6a4e, 0x58d5, 0x495c, 0x3de3, 0x2c6a, 0x1ef1, 0x0f78
 };
 
+/* Slicing-by-8 tables: crc_slices[0] is crc_table, and crc_slices[k] gives
+ * the CRC of a byte followed by k zero bytes, so that 8 input bytes can be
+ * folded into the CRC with 8 independent lookups */
+static guint16 crc_slices[8][256];
+
+static void
+crc_slices_init (void)
+{
+    static gsize initialized = 0;
+    guint        i, k;
+
+    if (!g_once_init_enter (&initialized))
+        return;
+
+    for (i = 0; i < 256; i++)
+        crc_slices[0][i] = crc_table[i];
+    for (k = 1; k < 8; k++) {
+        for (i = 0; i < 256; i++)
+            crc_slices[k][i] = (crc_slices[k - 1][i] >> 8) ^ crc_table[crc_slices[k - 1][i] & 0xff];
+    }
+
+    g_once_init_leave (&initialized, 1);
+}
+
 /* Calculate the CRC for a buffer using a seed of 0xffff */
 guint16
 qfu_utils_crc16 (const guint8 *buffer,
@@ -162,11 +186,214 @@ qfu_utils_crc16 (const guint8 *buffer,
 {
     guint16 crc = 0xffff;
 
+    crc_slices_init ();
+
+    while (len >= 8) {
+        crc = crc_slices[7][(buffer[0] ^ crc) & 0xff] ^
+              crc_slices[6][(buffer[1] ^ (crc >> 8)) & 0xff] ^
+              crc_slices[5][buffer[2]] ^
+              crc_slices[4][buffer[3]] ^
+              crc_slices[3][buffer[4]] ^
+              crc_slices[2][buffer[5]] ^
+              crc_slices[1][buffer[6]] ^
+              crc_slices[0][buffer[7]];
+        buffer += 8;
+        len -= 8;
+    }
+
     while (len--)
             crc = crc_table[(crc ^ *buffer++) & 0xff] ^ (crc >> 8);
     return ~crc;
 }
 
+/******************************************************************************/
+/* HDLC */
+
+#define CONTROL 0x7e
+#define ESCAPE  0x7d
+#define MASK    0x20
+
+/* Word-at-a-time check for a byte equal to 'byte' in 'word' */
+#define ONES                  G_GUINT64_CONSTANT (0x0101010101010101)
+#define HIGHS                 G_GUINT64_CONSTANT (0x8080808080808080)
+#define HAS_ZERO_BYTE(word)   (((word) - ONES) & ~(word) & HIGHS)
+#define HAS_BYTE(word, byte)  HAS_ZERO_BYTE ((word) ^ (ONES * (byte)))
+
+/* Length of the leading run of bytes that need no escaping */
+static gsize
+escape_clean_span (const guint8 *in,
+                   gsize         inlen)
+{
+    gsize i = 0;
+
+    while (i + 8 <= inlen) {
+        guint64 word;
+
+        memcpy (&word, &in[i], sizeof (word));
+        if (HAS_BYTE (word, CONTROL) || HAS_BYTE (word, ESCAPE))
+            break;
+        i += 8;
+    }
+
+    while (i < inlen && in[i] != CONTROL && in[i] != ESCAPE)
+        i++;
+    return i;
+}
+
+gsize
+qfu_utils_hdlc_escape (const guint8 *in,
+                       gsize         inlen,
+                       guint8       *out,
+                       gsize         outlen)
+{
+    gsize i = 0, j = 0;
+
+    while (i < inlen) {
+        gsize span;
+
+        /* Bulk copy the bytes that need no escaping */
+        span = escape_clean_span (&in[i], inlen - i);
+        if (span > 0) {
+            /* Caller should give a big enough buffer */
+            g_assert ((j + span) < outlen);
+            memcpy (&out[j], &in[i], span);
+            i += span;
+            j += span;
+            if (i == inlen)
+                break;
+        }
+
+        /* Caller should give a big enough buffer */
+        g_assert ((j + 1) < outlen);
+        out[j++] = ESCAPE;
+        out[j++] = in[i++] ^ MASK;
+    }
+    return j;
+}
+
+gsize
+qfu_utils_hdlc_unescape (const guint8 *in,
+                         gsize         inlen,
+                         guint8       *out,
+                         gsize         outlen)
+{
+    gsize i = 0, j = 0;
+
+    while (i < inlen) {
+        const guint8 *escape;
+        gsize         span;
+
+        /* Bulk copy everything up to the next escape character */
+        escape = memchr (&in[i], ESCAPE, inlen - i);
+        span = escape ? (gsize)(escape - &in[i]) : (inlen - i);
+        if (span > 0) {
+            /* Caller should give a big enough buffer */
+            g_assert ((j + span) <= outlen);
+            memcpy (&out[j], &in[i], span);
+            i += span;
+            j += span;
+        }
+
+        /* A trailing escape character is dropped */
+        if (!escape || ++i == inlen)
+            break;
+
+        /* Caller should give a big enough buffer */
+        g_assert (j < outlen);
+        out[j++] = in[i++] ^ MASK;
+    }
+
+    return j;
+}
+
+/* copy a possibly escaped single byte to out */
+static gsize
+escape_byte (guint8  byte,
+             guint8 *out,
+             gsize   outlen)
+{
+    gsize j = 0;
+
+    if (byte == CONTROL || byte == ESCAPE) {
+        out[j++] = ESCAPE;
+        byte ^= MASK;
+    }
+    out[j++] = byte;
+    return j;
+}
+
+gsize
+qfu_utils_hdlc_max_framed_size (gsize unframed_size)
+{
+    /* 1 header byte, (2 * input size) bytes, 2 crc bytes and 1 trailing byte */
+    return 4 + (2 * unframed_size);
+}
+
+gsize
+qfu_utils_hdlc_frame (const guint8 *in,
+                      gsize         inlen,
+                      guint8       *out,
+                      gsize         outlen)
+{
+    guint16 crc;
+    gsize j = 0;
+
+    out[j++] = CONTROL;
+    j += qfu_utils_hdlc_escape (in, inlen, &out[j], outlen - j);
+    crc = qfu_utils_crc16 (in, inlen);
+    j += escape_byte (crc & 0xff, &out[j], outlen - j);
+    j += escape_byte (crc >> 8 & 0xff, &out[j], outlen - j);
+    out[j++] = CONTROL;
+
+    return j;
+}
+
+gsize
+qfu_utils_hdlc_max_unframed_size (gsize framed_size)
+{
+    /* -1 header byte and -1 trailing byte; the crc bytes are unescaped
+     * along with the data, so room is needed for them as well */
+    g_assert (framed_size > 3);
+    return framed_size - 2;
+}
+
+gsize
+qfu_utils_hdlc_unframe (const guint8  *in,
+                        gsize          inlen,
+                        guint8        *out,
+                        gsize          outlen,
+                        GError       **error)
+{
+    guint16 crc;
+    gsize j, i = inlen;
+
+    /* the first control char is optional */
+    if (*in == CONTROL) {
+        in++;
+        i--;
+    }
+    if (in[i - 1] == CONTROL)
+        i--;
+
+    j = qfu_utils_hdlc_unescape (in, i, out, outlen);
+    if (j < 2) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                     "unescaping failed: too few bytes as output: %" G_GSIZE_FORMAT, j);
+        return 0;
+    }
+    j -= 2; /* remove the crc */
+
+    /* verify the crc */
+    crc = qfu_utils_crc16 (out, j);
+    if (crc != (out[j] | out[j + 1] << 8)) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                     "crc check failed: 0x%04x != 0x%04x\n", crc, out[j] | out[j + 1] << 8);
+        return 0;
+    }
+
+    return j;
+}
+
 /******************************************************************************/
 
 gboolean
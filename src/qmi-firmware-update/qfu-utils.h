@@ -40,6 +40,26 @@ gchar *qfu_utils_get_firmware_image_unique_id_printable (const GArray *unique_id
 guint16 qfu_utils_crc16 (const guint8 *buffer,
                          gsize         len);
 
+gsize qfu_utils_hdlc_escape            (const guint8  *in,
+                                        gsize          inlen,
+                                        guint8        *out,
+                                        gsize          outlen);
+gsize qfu_utils_hdlc_unescape          (const guint8  *in,
+                                        gsize          inlen,
+                                        guint8        *out,
+                                        gsize          outlen);
+gsize qfu_utils_hdlc_max_framed_size   (gsize          unframed_size);
+gsize qfu_utils_hdlc_frame             (const guint8  *in,
+                                        gsize          inlen,
+                                        guint8        *out,
+                                        gsize          outlen);
+gsize qfu_utils_hdlc_max_unframed_size (gsize          framed_size);
+gsize qfu_utils_hdlc_unframe           (const guint8  *in,
+                                        gsize          inlen,
+                                        guint8        *out,
+                                        gsize          outlen,
+                                        GError       **error);
+
 gboolean qfu_utils_parse_cwe_version_string (const gchar  *version,
                                              gchar       **firmware_version,
                                              gchar       **config_version,
@@ -19,6 +19,8 @@
  * Copyright (C) 2016 Aleksander Morgado <aleksander@aleksander.es>
  */
 
+#include <string.h>
+
 #include "qfu-utils.h"
 
 /******************************************************************************/
@@ -88,6 +90,255 @@ test_cwe_version_parser_mc7354b_spk (void)
                                 "GENNA-UMTS");
 }
 
+/******************************************************************************/
+/* CRC and HDLC kernels, checked against plain byte-at-a-time references */
+
+#define CONTROL 0x7e
+#define ESCAPE  0x7d
+#define MASK    0x20
+
+/* Largest buffer used in the exhaustive tests */
+#define MAX_TEST_SIZE 300
+
+/* Buffer size used in perf mode */
+#define PERF_SIZE (16 * 1024 * 1024)
+
+static guint16
+reference_crc16 (const guint8 *buffer,
+                 gsize         len)
+{
+    guint16 crc = 0xffff;
+    guint   bit;
+
+    while (len--) {
+        crc ^= *buffer++;
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+    }
+    return ~crc;
+}
+
+static gsize
+reference_escape (const guint8 *in,
+                  gsize         inlen,
+                  guint8       *out)
+{
+    gsize i, j;
+
+    for (i = 0, j = 0; i < inlen; i++) {
+        if (in[i] == CONTROL || in[i] == ESCAPE) {
+            out[j++] = ESCAPE;
+            out[j++] = in[i] ^ MASK;
+        } else
+            out[j++] = in[i];
+    }
+    return j;
+}
+
+static gsize
+reference_unescape (const guint8 *in,
+                    gsize         inlen,
+                    guint8       *out)
+{
+    gsize    i, j = 0;
+    gboolean escaping = FALSE;
+
+    for (i = 0; i < inlen; i++) {
+        if (escaping) {
+            out[j++] = in[i] ^ MASK;
+            escaping = FALSE;
+        } else if (in[i] == ESCAPE) {
+            escaping = TRUE;
+        } else {
+            out[j++] = in[i];
+        }
+    }
+    return j;
+}
+
+/* Random data where roughly 1 in 'density' bytes is a HDLC special char */
+static void
+fill_random (guint8 *buffer,
+             gsize   len,
+             guint   density)
+{
+    gsize i;
+
+    for (i = 0; i < len; i++) {
+        if (density > 0 && g_test_rand_int_range (0, density) == 0)
+            buffer[i] = g_test_rand_bit () ? CONTROL : ESCAPE;
+        else
+            buffer[i] = (guint8) g_test_rand_int_range (0, 256);
+    }
+}
+
+static void
+test_crc16 (void)
+{
+    static const guint8 check[] = "123456789";
+    guint8              buffer[MAX_TEST_SIZE + 8];
+    gsize               offset;
+    gsize               len;
+
+    /* CRC-16/X-25 check value */
+    g_assert_cmpuint (qfu_utils_crc16 (check, 9), ==, 0x906e);
+
+    /* Every length, at every alignment */
+    fill_random (buffer, sizeof (buffer), 0);
+    for (offset = 0; offset < 8; offset++) {
+        for (len = 0; len <= MAX_TEST_SIZE; len++)
+            g_assert_cmpuint (qfu_utils_crc16 (&buffer[offset], len), ==, reference_crc16 (&buffer[offset], len));
+    }
+
+    if (g_test_perf ()) {
+        guint8  *large;
+        gdouble  elapsed;
+
+        large = g_malloc (PERF_SIZE);
+        fill_random (large, PERF_SIZE, 0);
+        g_test_timer_start ();
+        qfu_utils_crc16 (large, PERF_SIZE);
+        elapsed = g_test_timer_elapsed ();
+        g_test_maximized_result (PERF_SIZE / elapsed / (1024 * 1024), "crc16: MB/s");
+        g_free (large);
+    }
+}
+
+static void
+test_hdlc_escape (void)
+{
+    static const guint densities[] = { 0, 1, 2, 8, 64 };
+    guint8              in[MAX_TEST_SIZE + 8];
+    guint8              out[2 * (MAX_TEST_SIZE + 8)];
+    guint8              expected[2 * (MAX_TEST_SIZE + 8)];
+    guint               d;
+    gsize               offset;
+    gsize               len;
+
+    /* Every single byte value */
+    for (len = 0; len < 256; len++) {
+        in[0] = (guint8) len;
+        g_assert_cmpuint (qfu_utils_hdlc_escape (in, 1, out, sizeof (out)), ==, reference_escape (in, 1, expected));
+        g_assert (memcmp (out, expected, (in[0] == CONTROL || in[0] == ESCAPE) ? 2 : 1) == 0);
+    }
+
+    /* Every length, at every alignment, with special chars being absent,
+     * rare, frequent or everywhere */
+    for (d = 0; d < G_N_ELEMENTS (densities); d++) {
+        fill_random (in, sizeof (in), densities[d]);
+        for (offset = 0; offset < 8; offset++) {
+            for (len = 0; len <= MAX_TEST_SIZE; len++) {
+                gsize out_len;
+                gsize expected_len;
+
+                expected_len = reference_escape (&in[offset], len, expected);
+                out_len = qfu_utils_hdlc_escape (&in[offset], len, out, sizeof (out));
+                g_assert_cmpuint (out_len, ==, expected_len);
+                g_assert (memcmp (out, expected, out_len) == 0);
+            }
+        }
+    }
+
+    if (g_test_perf ()) {
+        guint8  *large;
+        guint8  *escaped;
+        gdouble  elapsed;
+
+        large = g_malloc (PERF_SIZE);
+        escaped = g_malloc (2 * PERF_SIZE + 1);
+        fill_random (large, PERF_SIZE, 0);
+        g_test_timer_start ();
+        qfu_utils_hdlc_escape (large, PERF_SIZE, escaped, 2 * PERF_SIZE + 1);
+        elapsed = g_test_timer_elapsed ();
+        g_test_maximized_result (PERF_SIZE / elapsed / (1024 * 1024), "hdlc escape: MB/s");
+        g_free (escaped);
+        g_free (large);
+    }
+}
+
+static void
+test_hdlc_unescape (void)
+{
+    static const guint densities[] = { 0, 1, 2, 8, 64 };
+    guint8              in[MAX_TEST_SIZE + 8];
+    guint8              out[MAX_TEST_SIZE + 8];
+    guint8              expected[MAX_TEST_SIZE + 8];
+    guint               d;
+    gsize               offset;
+    gsize               len;
+
+    /* Every length, at every alignment; this includes arbitrary escape
+     * sequences and trailing escape chars */
+    for (d = 0; d < G_N_ELEMENTS (densities); d++) {
+        fill_random (in, sizeof (in), densities[d]);
+        for (offset = 0; offset < 8; offset++) {
+            for (len = 0; len <= MAX_TEST_SIZE; len++) {
+                gsize out_len;
+                gsize expected_len;
+
+                expected_len = reference_unescape (&in[offset], len, expected);
+                out_len = qfu_utils_hdlc_unescape (&in[offset], len, out, sizeof (out));
+                g_assert_cmpuint (out_len, ==, expected_len);
+                g_assert (memcmp (out, expected, out_len) == 0);
+            }
+        }
+    }
+
+    if (g_test_perf ()) {
+        guint8  *large;
+        guint8  *unescaped;
+        gdouble  elapsed;
+
+        large = g_malloc (PERF_SIZE);
+        unescaped = g_malloc (PERF_SIZE);
+        fill_random (large, PERF_SIZE, 0);
+        g_test_timer_start ();
+        qfu_utils_hdlc_unescape (large, PERF_SIZE, unescaped, PERF_SIZE);
+        elapsed = g_test_timer_elapsed ();
+        g_test_maximized_result (PERF_SIZE / elapsed / (1024 * 1024), "hdlc unescape: MB/s");
+        g_free (unescaped);
+        g_free (large);
+    }
+}
+
+static void
+test_hdlc_frame (void)
+{
+    guint8  in[MAX_TEST_SIZE];
+    guint8  framed[2 * MAX_TEST_SIZE + 4];
+    guint8  unframed[2 * MAX_TEST_SIZE + 4];
+    gsize   len;
+
+    fill_random (in, sizeof (in), 8);
+    for (len = 0; len <= MAX_TEST_SIZE; len++) {
+        GError *error = NULL;
+        gsize   framed_size;
+        gsize   unframed_size;
+
+        g_assert_cmpuint (qfu_utils_hdlc_max_framed_size (len), <=, sizeof (framed));
+        framed_size = qfu_utils_hdlc_frame (in, len, framed, sizeof (framed));
+        g_assert_cmpuint (framed_size, <=, qfu_utils_hdlc_max_framed_size (len));
+        g_assert_cmpuint (framed[0], ==, CONTROL);
+        g_assert_cmpuint (framed[framed_size - 1], ==, CONTROL);
+        g_assert (memchr (&framed[1], CONTROL, framed_size - 2) == NULL);
+
+        unframed_size = qfu_utils_hdlc_unframe (framed, framed_size, unframed, qfu_utils_hdlc_max_unframed_size (framed_size), &error);
+        g_assert_no_error (error);
+        g_assert_cmpuint (unframed_size, ==, len);
+        g_assert (memcmp (unframed, in, len) == 0);
+
+        /* A single bit error must fail the crc check (unless it changes the
+         * framing itself) */
+        framed[framed_size / 2] ^= 0x01;
+        if (framed[framed_size / 2] != CONTROL && framed[framed_size / 2] != ESCAPE) {
+            unframed_size = qfu_utils_hdlc_unframe (framed, framed_size, unframed, sizeof (unframed), &error);
+            g_assert_error (error, G_IO_ERROR, G_IO_ERROR_FAILED);
+            g_assert_cmpuint (unframed_size, ==, 0);
+            g_clear_error (&error);
+        }
+    }
+}
+
 /******************************************************************************/
 
 int main (int argc, char **argv)
@@ -99,5 +350,10 @@ int main (int argc, char **argv)
     g_test_add_func ("/qmi-firmware-update/cwe-version-parser/mc7354/nvu",  test_cwe_version_parser_mc7354_nvu);
     g_test_add_func ("/qmi-firmware-update/cwe-version-parser/mc7354b/spk", test_cwe_version_parser_mc7354b_spk);
 
+    g_test_add_func ("/qmi-firmware-update/crc16",                          test_crc16);
+    g_test_add_func ("/qmi-firmware-update/hdlc/escape",                    test_hdlc_escape);
+    g_test_add_func ("/qmi-firmware-update/hdlc/unescape",                  test_hdlc_unescape);
+    g_test_add_func ("/qmi-firmware-update/hdlc/frame",                     test_hdlc_frame);
+
     return g_test_run ();
 }